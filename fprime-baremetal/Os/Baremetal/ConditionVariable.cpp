@@ -0,0 +1,24 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/ConditionVariable.cpp
+// \brief implementation for Os::Baremetal::BaremetalConditionVariable
+// ======================================================================
+#include <fprime-baremetal/Os/Baremetal/ConditionVariable.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+ConditionVariableInterface::Status BaremetalConditionVariable::pend(Os::Mutex& mutex) {
+    (void)mutex;
+    return Status::ERROR_NOT_IMPLEMENTED;
+}
+
+void BaremetalConditionVariable::notify() {}
+
+void BaremetalConditionVariable::notifyAll() {}
+
+ConditionVariableHandle* BaremetalConditionVariable::getHandle() {
+    return &this->m_handle;
+}
+
+}  // namespace Baremetal
+}  // namespace Os
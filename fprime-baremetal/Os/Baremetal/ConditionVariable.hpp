@@ -0,0 +1,64 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/ConditionVariable.hpp
+// \brief implementation for Os::Baremetal::BaremetalConditionVariable, header definitions
+// ======================================================================
+#include <Os/Condition.hpp>
+#ifndef OS_BAREMETAL_CONDITIONVARIABLE_HPP
+#define OS_BAREMETAL_CONDITIONVARIABLE_HPP
+
+namespace Os {
+namespace Baremetal {
+
+//! ConditionVariableHandle class definition for baremetal implementations.
+//!
+struct BaremetalConditionVariableHandle : public ConditionVariableHandle {};
+
+//! \brief baremetal implementation of Os::ConditionVariableInterface
+//!
+//! A cooperative task cannot wait in place for another task to signal it, since that task only runs once the waiting
+//! unit of work returns. Waiting therefore fails, and notifying does nothing. Tasks waiting for an event should return
+//! and be woken through a `TaskWaker` instead.
+//!
+class BaremetalConditionVariable : public ConditionVariableInterface {
+  public:
+    //! \brief constructor
+    //!
+    BaremetalConditionVariable() = default;
+
+    //! \brief copy constructor
+    BaremetalConditionVariable(const BaremetalConditionVariable& other) = delete;
+
+    //! \brief default copy assignment
+    ConditionVariableInterface& operator=(const ConditionVariableInterface& other) override = delete;
+
+    //! \brief destructor
+    //!
+    ~BaremetalConditionVariable() override = default;
+
+    // ------------------------------------
+    // Functions overrides
+    // ------------------------------------
+
+    //! \brief wait on a condition variable
+    //!
+    //! \param mutex: mutex held by the caller
+    //! \return ERROR_NOT_IMPLEMENTED, a cooperative task cannot wait
+    ConditionVariableInterface::Status pend(Os::Mutex& mutex) override;
+
+    //! \brief notify a single waiter, of which there are none
+    void notify() override;
+
+    //! \brief notify all waiters, of which there are none
+    void notifyAll() override;
+
+    //! \brief return the underlying condition variable handle (implementation specific)
+    //! \return internal condition variable handle representation
+    ConditionVariableHandle* getHandle() override;
+
+  private:
+    //! Internal handle
+    BaremetalConditionVariableHandle m_handle;
+};
+}  // namespace Baremetal
+}  // namespace Os
+#endif  // OS_BAREMETAL_CONDITIONVARIABLE_HPP
@@ -3,6 +3,7 @@
 // \brief stub implementation for Os::Baremetal::BaremetalCpu, implementations
 // ======================================================================
 #include <fprime-baremetal/Os/Baremetal/Cpu.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
 
 namespace Os {
 namespace Baremetal {
@@ -14,9 +15,17 @@ CpuInterface::Status BaremetalCpu::_getCount(FwSizeType& cpu_count) {
 }
 
 CpuInterface::Status BaremetalCpu::_getTicks(Os::Cpu::Ticks& ticks, FwSizeType cpu_index) {
-    // Baremetal currently returns 100% in all cases
-    ticks.total = 1;
-    ticks.used = 1;
+    if (cpu_index != 0) {
+        return Status::ERROR;
+    }
+    // Time outside of the task runner idle path is used, the rest is idle. Ticks of one millisecond keep a 32-bit count
+    // from wrapping for 49 days, where microseconds wrapped every 71 minutes
+    constexpr U64 US_PER_TICK = 1000;
+    U64 usedUs = 0;
+    U64 totalUs = 0;
+    TaskRunner::getSingleton().getCpuTime(usedUs, totalUs);
+    ticks.used = static_cast<FwSizeType>(usedUs / US_PER_TICK);
+    ticks.total = static_cast<FwSizeType>(totalUs / US_PER_TICK);
     return Status::OP_OK;
 }
 
@@ -14,9 +14,11 @@ namespace Baremetal {
 //!
 struct BaremetalCpuHandle : public Os::CpuHandle {};
 
-//! \brief stub implementation of Os::CpuInterface
+//! \brief baremetal implementation of Os::CpuInterface
 //!
-//! Stub implementation of `CpuInterface` for use as a delegate class handling stub console operations.
+//! Implementation of `CpuInterface` for a single processor running cooperative tasks. Load is measured by the
+//! `TaskRunner` singleton as the time spent outside of its idle path, in ticks of one millisecond. Where `FwSizeType` is
+//! 32 bits the ticks wrap after about 49 days, which differences of unsigned samples ride through.
 //!
 class BaremetalCpu : public Os::CpuInterface {
   public:
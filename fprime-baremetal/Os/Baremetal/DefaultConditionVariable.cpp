@@ -0,0 +1,15 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/DefaultConditionVariable.cpp
+// \brief sets default Os::ConditionVariable to baremetal implementation via linker
+// ======================================================================
+#include "Os/Condition.hpp"
+#include "Os/Delegate.hpp"
+#include "fprime-baremetal/Os/Baremetal/ConditionVariable.hpp"
+
+namespace Os {
+ConditionVariableInterface* ConditionVariableInterface::getDelegate(
+    ConditionVariableHandleStorage& aligned_new_memory) {
+    return Os::Delegate::makeDelegate<ConditionVariableInterface, Os::Baremetal::BaremetalConditionVariable>(
+        aligned_new_memory);
+}
+}  // namespace Os
@@ -0,0 +1,13 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/DefaultMutex.cpp
+// \brief sets default Os::Mutex to baremetal implementation via linker
+// ======================================================================
+#include "Os/Delegate.hpp"
+#include "Os/Mutex.hpp"
+#include "fprime-baremetal/Os/Baremetal/Mutex.hpp"
+
+namespace Os {
+MutexInterface* MutexInterface::getDelegate(MutexHandleStorage& aligned_new_memory) {
+    return Os::Delegate::makeDelegate<MutexInterface, Os::Baremetal::BaremetalMutex>(aligned_new_memory);
+}
+}  // namespace Os
@@ -0,0 +1,13 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/DefaultQueue.cpp
+// \brief sets default Os::Queue to baremetal implementation via linker
+// ======================================================================
+#include "Os/Delegate.hpp"
+#include "Os/Queue.hpp"
+#include "fprime-baremetal/Os/Baremetal/Queue.hpp"
+
+namespace Os {
+QueueInterface* QueueInterface::getDelegate(QueueHandleStorage& aligned_new_memory) {
+    return Os::Delegate::makeDelegate<QueueInterface, Os::Baremetal::BaremetalQueue>(aligned_new_memory);
+}
+}  // namespace Os
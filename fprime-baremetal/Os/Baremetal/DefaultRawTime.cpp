@@ -0,0 +1,15 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/DefaultRawTime.cpp
+// \brief sets default Os::RawTime to baremetal implementation via linker
+// ======================================================================
+#include "Os/Delegate.hpp"
+#include "Os/RawTime.hpp"
+#include "fprime-baremetal/Os/Baremetal/RawTime.hpp"
+
+namespace Os {
+RawTimeInterface* RawTimeInterface::getDelegate(RawTimeHandleStorage& aligned_new_memory,
+                                                const RawTimeInterface* to_copy) {
+    return Os::Delegate::makeDelegate<RawTimeInterface, Os::Baremetal::BaremetalRawTime, RawTimeHandleStorage>(
+        aligned_new_memory, to_copy);
+}
+}  // namespace Os
@@ -82,11 +82,9 @@ BaremetalDirectory::Status BaremetalDirectory::read(char* fileNameBuffer, FwSize
         auto stateStatus = MicroFs::getFileStateIndex(fileStr.toChar(), fileIndex);
         // should always find it, since it is from a known valid bin
         FW_ASSERT(stateStatus != MicroFs::Status::INVALID);
-        MicroFs::MicroFsFileState* fState = MicroFs::getFileStateFromIndex(fileIndex);
-        FW_ASSERT(fState != nullptr);
 
         // check to see if it has been written
-        if (fState->created) {
+        if (MicroFs::isFileCreated(fileIndex)) {
             (void)memcpy(fileNameBuffer, fileStr.toChar(), bufSize);
             status = OP_OK;
             // increment here too otherwise the break will cause the index to not increment
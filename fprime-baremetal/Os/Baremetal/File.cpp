@@ -58,6 +58,10 @@ BaremetalFile::Status BaremetalFile::open(const char* path,
     // retrieve index to file entry
     FwIndexType entry = 0;
     auto status = MicroFs::getFileStateIndex(path, entry);
+    // a new name gets a file when opened for writing
+    if ((status == MicroFs::INVALID) and (mode != OPEN_READ)) {
+        status = MicroFs::allocateNamedFileState(path, entry);
+    }
     // not found
     if (status == MicroFs::INVALID) {
         return Os::File::Status::DOESNT_EXIST;
@@ -66,6 +70,11 @@ BaremetalFile::Status BaremetalFile::open(const char* path,
     MicroFs::MicroFsFileState* state = MicroFs::getFileStateFromIndex(entry);
     FW_ASSERT(state != nullptr);
 
+    // read-only files can't be created, truncated or written
+    if (state->readOnly and (mode != OPEN_READ)) {
+        return Os::File::Status::NO_PERMISSION;
+    }
+
     FwIndexType fdEntry = 0;
     status = MicroFs::getFileStateNextFreeFd(state, fdEntry);
     if (status == MicroFs::Status::INVALID) {
@@ -75,7 +84,7 @@ BaremetalFile::Status BaremetalFile::open(const char* path,
     switch (mode) {
         case OPEN_READ:
             // if not written to yet, doesn't exist for read
-            if (!state->created) {
+            if (!MicroFs::isFileCreated(entry)) {
                 return Os::File::Status::DOESNT_EXIST;
             }
             state->fd[fdEntry].loc = 0;
@@ -84,24 +93,24 @@ BaremetalFile::Status BaremetalFile::open(const char* path,
         case OPEN_SYNC_WRITE:  // fall through; same for microfs
             // If the file has never previously been opened, then initialize the
             // size to 0.
-            if (!state->created) {
-                state->currSize = 0;
+            if (!MicroFs::isFileCreated(entry)) {
+                MicroFs::setFileSize(entry, 0);
             }
             state->fd[fdEntry].loc = 0;
             break;
         case OPEN_CREATE:
-            if (state->created && (overwrite == BaremetalFile::OverwriteType::NO_OVERWRITE)) {
+            if (MicroFs::isFileCreated(entry) && (overwrite == BaremetalFile::OverwriteType::NO_OVERWRITE)) {
                 return Os::File::Status::FILE_EXISTS;
             }
             // truncate file length to zero
-            state->currSize = 0;
+            MicroFs::setFileSize(entry, 0);
             state->fd[fdEntry].loc = 0;
             break;
         case OPEN_APPEND:
             // If the file has never previously been opened, then initialize the
             // size to 0.
-            if (!state->created) {
-                state->currSize = 0;
+            if (!MicroFs::isFileCreated(entry)) {
+                MicroFs::setFileSize(entry, 0);
             }
 
             // Set to 0. On write, this loc should update to file size
@@ -112,7 +121,12 @@ BaremetalFile::Status BaremetalFile::open(const char* path,
             break;
     }
 
-    state->created = true;
+    // a new or truncated file starts over
+    if ((not MicroFs::isFileCreated(entry)) or (mode == OPEN_CREATE)) {
+        MicroFs::discardFileData(state);
+        MicroFs::markFileChanged(state, true);
+    }
+    MicroFs::setFileCreated(entry, true);
     state->fd[fdEntry].status = MicroFs::Status::VALID;
 
     // store mode
@@ -133,15 +147,22 @@ bool BaremetalFile::_isOpen() const {
 }
 
 BaremetalFile::Status BaremetalFile::preallocate(FwSizeType offset, FwSizeType length) {
-    MicroFs::MicroFsFileState* state =
-        MicroFs::getFileStateFromIndex(this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET);
+    const FwIndexType entry = this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET;
+    MicroFs::MicroFsFileState* state = MicroFs::getFileStateFromIndex(entry);
     FW_ASSERT(state != nullptr);
+    if (state->readOnly) {
+        return Os::File::Status::NO_PERMISSION;
+    }
     FwSizeType sum = offset + length;
     auto status = (sum > state->dataSize) ? Os::File::Status::BAD_SIZE : Os::File::Status::OP_OK;
     if (status == Os::File::Status::OP_OK) {
-        if (state->currSize < sum) {
-            (void)memset(&state->data[state->currSize], 0, sum - state->currSize);
-            state->currSize = sum;
+        const FwSizeType currSize = MicroFs::getFileSize(entry);
+        if (currSize < sum) {
+            if (MicroFs::zeroFileData(state, currSize, sum - currSize) != MicroFs::Status::VALID) {
+                return Os::File::Status::OTHER_ERROR;
+            }
+            MicroFs::setFileSize(entry, sum);
+            MicroFs::markFileChanged(state, false);
         }
     }
     return status;
@@ -169,10 +190,7 @@ void BaremetalFile::close() {
 }
 
 BaremetalFile::Status BaremetalFile::size(FwSizeType& size_result) {
-    MicroFs::MicroFsFileState* state =
-        MicroFs::getFileStateFromIndex(this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET);
-    FW_ASSERT(state != nullptr);
-    size_result = state->currSize;
+    size_result = MicroFs::getFileSize(this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET);
 
     return OP_OK;
 }
@@ -234,7 +252,14 @@ BaremetalFile::Status BaremetalFile::flush() {
         return NOT_OPENED;
     }
 
-    // RAM, so no need to flush
+    // RAM needs no flush, but a device cache has to write its changed pages
+    FW_ASSERT(this->m_handle.m_state_entry != BaremetalFileHandle::INVALID_STATE_ENTRY);
+    MicroFs::MicroFsFileState* state =
+        MicroFs::getFileStateFromIndex(this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET);
+    FW_ASSERT(state != nullptr);
+    if (MicroFs::flushFileData(state) != MicroFs::Status::VALID) {
+        return OTHER_ERROR;
+    }
     return OP_OK;
 }
 
@@ -249,17 +274,18 @@ BaremetalFile::Status BaremetalFile::read(U8* buffer, FwSizeType& size, Baremeta
     // get file state entry
     FW_ASSERT(this->m_handle.m_state_entry != BaremetalFileHandle::INVALID_STATE_ENTRY);
 
-    MicroFs::MicroFsFileState* state =
-        MicroFs::getFileStateFromIndex(this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET);
+    const FwIndexType entry = this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET;
+    MicroFs::MicroFsFileState* state = MicroFs::getFileStateFromIndex(entry);
     FW_ASSERT(state != nullptr);
 
     // Make code more readable
     auto& loc = state->fd[this->m_handle.m_file_descriptor].loc;
+    const FwSizeType currSize = MicroFs::getFileSize(entry);
 
     // find size to copy
 
     // check to see if already at the end of the file. If so, return 0 for size
-    if (loc >= (state->currSize)) {
+    if (loc >= currSize) {
         size = 0;
         return OP_OK;
     }
@@ -267,12 +293,15 @@ BaremetalFile::Status BaremetalFile::read(U8* buffer, FwSizeType& size, Baremeta
     // copy requested bytes, unless it would be more than the file size.
     // If it would be more than the file size, copy the remainder and set
     // the size to the actual copied
-    if ((loc + size) > (state->currSize)) {
-        size = state->currSize - loc;
+    if ((loc + size) > currSize) {
+        size = currSize - loc;
     }
 
     // copy data from location to buffer
-    (void)memcpy(buffer, state->data + loc, size);
+    if (MicroFs::readFileData(state, loc, buffer, size) != MicroFs::Status::VALID) {
+        size = 0;
+        return OTHER_ERROR;
+    }
 
     // move location pointer
     loc += size;
@@ -300,9 +329,10 @@ BaremetalFile::Status BaremetalFile::write(const U8* buffer, FwSizeType& size, B
     // get file state entry
     FW_ASSERT(this->m_handle.m_state_entry != BaremetalFileHandle::INVALID_STATE_ENTRY);
 
-    MicroFs::MicroFsFileState* state =
-        MicroFs::getFileStateFromIndex(this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET);
+    const FwIndexType entry = this->m_handle.m_state_entry - MicroFs::MICROFS_FD_OFFSET;
+    MicroFs::MicroFsFileState* state = MicroFs::getFileStateFromIndex(entry);
     FW_ASSERT(state != nullptr);
+    const FwSizeType currSize = MicroFs::getFileSize(entry);
 
     // write up to the end of the allocated buffer
     // if write size is greater, truncate the write
@@ -313,13 +343,16 @@ BaremetalFile::Status BaremetalFile::write(const U8* buffer, FwSizeType& size, B
     // Only reposition for APPEND mode if we're actually writing data (size > 0)
     // Per POSIX semantics, zero-byte writes should not reposition in APPEND mode
     if (this->m_handle.m_mode == OPEN_APPEND && size > 0) {
-        loc = state->currSize;
+        loc = currSize;
     }
 
     // If writing past current file size AND actually writing data, zero-fill the gap
     // Note: A zero-byte write should NOT expand the file per POSIX semantics
-    if (size > 0 && loc > state->currSize) {
-        (void)memset(&state->data[state->currSize], 0, loc - state->currSize);
+    if (size > 0 && loc > currSize) {
+        if (MicroFs::zeroFileData(state, currSize, loc - currSize) != MicroFs::Status::VALID) {
+            size = 0;
+            return OTHER_ERROR;
+        }
     }
 
     if (loc + size > state->dataSize) {
@@ -328,7 +361,11 @@ BaremetalFile::Status BaremetalFile::write(const U8* buffer, FwSizeType& size, B
 
     // copy data to file buffer (only if size > 0)
     if (size > 0) {
-        (void)memcpy(&state->data[loc], buffer, size);
+        if (MicroFs::writeFileData(state, loc, buffer, size) != MicroFs::Status::VALID) {
+            size = 0;
+            return OTHER_ERROR;
+        }
+        MicroFs::markFileChanged(state, false);
     }
 
     // increment location
@@ -337,8 +374,8 @@ BaremetalFile::Status BaremetalFile::write(const U8* buffer, FwSizeType& size, B
     // Check if the currSize is to be increased.
     // Only increase size if we actually wrote data (size > 0).
     // A zero-byte write should not expand the file per POSIX semantics.
-    if (size > 0 && loc > state->currSize) {
-        state->currSize = loc;
+    if (size > 0 && loc > currSize) {
+        MicroFs::setFileSize(entry, loc);
     }
 
     return OP_OK;
@@ -81,19 +81,27 @@ BaremetalFileSystem::Status BaremetalFileSystem::_removeFile(const char* path) {
     MicroFs::MicroFsFileState* fState = MicroFs::getFileStateFromIndex(index);
     FW_ASSERT(fState != nullptr);
 
-    for (FwIndexType i = 0; i < MAX_MICROFS_FD; i++) {
-        if (fState->fd[i].status != MicroFs::Status::INVALID) {
-            return BUSY;
-        }
+    if (fState->readOnly) {
+        return NO_PERMISSION;
     }
 
-    // delete the file by setting created to false
-    fState->created = false;
+    if (MicroFs::isFileOpen(fState)) {
+        return BUSY;
+    }
+
+    MicroFs::releaseFileState(index);
 
     return OP_OK;
 }
 
 BaremetalFileSystem::Status BaremetalFileSystem::_rename(const char* originPath, const char* destPath) {
+    // check up front that the origin can be removed so a read-only file isn't copied
+    FwIndexType index = 0;
+    if ((originPath != nullptr) and (MicroFs::getFileStateIndex(originPath, index) == MicroFs::Status::VALID) and
+        MicroFs::getFileStateFromIndex(index)->readOnly) {
+        return NO_PERMISSION;
+    }
+
     Status copyStat = Os::FileSystem::copyFile(originPath, destPath);
     if (copyStat != OP_OK) {
         return copyStat;
@@ -118,20 +126,23 @@ BaremetalFileSystem::Status BaremetalFileSystem::_getFreeSpace(const char* path,
 
     MicroFs& microfs = MicroFs::getSingleton();
 
-    // Get first file state struct
-    MicroFs::MicroFsFileState* statePtr = static_cast<MicroFs::MicroFsFileState*>(microfs.s_microFsMem);
-    FW_ASSERT(statePtr != nullptr);
+    // only the existence flags are read, so the scan stays in the dense array and never touches the file states
+    const bool* created = microfs.s_created;
+    FW_ASSERT(created != nullptr);
 
     // iterate through bins
     for (FwIndexType currBin = 0; currBin < microfs.s_microFsConfig.numBins; currBin++) {
-        // iterate through files in each bin
-        for (FwSizeType currFile = 0; currFile < microfs.s_microFsConfig.bins[currBin].numFiles; currFile++) {
-            totalBytes += statePtr->dataSize;
-            // only add unused file slots to free space
-            if (!statePtr->created) {
-                freeBytes += statePtr->dataSize;
+        const MicroFs::MicroFsBin& bin = microfs.s_microFsConfig.bins[currBin];
+        // read-only files are not part of the RAM space
+        if (bin.romFiles != nullptr) {
+            continue;
+        }
+        totalBytes += bin.numFiles * bin.fileSize;
+        // only add unused file slots to free space
+        for (FwSizeType slot = microfs.s_binStart[currBin]; slot < microfs.s_binStart[currBin + 1]; slot++) {
+            if (!created[slot]) {
+                freeBytes += bin.fileSize;
             }
-            statePtr += 1;
         }
     }
 
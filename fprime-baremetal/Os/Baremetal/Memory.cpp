@@ -3,13 +3,21 @@
 // \brief implementation for Os::Baremetal::BaremetalMemory
 // ======================================================================
 #include <fprime-baremetal/Os/Baremetal/Memory.hpp>
+#include <fprime-baremetal/Os/HeapStats/HeapStats.hpp>
 
 namespace Os {
 namespace Baremetal {
 
 MemoryInterface::Status BaremetalMemory::_getUsage(Os::Memory::Usage& memory_usage) {
-    memory_usage.used = 1;
-    memory_usage.total = 1;
+    // Without the heap size there is nothing meaningful to report usage against
+    const FwSizeType capacity = HeapStats::getCapacity();
+    if (capacity == 0) {
+        return Status::ERROR;
+    }
+    HeapUsage usage;
+    HeapStats::getUsage(usage);
+    memory_usage.used = usage.currentBytes;
+    memory_usage.total = capacity;
     return Status::OP_OK;
 }
 
@@ -14,9 +14,11 @@ namespace Baremetal {
 //!
 struct BaremetalMemoryHandle : public MemoryHandle {};
 
-//! \brief stub implementation of Os::MemoryInterface
+//! \brief baremetal implementation of Os::MemoryInterface
 //!
-//! Stub implementation of `MemoryInterface` for use as a delegate class handling stub console operations.
+//! Implementation of `MemoryInterface` reporting the heap usage counted by `HeapStats`: the bytes currently allocated
+//! out of the heap capacity. The deployment sets the capacity at startup with `HeapStats::setCapacity`, typically from
+//! the heap start and end symbols of its linker script. Reports an error until the capacity is set.
 //!
 class BaremetalMemory : public MemoryInterface {
   public:
@@ -43,7 +45,7 @@ class BaremetalMemory : public MemoryInterface {
     //! This method delegates to the underlying implementation.
     //!
     //! \param memory_usage: (output) data structure used to store memory usage
-    //! \return:  ERROR when error occurs, OK otherwise.
+    //! \return:  ERROR when the heap capacity is not set, OK otherwise.
     Status _getUsage(Usage& memory_usage) override;
 
     //! \brief returns the raw console handle
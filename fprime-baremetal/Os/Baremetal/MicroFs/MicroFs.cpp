@@ -19,9 +19,50 @@ void MicroFs::MicroFsAddBin(MicroFsConfig& cfg,
                             const FwIndexType binIndex,
                             const FwSizeType fileSize,
                             const FwSizeType numFiles) {
-    FW_ASSERT(binIndex <= MAX_MICROFS_BINS, binIndex);
+    FW_ASSERT((binIndex >= 0) and (binIndex < MAX_MICROFS_BINS), binIndex);
     cfg.bins[binIndex].fileSize = fileSize;
     cfg.bins[binIndex].numFiles = numFiles;
+    cfg.bins[binIndex].romFiles = nullptr;
+    cfg.bins[binIndex].evictPolicy = EVICT_NONE;
+    cfg.bins[binIndex].device = nullptr;
+}
+
+//!< add a read-only bin to the config
+void MicroFs::MicroFsAddRomBin(MicroFsConfig& cfg,
+                               const FwIndexType binIndex,
+                               const MicroFsRomFile* files,
+                               const FwSizeType numFiles) {
+    FW_ASSERT((binIndex >= 0) and (binIndex < MAX_MICROFS_BINS), binIndex);
+    FW_ASSERT(files != nullptr);
+    // no RAM is reserved for the file data
+    cfg.bins[binIndex].fileSize = 0;
+    cfg.bins[binIndex].numFiles = numFiles;
+    cfg.bins[binIndex].romFiles = files;
+    cfg.bins[binIndex].evictPolicy = EVICT_NONE;
+    cfg.bins[binIndex].device = nullptr;
+}
+
+//!< add a bin to the config whose files are stored on a block device
+void MicroFs::MicroFsAddDeviceBin(MicroFsConfig& cfg,
+                                  const FwIndexType binIndex,
+                                  const FwSizeType fileSize,
+                                  const FwSizeType numFiles,
+                                  MicroFsPageCache& device) {
+    MicroFs::MicroFsAddBin(cfg, binIndex, fileSize, numFiles);
+    cfg.bins[binIndex].device = &device;
+}
+
+//!< set how a bin in the config gets a new file when it is full
+void MicroFs::MicroFsSetBinEviction(MicroFsConfig& cfg, const FwIndexType binIndex, const EvictPolicy policy) {
+    FW_ASSERT((binIndex >= 0) and (binIndex < MAX_MICROFS_BINS), binIndex);
+    // read-only files can't be reclaimed
+    FW_ASSERT((policy == EVICT_NONE) or (cfg.bins[binIndex].romFiles == nullptr), binIndex);
+    cfg.bins[binIndex].evictPolicy = policy;
+}
+
+// size of the buffer reserved for each file of a bin. Read-only and device files have their data elsewhere
+static FwSizeType getBinBufferSize(const MicroFs::MicroFsBin& bin) {
+    return ((bin.romFiles != nullptr) or (bin.device != nullptr)) ? 0 : bin.fileSize;
 }
 
 MicroFs& MicroFs::getSingleton() {
@@ -37,41 +78,113 @@ void MicroFs::MicroFsInit(const MicroFsConfig& cfg, const FwEnumStoreType id, Fw
     FW_ASSERT(cfg.numBins <= MAX_MICROFS_BINS, cfg.numBins, MAX_MICROFS_BINS);
     FW_ASSERT((not MICROFS_SKIP_NULL_CHECK) and (microfs.s_microFsMem == nullptr));
 
-    // copy config to private copy
-    microfs.s_microFsConfig = cfg;
-
     // compute the amount of memory needed to hold the file system state
-    // and data
+    // and data, and the first file state of each bin
 
     FwSizeType memSize = 0;
-    FwSizeType totalNumFiles = 0;
+    FwSizeType binStart[MAX_MICROFS_BINS + 1];
+    binStart[0] = 0;
     // iterate through the bins
     for (FwIndexType bin = 0; bin < cfg.numBins; bin++) {
         // memory per file needed is struct for file state + file buffer size
-        memSize += cfg.bins[bin].numFiles * (sizeof(MicroFsFileState) + cfg.bins[bin].fileSize);
-        totalNumFiles += cfg.bins[bin].numFiles;
+        memSize += cfg.bins[bin].numFiles * (sizeof(MicroFsFileState) + getBinBufferSize(cfg.bins[bin]));
+        binStart[bin + 1] = binStart[bin] + cfg.bins[bin].numFiles;
     }
+    // plus the existence flag and size arrays
+    memSize += MicroFs::getHotSize(binStart[cfg.numBins]);
 
     // request the memory
     FwSizeType reqMem = memSize;
 
     bool dontcare;
-    microfs.s_microFsMem = allocator.allocate(id, reqMem, dontcare);
+    void* memory = allocator.allocate(id, reqMem, dontcare);
 
     // make sure memory is aligned
-    FW_ASSERT((reinterpret_cast<PlatformPointerCastType>(microfs.s_microFsMem) % alignof(MicroFsFileState)) == 0);
+    FW_ASSERT((reinterpret_cast<PlatformPointerCastType>(memory) % alignof(MicroFsFileState)) == 0);
 
     // make sure got the amount requested.
     // improvement could be best effort based on received memory
     FW_ASSERT(reqMem >= memSize, reqMem, memSize);
     // make sure we got a non-null pointer
-    FW_ASSERT(microfs.s_microFsMem != nullptr);
+    FW_ASSERT(memory != nullptr);
+
+    MicroFs::MicroFsSetup(cfg, binStart, memory);
+}
+
+void MicroFs::MicroFsInitStatic(const MicroFsConfig& cfg,
+                                const FwSizeType* binStart,
+                                void* storage,
+                                FwSizeType storageSize) {
+    // Force trigger on the fly singleton setup
+    MicroFs& microfs = MicroFs::getSingleton();
+
+    // check things...
+    FW_ASSERT(cfg.numBins <= MAX_MICROFS_BINS, cfg.numBins, MAX_MICROFS_BINS);
+    FW_ASSERT((not MICROFS_SKIP_NULL_CHECK) and (microfs.s_microFsMem == nullptr));
+    FW_ASSERT(binStart != nullptr);
+    FW_ASSERT(storage != nullptr);
+    FW_ASSERT((reinterpret_cast<PlatformPointerCastType>(storage) % alignof(MicroFsFileState)) == 0);
+
+    // make sure the storage holds the layout
+    FwSizeType memSize = 0;
+    for (FwIndexType bin = 0; bin < cfg.numBins; bin++) {
+        FW_ASSERT(binStart[bin + 1] - binStart[bin] == cfg.bins[bin].numFiles, bin);
+        memSize += cfg.bins[bin].numFiles * (sizeof(MicroFsFileState) + getBinBufferSize(cfg.bins[bin]));
+    }
+    memSize += MicroFs::getHotSize(binStart[cfg.numBins]);
+    FW_ASSERT(storageSize >= memSize, static_cast<FwAssertArgType>(storageSize), static_cast<FwAssertArgType>(memSize));
 
-    // lay out the memory with the state and the buffers after the config section
-    MicroFsFileState* statePtr = static_cast<MicroFsFileState*>(microfs.s_microFsMem);
+    MicroFs::MicroFsSetup(cfg, binStart, storage);
+}
 
-    // point to memory after state structs for beginning of file data
-    BYTE* currFileBuff = reinterpret_cast<BYTE*>(&statePtr[totalNumFiles]);
+void MicroFs::MicroFsSetup(const MicroFsConfig& cfg, const FwSizeType* binStart, void* memory) {
+    MicroFs& microfs = MicroFs::getSingleton();
+
+    // copy config and bin table to private copy
+    microfs.s_microFsConfig = cfg;
+    for (FwIndexType bin = 0; bin <= cfg.numBins; bin++) {
+        microfs.s_binStart[bin] = binStart[bin];
+    }
+    microfs.s_snapshotSequence = 0;
+    microfs.s_microFsMem = memory;
+    // names from a previous initialization no longer apply
+    microfs.s_nameTable = nullptr;
+    // file times count from now
+    (void)microfs.s_epoch.now();
+
+    // place the files of device bins one after the other in their cache, and start them empty
+    FwSizeType deviceAddress[MAX_MICROFS_BINS];
+    FwSizeType deviceStride[MAX_MICROFS_BINS];
+    for (FwIndexType bin = 0; bin < cfg.numBins; bin++) {
+        MicroFsPageCache* device = cfg.bins[bin].device;
+        deviceAddress[bin] = 0;
+        deviceStride[bin] = 0;
+        if (device == nullptr) {
+            continue;
+        }
+        const FwSizeType pageSize = device->getPageSize();
+        deviceStride[bin] = ((cfg.bins[bin].fileSize + pageSize - 1) / pageSize) * pageSize;
+        for (FwIndexType other = 0; other < bin; other++) {
+            if (cfg.bins[other].device == device) {
+                deviceAddress[bin] += cfg.bins[other].numFiles * deviceStride[other];
+            }
+        }
+        const FwSizeType binSize = cfg.bins[bin].numFiles * deviceStride[bin];
+        FW_ASSERT((deviceAddress[bin] + binSize) <= device->getCapacity(), bin,
+                  static_cast<FwAssertArgType>(device->getCapacity()));
+        device->trim(deviceAddress[bin], binSize);
+    }
+
+    // lay out the memory with the states, then the size and existence arrays, then the buffers
+    const FwSizeType numFiles = binStart[cfg.numBins];
+    MicroFsFileState* statePtr = static_cast<MicroFsFileState*>(memory);
+    BYTE* hotPtr = reinterpret_cast<BYTE*>(&statePtr[numFiles]);
+    microfs.s_currSize = reinterpret_cast<FwSizeType*>(hotPtr);
+    microfs.s_created = reinterpret_cast<bool*>(&microfs.s_currSize[numFiles]);
+
+    // point to memory after the arrays for beginning of file data
+    BYTE* currFileBuff = hotPtr + MicroFs::getHotSize(numFiles);
+    FwSizeType slot = 0;
     // fill in the file state structs
     for (FwIndexType bin = 0; bin < cfg.numBins; bin++) {
         for (FwSizeType file = 0; file < cfg.bins[bin].numFiles; file++) {
@@ -82,17 +195,47 @@ void MicroFs::MicroFsInit(const MicroFsConfig& cfg, const FwEnumStoreType id, Fw
                 statePtr->fd[fdIndex].loc = 0;                   // no operation in progress
                 statePtr->fd[fdIndex].status = Status::INVALID;  // no operation in progress
             }
-            statePtr->created = false;                    // has not been created
-            statePtr->currSize = 0;                       // nothing written yet
-            statePtr->data = currFileBuff;                // point to data for the file
-            statePtr->dataSize = cfg.bins[bin].fileSize;  // store allocated size for file data
+            statePtr->dirty = false;       // nothing to snapshot yet
+            statePtr->downlinked = false;  // nothing to downlink yet
+            statePtr->createTime = 0;      // times are only valid for created files
+            statePtr->modifyTime = 0;
+            statePtr->device = nullptr;    // data is in memory
+            statePtr->deviceAddress = 0;
+            statePtr->nameIndex = MicroFsNameTable::NO_ENTRY;
+            if (cfg.bins[bin].romFiles != nullptr) {
+                // read-only files exist from the start and are used in place. The data is
+                // never written since every write path checks readOnly first
+                const MicroFsRomFile& romFile = cfg.bins[bin].romFiles[file];
+                microfs.s_created[slot] = true;
+                microfs.s_currSize[slot] = romFile.size;
+                statePtr->readOnly = true;
+                statePtr->dataSize = romFile.size;
+                statePtr->data = const_cast<BYTE*>(romFile.data);
+                FW_ASSERT((romFile.data != nullptr) or (romFile.size == 0));
+            } else if (cfg.bins[bin].device != nullptr) {
+                // the data is on the device, one page-aligned area per file
+                microfs.s_created[slot] = false;
+                microfs.s_currSize[slot] = 0;
+                statePtr->readOnly = false;
+                statePtr->data = nullptr;
+                statePtr->dataSize = cfg.bins[bin].fileSize;
+                statePtr->device = cfg.bins[bin].device;
+                statePtr->deviceAddress = deviceAddress[bin] + (file * deviceStride[bin]);
+            } else {
+                microfs.s_created[slot] = false;              // has not been created
+                microfs.s_currSize[slot] = 0;                 // nothing written yet
+                statePtr->readOnly = false;                   // file data is in RAM
+                statePtr->data = currFileBuff;                // point to data for the file
+                statePtr->dataSize = cfg.bins[bin].fileSize;  // store allocated size for file data
 #if MICROFS_INIT_FILE_DATA
-            (void)::memset(currFileBuff, 0, cfg.bins[bin].fileSize);
+                (void)::memset(statePtr->data, 0, cfg.bins[bin].fileSize);
 #endif
+            }
             // advance file data pointer
-            currFileBuff += cfg.bins[bin].fileSize;
+            currFileBuff += getBinBufferSize(cfg.bins[bin]);
             // advance file state pointer
             statePtr += 1;
+            slot += 1;
         }
     }
 }
@@ -100,6 +243,32 @@ void MicroFs::MicroFsInit(const MicroFsConfig& cfg, const FwEnumStoreType id, Fw
 void MicroFs::MicroFsCleanup(const FwEnumStoreType id, Fw::MemAllocator& allocator) {
     allocator.deallocate(id, MicroFs::getSingleton().s_microFsMem);
     MicroFs::getSingleton().s_microFsMem = nullptr;
+    MicroFs::getSingleton().s_currSize = nullptr;
+    MicroFs::getSingleton().s_created = nullptr;
+}
+
+void MicroFs::MicroFsCleanupStatic() {
+    // storage belongs to the caller, so just forget it
+    MicroFs::getSingleton().s_microFsMem = nullptr;
+    MicroFs::getSingleton().s_currSize = nullptr;
+    MicroFs::getSingleton().s_created = nullptr;
+}
+
+void MicroFs::MicroFsSetNameTable(MicroFsNameTable* table, const FwIndexType bin) {
+    MicroFs& microfs = MicroFs::getSingleton();
+    FW_ASSERT(microfs.s_microFsMem != nullptr);
+    if (table != nullptr) {
+        FW_ASSERT((bin >= 0) and (bin < microfs.s_microFsConfig.numBins), bin);
+        // named files have to be writable
+        FW_ASSERT(microfs.s_microFsConfig.bins[bin].romFiles == nullptr, bin);
+        table->clear();
+    }
+    // names of the previous table, if any, are gone
+    for (FwSizeType slot = 0; slot < microfs.s_binStart[microfs.s_microFsConfig.numBins]; slot++) {
+        MicroFs::getFileStateFromIndex(static_cast<FwIndexType>(slot))->nameIndex = MicroFsNameTable::NO_ENTRY;
+    }
+    microfs.s_nameTable = table;
+    microfs.s_nameBin = bin;
 }
 
 // helper to find file state entry from file name. Will return VALID if found, INVALID if not
@@ -119,14 +288,19 @@ MicroFs::Status MicroFs::getFileStateIndex(const char* fileName, FwIndexType& st
     // crcExtension should be 2 bytes because scanf appends a null character at the end.
     char crcExtension[2];
     int stat = sscanf(fileName, filePathSpec, &binIndex, &fileIndex, &crcExtension[0]);
+
+    MicroFs& microfs = MicroFs::getSingleton();
+
     if (stat != 2) {
+        // not a bin path, so try the name table
+        if ((microfs.s_nameTable != nullptr) and microfs.s_nameTable->find(fileName, stateIndex)) {
+            return MicroFs::Status::VALID;
+        }
         return MicroFs::Status::INVALID;
     }
 
-    MicroFs& microfs = MicroFs::getSingleton();
-
     // check to see that indexes don't exceed config
-    if (binIndex >= microfs.s_microFsConfig.numBins) {
+    if (binIndex < 0 || binIndex >= microfs.s_microFsConfig.numBins) {
         return MicroFs::Status::INVALID;
     }
 
@@ -134,17 +308,180 @@ MicroFs::Status MicroFs::getFileStateIndex(const char* fileName, FwIndexType& st
         return MicroFs::Status::INVALID;
     }
 
-    stateIndex = 0;
-    // compute file state index
+    // compute file state index from the first state of the bin
+    stateIndex = static_cast<FwIndexType>(microfs.s_binStart[binIndex] + fileIndex);
+
+    return MicroFs::Status::VALID;
+}
+
+MicroFs::Status MicroFs::getFreeFileState(const FwIndexType bin, FwIndexType& stateIndex) {
+    MicroFs& microfs = MicroFs::getSingleton();
+    FW_ASSERT((bin >= 0) and (bin < microfs.s_microFsConfig.numBins), bin);
+    const EvictPolicy policy = microfs.s_microFsConfig.bins[bin].evictPolicy;
+
+    // take the first file in the bin that doesn't exist, or else the least recently modified
+    // closed file the policy allows to reclaim
+    FwIndexType oldest = -1;
+    U64 oldestTime = 0;
+    for (FwSizeType slot = microfs.s_binStart[bin]; slot < microfs.s_binStart[bin + 1]; slot++) {
+        if (not microfs.s_created[slot]) {
+            stateIndex = static_cast<FwIndexType>(slot);
+            return MicroFs::Status::VALID;
+        }
+        const MicroFsFileState* state = MicroFs::getFileStateFromIndex(static_cast<FwIndexType>(slot));
+        if ((policy == EVICT_NONE) or state->readOnly or
+            ((policy == EVICT_LRU_DOWNLINKED) and not state->downlinked)) {
+            continue;
+        }
+        if (((oldest < 0) or (state->modifyTime < oldestTime)) and not MicroFs::isFileOpen(state)) {
+            oldest = static_cast<FwIndexType>(slot);
+            oldestTime = state->modifyTime;
+        }
+    }
+
+    if (oldest < 0) {
+        return MicroFs::Status::INVALID;
+    }
+    MicroFs::releaseFileState(oldest);
+    stateIndex = oldest;
+    return MicroFs::Status::VALID;
+}
+
+void MicroFs::markFileChanged(MicroFsFileState* state, bool created) {
+    FW_ASSERT(state != nullptr);
+    const U64 now = MicroFs::getTimestamp();
+    if (created) {
+        state->createTime = now;
+    }
+    state->modifyTime = now;
+    // the change has to be picked up by the next snapshot and downlinked again
+    state->dirty = true;
+    state->downlinked = false;
+}
 
-    // add each chunk of file numbers from full bins
-    for (FwIndexType currBin = 0; currBin < binIndex; currBin++) {
-        stateIndex += microfs.s_microFsConfig.bins[currBin].numFiles;
+void MicroFs::releaseFileState(FwIndexType stateIndex) {
+    MicroFsFileState* state = MicroFs::getFileStateFromIndex(stateIndex);
+    FW_ASSERT(not state->readOnly, stateIndex);
+
+    // delete the file by setting created to false. Marking it dirty lets the next
+    // snapshot record the removal
+    MicroFs& microfs = MicroFs::getSingleton();
+    microfs.s_created[stateIndex] = false;
+    state->dirty = true;
+    MicroFs::discardFileData(state);
+
+    // release the name of the file, if it has one
+    if ((microfs.s_nameTable != nullptr) and (state->nameIndex != MicroFsNameTable::NO_ENTRY)) {
+        microfs.s_nameTable->remove(static_cast<FwSizeType>(state->nameIndex), MicroFs::moveFileName);
+        state->nameIndex = MicroFsNameTable::NO_ENTRY;
     }
+}
 
-    // get residual file number from last bin
-    stateIndex += fileIndex;
+void MicroFs::moveFileName(FwIndexType stateIndex, FwSizeType nameIndex) {
+    MicroFs::getFileStateFromIndex(stateIndex)->nameIndex = static_cast<FwIndexType>(nameIndex);
+}
 
+bool MicroFs::isFileOpen(const MicroFsFileState* state) {
+    FW_ASSERT(state != nullptr);
+    for (FwIndexType i = 0; i < MAX_MICROFS_FD; i++) {
+        if (state->fd[i].status != MicroFs::Status::INVALID) {
+            return true;
+        }
+    }
+    return false;
+}
+
+U64 MicroFs::getTimestamp() {
+    MicroFs& microfs = MicroFs::getSingleton();
+    Fw::TimeInterval interval;
+    if ((microfs.s_now.now() != Os::RawTime::OP_OK) or
+        (microfs.s_now.getTimeInterval(microfs.s_epoch, interval) != Os::RawTime::OP_OK)) {
+        return 0;
+    }
+    return (static_cast<U64>(interval.getSeconds()) * 1000000U) + interval.getUSeconds();
+}
+
+MicroFs::Status MicroFs::MicroFsGetFileTimes(const char* fileName, U64& createTime, U64& modifyTime) {
+    FW_ASSERT(fileName != nullptr);
+    FwIndexType stateIndex = 0;
+    if (MicroFs::getFileStateIndex(fileName, stateIndex) == MicroFs::Status::INVALID) {
+        return MicroFs::Status::INVALID;
+    }
+    if (not MicroFs::isFileCreated(stateIndex)) {
+        return MicroFs::Status::INVALID;
+    }
+    const MicroFsFileState* state = MicroFs::getFileStateFromIndex(stateIndex);
+    createTime = state->createTime;
+    modifyTime = state->modifyTime;
+    return MicroFs::Status::VALID;
+}
+
+MicroFs::Status MicroFs::MicroFsSetDownlinked(const char* fileName) {
+    FW_ASSERT(fileName != nullptr);
+    FwIndexType stateIndex = 0;
+    if (MicroFs::getFileStateIndex(fileName, stateIndex) == MicroFs::Status::INVALID) {
+        return MicroFs::Status::INVALID;
+    }
+    if (not MicroFs::isFileCreated(stateIndex)) {
+        return MicroFs::Status::INVALID;
+    }
+    MicroFs::getFileStateFromIndex(stateIndex)->downlinked = true;
+    return MicroFs::Status::VALID;
+}
+
+MicroFs::Status MicroFs::MicroFsGetFreeFile(const FwIndexType bin, char* path, const FwSizeType pathSize) {
+    FW_ASSERT(path != nullptr);
+    MicroFs& microfs = MicroFs::getSingleton();
+    if ((bin < 0) or (bin >= microfs.s_microFsConfig.numBins)) {
+        return MicroFs::Status::INVALID;
+    }
+
+    FwIndexType stateIndex = 0;
+    if (MicroFs::getFreeFileState(bin, stateIndex) == MicroFs::Status::INVALID) {
+        return MicroFs::Status::INVALID;
+    }
+    const int length =
+        snprintf(path, static_cast<size_t>(pathSize), "/" MICROFS_BIN_STRING "%d/" MICROFS_FILE_STRING "%d",
+                 static_cast<int>(bin), static_cast<int>(stateIndex - microfs.s_binStart[bin]));
+    if ((length < 0) or (static_cast<FwSizeType>(length) >= pathSize)) {
+        return MicroFs::Status::INVALID;
+    }
+    return MicroFs::Status::VALID;
+}
+
+MicroFs::Status MicroFs::allocateNamedFileState(const char* fileName, FwIndexType& stateIndex) {
+    FW_ASSERT(fileName != nullptr);
+    MicroFs& microfs = MicroFs::getSingleton();
+    if (microfs.s_nameTable == nullptr) {
+        return MicroFs::Status::INVALID;
+    }
+
+    // bin-shaped paths belong to the bins even when they are out of range or have an extension, and are never looked
+    // up in the table, so giving them a name would take a new file at each open
+    FwIndexType binIndex = 0;
+    FwIndexType fileIndex = 0;
+    if (sscanf(fileName, "/" MICROFS_BIN_STRING "%" MICROFS_INDEX_SCN_FORMAT "/" MICROFS_FILE_STRING
+                         "%" MICROFS_INDEX_SCN_FORMAT,
+               &binIndex, &fileIndex) == 2) {
+        return MicroFs::Status::INVALID;
+    }
+
+    // getting a free file may evict one, so the name has to be known to fit first
+    if (not microfs.s_nameTable->canInsert(fileName)) {
+        return MicroFs::Status::INVALID;
+    }
+
+    // files that exist are either named already or in use through their bin path
+    FwIndexType slot = 0;
+    if (MicroFs::getFreeFileState(microfs.s_nameBin, slot) == MicroFs::Status::INVALID) {
+        return MicroFs::Status::INVALID;
+    }
+    // evicting a named file released its name, so there is still room
+    FwSizeType nameIndex = 0;
+    const bool inserted = microfs.s_nameTable->insert(fileName, slot, nameIndex);
+    FW_ASSERT(inserted, slot);
+    MicroFs::getFileStateFromIndex(slot)->nameIndex = static_cast<FwIndexType>(nameIndex);
+    stateIndex = slot;
     return MicroFs::Status::VALID;
 }
 
@@ -158,6 +495,95 @@ MicroFs::MicroFsFileState* MicroFs::getFileStateFromIndex(FwIndexType index) {
     return &ptr[index];
 }
 
+bool MicroFs::isFileCreated(FwIndexType index) {
+    FW_ASSERT(index >= 0, index);
+    const MicroFs& microfs = MicroFs::getSingleton();
+    FW_ASSERT(microfs.s_created != nullptr);
+    return microfs.s_created[index];
+}
+
+void MicroFs::setFileCreated(FwIndexType index, bool created) {
+    FW_ASSERT(index >= 0, index);
+    MicroFs& microfs = MicroFs::getSingleton();
+    FW_ASSERT(microfs.s_created != nullptr);
+    microfs.s_created[index] = created;
+}
+
+FwSizeType MicroFs::getFileSize(FwIndexType index) {
+    FW_ASSERT(index >= 0, index);
+    const MicroFs& microfs = MicroFs::getSingleton();
+    FW_ASSERT(microfs.s_currSize != nullptr);
+    return microfs.s_currSize[index];
+}
+
+void MicroFs::setFileSize(FwIndexType index, FwSizeType size) {
+    FW_ASSERT(index >= 0, index);
+    MicroFs& microfs = MicroFs::getSingleton();
+    FW_ASSERT(microfs.s_currSize != nullptr);
+    microfs.s_currSize[index] = size;
+}
+
+MicroFs::Status MicroFs::readFileData(const MicroFsFileState* state,
+                                      FwSizeType offset,
+                                      U8* buffer,
+                                      FwSizeType size) {
+    FW_ASSERT(state != nullptr);
+    FW_ASSERT((offset + size) <= state->dataSize, static_cast<FwAssertArgType>(offset),
+              static_cast<FwAssertArgType>(size));
+    if (state->device == nullptr) {
+        (void)memcpy(buffer, &state->data[offset], size);
+        return MicroFs::Status::VALID;
+    }
+    return (state->device->read(state->deviceAddress + offset, buffer, size) == MicroFsFtl::OP_OK)
+               ? MicroFs::Status::VALID
+               : MicroFs::Status::INVALID;
+}
+
+MicroFs::Status MicroFs::writeFileData(MicroFsFileState* state,
+                                       FwSizeType offset,
+                                       const U8* buffer,
+                                       FwSizeType size) {
+    FW_ASSERT(state != nullptr);
+    FW_ASSERT((offset + size) <= state->dataSize, static_cast<FwAssertArgType>(offset),
+              static_cast<FwAssertArgType>(size));
+    if (state->device == nullptr) {
+        (void)memcpy(&state->data[offset], buffer, size);
+        return MicroFs::Status::VALID;
+    }
+    return (state->device->write(state->deviceAddress + offset, buffer, size) == MicroFsFtl::OP_OK)
+               ? MicroFs::Status::VALID
+               : MicroFs::Status::INVALID;
+}
+
+MicroFs::Status MicroFs::zeroFileData(MicroFsFileState* state, FwSizeType offset, FwSizeType size) {
+    FW_ASSERT(state != nullptr);
+    FW_ASSERT((offset + size) <= state->dataSize, static_cast<FwAssertArgType>(offset),
+              static_cast<FwAssertArgType>(size));
+    if (state->device == nullptr) {
+        (void)memset(&state->data[offset], 0, size);
+        return MicroFs::Status::VALID;
+    }
+    return (state->device->zero(state->deviceAddress + offset, size) == MicroFsFtl::OP_OK)
+               ? MicroFs::Status::VALID
+               : MicroFs::Status::INVALID;
+}
+
+MicroFs::Status MicroFs::flushFileData(MicroFsFileState* state) {
+    FW_ASSERT(state != nullptr);
+    if (state->device == nullptr) {
+        return MicroFs::Status::VALID;
+    }
+    return (state->device->flush() == MicroFsFtl::OP_OK) ? MicroFs::Status::VALID : MicroFs::Status::INVALID;
+}
+
+void MicroFs::discardFileData(MicroFsFileState* state) {
+    FW_ASSERT(state != nullptr);
+    // data in memory is simply overwritten. On a device, trimming keeps garbage collection from moving it
+    if (state->device != nullptr) {
+        state->device->trim(state->deviceAddress, state->dataSize);
+    }
+}
+
 MicroFs::Status MicroFs::getFileStateNextFreeFd(const MicroFs::MicroFsFileState* state, FwIndexType& nextFreeFd) {
     if (state == nullptr) {
         return MicroFs::Status::INVALID;
@@ -3,6 +3,9 @@
 
 #include <Fw/Types/BasicTypes.hpp>
 #include <Fw/Types/MemAllocator.hpp>
+#include <Os/RawTime.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsNameTable.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsPageCache.hpp>
 #include "config/MicroFsCfg.hpp"
 
 // MicroFs - F Prime Micro Filesystem
@@ -79,6 +82,29 @@
 // the user should call `MicrFsCleanup()` with the allocator
 // and ID used to acquire the memory at initialization.
 //
+// Files that are known at build time, like boot sequences, can be placed in a read-only bin
+// added with `MicroFsAddRomBin`. Its files point directly at `const` data linked into flash,
+// exist from initialization, can be opened for reading only, and use no RAM besides their
+// file state. The `baremetal-romfs` tool generates the file table from a directory.
+//
+// Files can also be given arbitrary short names by registering a `MicroFsNameTable`
+// with `MicroFsSetNameTable`. See `MicroFsNameTable.hpp`.
+//
+// Each file records when it was created and last modified, in microseconds since `MicroFsInit`,
+// which can be read with `MicroFsGetFileTimes`. A bin can opt in to reclaiming its least recently
+// modified closed file when a new file is needed (see `MicroFsSetBinEviction`). With `EVICT_LRU_DOWNLINKED`,
+// only files marked with `MicroFsSetDownlinked` since their last change are reclaimed. New files are
+// requested with `MicroFsGetFreeFile`, or by creating a new name when a name table is registered.
+//
+// Files can also be kept on external flash instead of RAM. A bin added with `MicroFsAddDeviceBin`
+// stores its files through a `MicroFsPageCache` over a `MicroFsFtl` and a `MicroFsBlockDevice`
+// driver. Only the file states are in RAM. `Os::File::flush()` writes the changed pages of the
+// cache to the device.
+//
+// When the configuration is fixed for a build, `MicroFsStaticLayout` in
+// `MicroFsStatic.hpp` computes the layout at compile time and places the
+// file system in static storage instead of using an allocator.
+//
 // Some idiosyncracies for the sake of simplicity:
 // 1) The createDirectory() and removeDirectory() calls
 //    won't actually create or remove directories, but
@@ -99,9 +125,23 @@ class MicroFs {
         VALID,    //<! Status is valid
     };
 
+    enum EvictPolicy {
+        EVICT_NONE,            //<! Never reclaim files in the bin
+        EVICT_LRU,             //<! Reclaim the least recently modified closed file
+        EVICT_LRU_DOWNLINKED,  //<! Reclaim the least recently modified closed file marked as downlinked
+    };
+
+    struct MicroFsRomFile {
+        const U8* data;   //<! The file contents in read-only memory
+        FwSizeType size;  //<! The size of the file contents
+    };
+
     struct MicroFsBin {
-        FwSizeType fileSize;  //<! The size of the files in the bin
-        FwSizeType numFiles;  //<! The number of files in the bin
+        FwSizeType fileSize;                       //<! The size of the files in the bin. Zero for read-only bins
+        FwSizeType numFiles;                       //<! The number of files in the bin
+        const MicroFsRomFile* romFiles = nullptr;  //<! The contents of a read-only bin, or nullptr for RAM files
+        EvictPolicy evictPolicy = EVICT_NONE;      //<! How to get a new file when the bin is full
+        MicroFsPageCache* device = nullptr;        //<! The cache of the device holding the files, or nullptr for RAM
     };
 
     struct MicroFsConfig {
@@ -116,12 +156,22 @@ class MicroFs {
 
   public:
     // data structure for managing file state
+    // the existence flag and current size of each file are not in here. They are read by every
+    // whole-volume scan, so they are kept in dense arrays apart from this structure (see `isFileCreated`
+    // and `getFileSize`)
     struct MicroFsFileState {
-        MicroFsFd fd[MAX_MICROFS_FD];  //!< File descriptors for this file
-        bool created;                  //!< Flag to indicate if created or not. True if created else false.
-        FwSizeType currSize;           //!< current size of the file after writes were done.
-        FwSizeType dataSize;           //!< alloted size of the file
         BYTE* data;                    //!< location of file data
+        FwSizeType dataSize;           //!< alloted size of the file
+        bool dirty;                    //!< contents or existence changed since the last snapshot
+        bool inSnapshot;               //!< captured by the snapshot currently being streamed
+        bool readOnly;                 //!< file data is in read-only memory and cannot be changed
+        bool downlinked;               //!< marked as downlinked since the last change
+        U64 createTime;                //!< creation time in microseconds since MicroFsInit
+        U64 modifyTime;                //!< last modification time in microseconds since MicroFsInit
+        MicroFsPageCache* device;      //!< cache of the device holding the file data, or nullptr for data in memory
+        FwSizeType deviceAddress;      //!< address of the file data in the device cache
+        FwIndexType nameIndex;         //!< entry of the file in the name table, or MicroFsNameTable::NO_ENTRY
+        MicroFsFd fd[MAX_MICROFS_FD];  //!< File descriptors for this file
     };
 
   public:
@@ -147,6 +197,23 @@ class MicroFs {
                               const FwSizeType fileSize,
                               const FwSizeType numFiles);
 
+    //!< add a read-only bin to the config. The files are used in place and must outlive the file system
+    static void MicroFsAddRomBin(MicroFsConfig& cfg,
+                                 const FwIndexType binIndex,
+                                 const MicroFsRomFile* files,
+                                 const FwSizeType numFiles);
+
+    //!< add a bin to the config whose files are stored on a block device through a page cache. The cache must
+    //!< outlive the file system
+    static void MicroFsAddDeviceBin(MicroFsConfig& cfg,
+                                    const FwIndexType binIndex,
+                                    const FwSizeType fileSize,
+                                    const FwSizeType numFiles,
+                                    MicroFsPageCache& device);
+
+    //!< set how a bin in the config gets a new file when it is full
+    static void MicroFsSetBinEviction(MicroFsConfig& cfg, const FwIndexType binIndex, const EvictPolicy policy);
+
     //!< initialize MicroFs memory by passing the configuration, a memory id (if needed), and a memory allocator
 
     static void MicroFsInit(
@@ -158,12 +225,84 @@ class MicroFs {
         const FwEnumStoreType id,      //!< The memory id. Value doesn't matter if allocator doesn't need it
         Fw::MemAllocator& allocator);  //!< Memory allocator to to deallocate. Should match MicroFsInit allocator
 
+    //!< initialize MicroFs in storage provided by the caller. See `MicroFsStaticLayout` for a compile-time layout
+
+    static void MicroFsInitStatic(
+        const MicroFsConfig& cfg,     //!< the configuration of the memory space
+        const FwSizeType* binStart,   //!< first slot of each bin, with the total number of slots at index numBins
+        void* storage,                //!< storage for the file system. Must be aligned for MicroFsFileState
+        FwSizeType storageSize);      //!< size of the storage in bytes
+
+    //!< release the storage given to MicroFsInitStatic
+    static void MicroFsCleanupStatic();
+
+    //!< get the creation and last modification times of a file, in microseconds since MicroFsInit
+    static Status MicroFsGetFileTimes(const char* fileName, U64& createTime, U64& modifyTime);
+
+    //!< mark a file as downlinked, so an EVICT_LRU_DOWNLINKED bin may reclaim it. Cleared by the next change
+    static Status MicroFsSetDownlinked(const char* fileName);
+
+    //!< get the path of a file in a bin that doesn't exist yet, reclaiming one if the bin policy allows
+    static Status MicroFsGetFreeFile(const FwIndexType bin, char* path, const FwSizeType pathSize);
+
+    //!< register a name table after initialization, or nullptr to remove it. Named files are allocated from bin
+    static void MicroFsSetNameTable(MicroFsNameTable* table, const FwIndexType bin);
+
     // helper to get state pointer from index
     static MicroFsFileState* getFileStateFromIndex(FwIndexType index);
 
+    // helper to get the size of the dense arrays holding the existence flag and current size of each file.
+    // Rounded up so the file data that follows keeps the alignment of the file states
+    static constexpr FwSizeType getHotSize(FwSizeType numFiles) {
+        return (((numFiles * (sizeof(FwSizeType) + sizeof(bool))) + alignof(MicroFsFileState) - 1) /
+                alignof(MicroFsFileState)) *
+               alignof(MicroFsFileState);
+    }
+
+    // helpers to get and set whether a file exists
+    static bool isFileCreated(FwIndexType index);
+    static void setFileCreated(FwIndexType index, bool created);
+
+    // helpers to get and set the current size of a file after writes were done
+    static FwSizeType getFileSize(FwIndexType index);
+    static void setFileSize(FwIndexType index, FwSizeType size);
+
+    // helpers to access the data of a file, in memory or on a device. Will return VALID if done, INVALID if the
+    // device failed
+    static Status readFileData(const MicroFsFileState* state, FwSizeType offset, U8* buffer, FwSizeType size);
+    static Status writeFileData(MicroFsFileState* state, FwSizeType offset, const U8* buffer, FwSizeType size);
+    static Status zeroFileData(MicroFsFileState* state, FwSizeType offset, FwSizeType size);
+    static Status flushFileData(MicroFsFileState* state);
+
+    // helper to drop the data of a file that was removed or truncated, so a device doesn't keep it
+    static void discardFileData(MicroFsFileState* state);
+
     // helper to find file state entry from file name. Will return VALID if found, INVALID if not
     static Status getFileStateIndex(const char* fileName, FwIndexType& stateIndex);
 
+    // helper to find a file state in a bin that doesn't exist yet, reclaiming one if the bin policy allows.
+    // Will return VALID if found, INVALID if not
+    static Status getFreeFileState(const FwIndexType bin, FwIndexType& stateIndex);
+
+    // helper to record a change to a file. Set created when the file is new or truncated
+    static void markFileChanged(MicroFsFileState* state, bool created);
+
+    // helper to delete a file and release its name
+    static void releaseFileState(FwIndexType stateIndex);
+
+    // name table hook keeping the entry index of a named file up to date when a removal shifts its entry back
+    static void moveFileName(FwIndexType stateIndex, FwSizeType nameIndex);
+
+    // helper to check if a file has open file descriptors
+    static bool isFileOpen(const MicroFsFileState* state);
+
+    // helper to get the time in microseconds since MicroFsInit
+    static U64 getTimestamp();
+
+    // helper to give a new name a free file state from the name table bin. Will return VALID if allocated, INVALID if
+    // there is no name table, the name is a bin path, there is no free file state, or the name doesn't fit in the table
+    static Status allocateNamedFileState(const char* fileName, FwIndexType& stateIndex);
+
     // helper to find the next available file descriptor. Will return VALID if available, INVALID if not
     static Status getFileStateNextFreeFd(const MicroFs::MicroFsFileState* state, FwIndexType& nextFreeFd);
 
@@ -171,12 +310,31 @@ class MicroFs {
     //! \return reference to singleton
     static MicroFs& getSingleton();
 
+  private:
+    // helper to record the configuration and lay out the file states and data in memory
+    static void MicroFsSetup(const MicroFsConfig& cfg, const FwSizeType* binStart, void* memory);
+
   public:
     // private pointer to allocated memory for microfs
     void* s_microFsMem = nullptr;
     // private copy of configuration struct passed by
     // user
     MicroFsConfig s_microFsConfig;
+    // current size and existence flag of each file, indexed like the file states. Scans over
+    // the whole volume only read these
+    FwSizeType* s_currSize = nullptr;
+    bool* s_created = nullptr;
+    // index of the first file state of each bin. Entry numBins holds the total number of file states
+    FwSizeType s_binStart[MAX_MICROFS_BINS + 1];
+    // time of initialization, used as the origin of the file times
+    Os::RawTime s_epoch;
+    // reading of the time, kept so writes don't set up a new Os::RawTime each time
+    Os::RawTime s_now;
+    // optional table of named files, and the bin they are allocated from
+    MicroFsNameTable* s_nameTable = nullptr;
+    FwIndexType s_nameBin = 0;
+    // sequence number of the last snapshot started. See `MicroFsSnapshot`
+    U32 s_snapshotSequence = 0;
     // offset from zero for fds to allow zero checks
     static constexpr FwIndexType MICROFS_FD_OFFSET = 1;
 };
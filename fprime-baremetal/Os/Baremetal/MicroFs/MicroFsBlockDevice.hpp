@@ -0,0 +1,60 @@
+#ifndef _MICROFS_BLOCK_DEVICE_HPP_
+#define _MICROFS_BLOCK_DEVICE_HPP_
+
+#include <Fw/Types/BasicTypes.hpp>
+
+// MicroFsBlockDevice - page-programmed, block-erased storage for MicroFs
+//
+// External NOR and NAND flash can only be programmed a page at a time, a page can only be
+// programmed once after its block was erased, and blocks wear out after a limited number of
+// erase cycles. A driver for such a part implements this interface, and `MicroFsFtl` turns it
+// into logical pages that can be rewritten any number of times. `MicroFsPageCache` then gives
+// MicroFs byte access to the logical pages (see `MicroFs::MicroFsAddDeviceBin`).
+//
+// `MicroFsSimFlash` implements the interface in RAM for host tests and benchmarks.
+
+namespace Os {
+namespace Baremetal {
+
+class MicroFsBlockDevice {
+  public:
+    enum Status {
+        OP_OK,  //!< operation succeeded
+        ERROR,  //!< operation failed. A failed program or erase means the block is worn out
+    };
+
+    struct Geometry {
+        FwSizeType pageSize;       //!< bytes per page
+        FwSizeType pagesPerBlock;  //!< pages per erase block
+        FwSizeType numBlocks;      //!< number of erase blocks
+    };
+
+    virtual ~MicroFsBlockDevice() = default;
+
+    //! \brief get the layout of the device
+    virtual Geometry getGeometry() const = 0;
+
+    //! \brief read a whole page
+    //!
+    //! \param block: block number
+    //! \param page: page number within the block
+    //! \param buffer: destination of pageSize bytes
+    virtual Status read(FwSizeType block, FwSizeType page, U8* buffer) = 0;
+
+    //! \brief program a whole page. Pages are programmed in order, once per erase of their block
+    //!
+    //! \param block: block number
+    //! \param page: page number within the block
+    //! \param buffer: source of pageSize bytes
+    virtual Status program(FwSizeType block, FwSizeType page, const U8* buffer) = 0;
+
+    //! \brief erase a block
+    //!
+    //! \param block: block number
+    virtual Status erase(FwSizeType block) = 0;
+};
+
+}  // namespace Baremetal
+}  // namespace Os
+
+#endif
@@ -0,0 +1,281 @@
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsFtl.hpp>
+
+#include <cstring>
+
+namespace Os {
+namespace Baremetal {
+
+// out-of-line definitions for constants that are odr-used (required before C++17)
+constexpr U32 MicroFsFtl::UNMAPPED;
+constexpr FwSizeType MicroFsFtl::NO_BLOCK;
+
+static_assert(MICROFS_FTL_RESERVED_BLOCKS >= 2, "Garbage collection needs a destination block and a spare");
+
+MicroFsFtl::MicroFsFtl(MicroFsBlockDevice& device,
+                       FwSizeType numBlocks,
+                       FwSizeType pagesPerBlock,
+                       FwSizeType pageSize,
+                       U32* pageMap,
+                       U32* reverseMap,
+                       BlockInfo* blocks,
+                       U8* pageBuffer)
+    : m_device(device),
+      m_numBlocks(numBlocks),
+      m_pagesPerBlock(pagesPerBlock),
+      m_pageSize(pageSize),
+      m_pageMap(pageMap),
+      m_reverseMap(reverseMap),
+      m_blocks(blocks),
+      m_pageBuffer(pageBuffer),
+      m_active(NO_BLOCK),
+      m_writePage(0),
+      m_freeBlocks(0),
+      m_hostWrites(0),
+      m_flashWrites(0),
+      m_erases(0) {
+    FW_ASSERT(pageMap != nullptr);
+    FW_ASSERT(reverseMap != nullptr);
+    FW_ASSERT(blocks != nullptr);
+    FW_ASSERT(pageBuffer != nullptr);
+    FW_ASSERT(numBlocks > MICROFS_FTL_RESERVED_BLOCKS, static_cast<FwAssertArgType>(numBlocks));
+    FW_ASSERT((pagesPerBlock > 0) and (pageSize > 0));
+    // physical page numbers have to fit in the maps
+    FW_ASSERT((numBlocks * pagesPerBlock) < UNMAPPED, static_cast<FwAssertArgType>(numBlocks * pagesPerBlock));
+
+    for (FwSizeType block = 0; block < numBlocks; block++) {
+        this->m_blocks[block].eraseCount = 0;
+        this->m_blocks[block].state = BLOCK_FREE;
+    }
+    this->format();
+}
+
+void MicroFsFtl::format() {
+    const FwSizeType logicalPages = this->getLogicalPages();
+    for (FwSizeType page = 0; page < logicalPages; page++) {
+        this->m_pageMap[page] = UNMAPPED;
+    }
+    for (FwSizeType page = 0; page < (this->m_numBlocks * this->m_pagesPerBlock); page++) {
+        this->m_reverseMap[page] = UNMAPPED;
+    }
+    this->m_freeBlocks = 0;
+    for (FwSizeType block = 0; block < this->m_numBlocks; block++) {
+        this->m_blocks[block].validPages = 0;
+        if (this->m_blocks[block].state != BLOCK_BAD) {
+            this->m_blocks[block].state = BLOCK_FREE;
+            this->m_freeBlocks++;
+        }
+    }
+    this->m_active = NO_BLOCK;
+    this->m_writePage = 0;
+}
+
+MicroFsFtl::Status MicroFsFtl::readPage(U32 page, U8* buffer) {
+    FW_ASSERT(buffer != nullptr);
+    FW_ASSERT(page < this->getLogicalPages(), static_cast<FwAssertArgType>(page));
+
+    const U32 physicalPage = this->m_pageMap[page];
+    if (physicalPage == UNMAPPED) {
+        (void)memset(buffer, 0, this->m_pageSize);
+        return OP_OK;
+    }
+    if (this->m_device.read(physicalPage / this->m_pagesPerBlock, physicalPage % this->m_pagesPerBlock, buffer) !=
+        MicroFsBlockDevice::OP_OK) {
+        return DEVICE_ERROR;
+    }
+    return OP_OK;
+}
+
+MicroFsFtl::Status MicroFsFtl::writePage(U32 page, const U8* buffer) {
+    FW_ASSERT(buffer != nullptr);
+    FW_ASSERT(page < this->getLogicalPages(), static_cast<FwAssertArgType>(page));
+
+    Status status = this->ensureActive();
+    if (status != OP_OK) {
+        return status;
+    }
+    status = this->append(page, buffer);
+    if (status == OP_OK) {
+        this->m_hostWrites++;
+    }
+    return status;
+}
+
+void MicroFsFtl::trimPage(U32 page) {
+    FW_ASSERT(page < this->getLogicalPages(), static_cast<FwAssertArgType>(page));
+    this->invalidate(this->m_pageMap[page]);
+    this->m_pageMap[page] = UNMAPPED;
+}
+
+FwSizeType MicroFsFtl::getPageSize() const {
+    return this->m_pageSize;
+}
+
+FwSizeType MicroFsFtl::getLogicalPages() const {
+    return MicroFsFtl::getLogicalPages(this->m_numBlocks, this->m_pagesPerBlock);
+}
+
+U32 MicroFsFtl::getEraseCount(FwSizeType block) const {
+    FW_ASSERT(block < this->m_numBlocks, static_cast<FwAssertArgType>(block));
+    return this->m_blocks[block].eraseCount;
+}
+
+void MicroFsFtl::getStats(Stats& stats) const {
+    stats.hostWrites = this->m_hostWrites;
+    stats.flashWrites = this->m_flashWrites;
+    stats.erases = this->m_erases;
+    stats.minEraseCount = 0xFFFFFFFF;
+    stats.maxEraseCount = 0;
+    stats.badBlocks = 0;
+    for (FwSizeType block = 0; block < this->m_numBlocks; block++) {
+        const BlockInfo& info = this->m_blocks[block];
+        if (info.state == BLOCK_BAD) {
+            stats.badBlocks++;
+            continue;
+        }
+        stats.minEraseCount = (info.eraseCount < stats.minEraseCount) ? info.eraseCount : stats.minEraseCount;
+        stats.maxEraseCount = (info.eraseCount > stats.maxEraseCount) ? info.eraseCount : stats.maxEraseCount;
+    }
+}
+
+MicroFsFtl::Status MicroFsFtl::ensureActive() {
+    bool leveled = false;
+    while ((this->m_active == NO_BLOCK) or (this->m_writePage == this->m_pagesPerBlock)) {
+        if (this->m_active != NO_BLOCK) {
+            this->m_blocks[this->m_active].state = BLOCK_USED;
+            this->m_active = NO_BLOCK;
+        }
+
+        // pick a block to empty into the new block, if any. Static wear leveling comes first: cold
+        // data is moved off a block that is falling behind. It is done once per write at most, so a
+        // write never waits for more than one extra block move
+        FwSizeType victim = NO_BLOCK;
+        if (not leveled) {
+            const FwSizeType coldest = this->findBlock(BLOCK_USED, false);
+            const FwSizeType next = this->findBlock(BLOCK_FREE, false);
+            if ((coldest != NO_BLOCK) and (next != NO_BLOCK) and
+                (this->m_blocks[next].eraseCount > (this->m_blocks[coldest].eraseCount + MICROFS_FTL_WEAR_THRESHOLD))) {
+                victim = coldest;
+                leveled = true;
+            }
+        }
+        if ((victim == NO_BLOCK) and (this->m_freeBlocks < MICROFS_FTL_RESERVED_BLOCKS)) {
+            // garbage collection: the used block that gives back the most pages
+            victim = this->findBlock(BLOCK_USED, true);
+            if ((victim == NO_BLOCK) or (this->m_blocks[victim].validPages == this->m_pagesPerBlock)) {
+                return NO_SPACE;
+            }
+        }
+
+        this->m_active = this->allocateBlock();
+        if (this->m_active == NO_BLOCK) {
+            return NO_SPACE;
+        }
+        if (victim != NO_BLOCK) {
+            const Status status = this->relocate(victim);
+            if (status != OP_OK) {
+                return status;
+            }
+        }
+    }
+    return OP_OK;
+}
+
+MicroFsFtl::Status MicroFsFtl::append(U32 page, const U8* buffer) {
+    FW_ASSERT(this->m_active != NO_BLOCK);
+    FW_ASSERT(this->m_writePage < this->m_pagesPerBlock, static_cast<FwAssertArgType>(this->m_writePage));
+
+    const MicroFsBlockDevice::Status status = this->m_device.program(this->m_active, this->m_writePage, buffer);
+    const U32 physicalPage = static_cast<U32>((this->m_active * this->m_pagesPerBlock) + this->m_writePage);
+    this->m_writePage++;
+    if (status != MicroFsBlockDevice::OP_OK) {
+        // the page is lost but the block keeps its other data. Writes go on in the next page
+        return DEVICE_ERROR;
+    }
+    this->m_flashWrites++;
+
+    this->invalidate(this->m_pageMap[page]);
+    this->m_pageMap[page] = physicalPage;
+    this->m_reverseMap[physicalPage] = page;
+    this->m_blocks[this->m_active].validPages++;
+    return OP_OK;
+}
+
+MicroFsFtl::Status MicroFsFtl::relocate(FwSizeType block) {
+    FW_ASSERT(block < this->m_numBlocks, static_cast<FwAssertArgType>(block));
+    FW_ASSERT(this->m_blocks[block].state == BLOCK_USED, this->m_blocks[block].state);
+
+    for (FwSizeType page = 0; page < this->m_pagesPerBlock; page++) {
+        const U32 logicalPage = this->m_reverseMap[(block * this->m_pagesPerBlock) + page];
+        if (logicalPage == UNMAPPED) {
+            continue;
+        }
+        if (this->m_device.read(block, page, this->m_pageBuffer) != MicroFsBlockDevice::OP_OK) {
+            return DEVICE_ERROR;
+        }
+        const Status status = this->append(logicalPage, this->m_pageBuffer);
+        if (status != OP_OK) {
+            return status;
+        }
+    }
+    FW_ASSERT(this->m_blocks[block].validPages == 0, this->m_blocks[block].validPages);
+    this->m_blocks[block].state = BLOCK_FREE;
+    this->m_freeBlocks++;
+    return OP_OK;
+}
+
+FwSizeType MicroFsFtl::allocateBlock() {
+    for (FwSizeType block = this->findBlock(BLOCK_FREE, false); block != NO_BLOCK;
+         block = this->findBlock(BLOCK_FREE, false)) {
+        this->m_freeBlocks--;
+        if (this->m_device.erase(block) != MicroFsBlockDevice::OP_OK) {
+            this->m_blocks[block].state = BLOCK_BAD;
+            continue;
+        }
+        this->m_erases++;
+        this->m_blocks[block].eraseCount++;
+        this->m_blocks[block].validPages = 0;
+        this->m_blocks[block].state = BLOCK_ACTIVE;
+        this->m_writePage = 0;
+        return block;
+    }
+    return NO_BLOCK;
+}
+
+void MicroFsFtl::invalidate(U32 physicalPage) {
+    if (physicalPage == UNMAPPED) {
+        return;
+    }
+    FW_ASSERT(physicalPage < (this->m_numBlocks * this->m_pagesPerBlock), static_cast<FwAssertArgType>(physicalPage));
+    BlockInfo& info = this->m_blocks[physicalPage / this->m_pagesPerBlock];
+    FW_ASSERT(info.validPages > 0);
+    info.validPages--;
+    this->m_reverseMap[physicalPage] = UNMAPPED;
+}
+
+FwSizeType MicroFsFtl::findBlock(BlockState state, bool fewestValid) const {
+    FwSizeType found = NO_BLOCK;
+    for (FwSizeType block = 0; block < this->m_numBlocks; block++) {
+        const BlockInfo& info = this->m_blocks[block];
+        if (info.state != state) {
+            continue;
+        }
+        if (found == NO_BLOCK) {
+            found = block;
+            continue;
+        }
+        const BlockInfo& best = this->m_blocks[found];
+        // fewest valid pages first if asked, then lowest erase count
+        if (fewestValid and (info.validPages != best.validPages)) {
+            if (info.validPages < best.validPages) {
+                found = block;
+            }
+        } else if (info.eraseCount < best.eraseCount) {
+            found = block;
+        }
+    }
+    return found;
+}
+
+}  // namespace Baremetal
+}  // namespace Os
@@ -0,0 +1,184 @@
+#ifndef _MICROFS_FTL_HPP_
+#define _MICROFS_FTL_HPP_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsBlockDevice.hpp>
+#include "config/MicroFsCfg.hpp"
+
+// MicroFsFtl - log-structured flash translation layer
+//
+// Presents a `MicroFsBlockDevice` as an array of logical pages that can be rewritten at will.
+// Writes are never done in place: each one is appended to the active block and the logical page
+// is remapped, leaving the previous copy invalid. When only `MICROFS_FTL_RESERVED_BLOCKS - 1`
+// free blocks remain, the used block with the fewest valid pages is garbage collected by moving
+// its valid pages to a fresh block. Blocks are erased right before they are reused.
+//
+// Wear is leveled two ways. New blocks are always taken from the free blocks with the lowest
+// erase count (dynamic leveling). When that count gets more than `MICROFS_FTL_WEAR_THRESHOLD`
+// ahead of the least erased used block, that block's data is considered cold and is moved, so
+// its block goes back into rotation (static leveling).
+//
+// The capacity is `MICROFS_FTL_RESERVED_BLOCKS` blocks less than the device. Pages that were
+// never written or were trimmed read as zeros. The mapping and erase counts are kept in RAM
+// only, like the rest of MicroFs, so the device starts out empty after each reset.
+//
+// Example for a device with 64 blocks of 16 pages of 256 bytes:
+//
+// static Os::Baremetal::MicroFsFtlStorage<64, 16, 256> ftl(myFlash);
+// static Os::Baremetal::MicroFsPageCacheStorage<8, 256> cache(ftl);
+
+namespace Os {
+namespace Baremetal {
+
+class MicroFsFtl {
+  public:
+    enum Status {
+        OP_OK,         //!< operation succeeded
+        DEVICE_ERROR,  //!< the device failed to read or program a page
+        NO_SPACE,      //!< no block could be freed. Only happens when blocks have worn out
+    };
+
+    enum BlockState : U8 {
+        BLOCK_FREE,    //!< holds no valid data, erased before it is used again
+        BLOCK_ACTIVE,  //!< block being appended to
+        BLOCK_USED,    //!< fully programmed
+        BLOCK_BAD,     //!< failed to erase, never used again
+    };
+
+    struct BlockInfo {
+        U32 eraseCount;    //!< number of times the block was erased
+        U32 validPages;    //!< number of pages still mapped to a logical page
+        BlockState state;  //!< state of the block
+    };
+
+    struct Stats {
+        U64 hostWrites;        //!< logical pages written
+        U64 flashWrites;       //!< pages programmed, including garbage collection and wear leveling moves
+        U64 erases;            //!< blocks erased
+        U32 minEraseCount;     //!< lowest erase count of the good blocks
+        U32 maxEraseCount;     //!< highest erase count of the good blocks
+        FwSizeType badBlocks;  //!< blocks that failed to erase
+    };
+
+    static constexpr U32 UNMAPPED = 0xFFFFFFFF;  //!< map entry of a page with no data
+
+    //! \brief number of logical pages offered for a device geometry
+    static constexpr FwSizeType getLogicalPages(FwSizeType numBlocks, FwSizeType pagesPerBlock) {
+        return (numBlocks - MICROFS_FTL_RESERVED_BLOCKS) * pagesPerBlock;
+    }
+
+    //! \brief construct a translation layer over table storage. The device is not accessed until the first write
+    //!
+    //! \param device: device holding the data. Its geometry must match the next three parameters
+    //! \param numBlocks: number of blocks of the device
+    //! \param pagesPerBlock: pages per block of the device
+    //! \param pageSize: bytes per page of the device
+    //! \param pageMap: storage for getLogicalPages(numBlocks, pagesPerBlock) entries
+    //! \param reverseMap: storage for numBlocks * pagesPerBlock entries
+    //! \param blocks: storage for numBlocks entries
+    //! \param pageBuffer: storage for pageSize bytes, used to move pages
+    MicroFsFtl(MicroFsBlockDevice& device,
+               FwSizeType numBlocks,
+               FwSizeType pagesPerBlock,
+               FwSizeType pageSize,
+               U32* pageMap,
+               U32* reverseMap,
+               BlockInfo* blocks,
+               U8* pageBuffer);
+
+    //! \brief forget all data. Erase counts and bad blocks are kept
+    void format();
+
+    //! \brief read a logical page
+    //!
+    //! \param page: logical page number
+    //! \param buffer: destination of pageSize bytes
+    Status readPage(U32 page, U8* buffer);
+
+    //! \brief write a logical page
+    //!
+    //! \param page: logical page number
+    //! \param buffer: source of pageSize bytes
+    Status writePage(U32 page, const U8* buffer);
+
+    //! \brief discard the data of a logical page, so garbage collection doesn't move it
+    void trimPage(U32 page);
+
+    //! \brief bytes per page
+    FwSizeType getPageSize() const;
+
+    //! \brief number of logical pages
+    FwSizeType getLogicalPages() const;
+
+    //! \brief erase count of a block
+    U32 getEraseCount(FwSizeType block) const;
+
+    //! \brief get the write and wear statistics
+    void getStats(Stats& stats) const;
+
+  private:
+    static constexpr FwSizeType NO_BLOCK = static_cast<FwSizeType>(-1);
+
+    //! \brief make sure the active block has a free page, collecting garbage or leveling wear as needed
+    Status ensureActive();
+
+    //! \brief program a page at the end of the active block and map it to a logical page
+    Status append(U32 page, const U8* buffer);
+
+    //! \brief move the valid pages of a block to the active block and free it
+    Status relocate(FwSizeType block);
+
+    //! \brief erase the least worn free block. Returns NO_BLOCK if there is none
+    FwSizeType allocateBlock();
+
+    //! \brief drop a physical page from the maps
+    void invalidate(U32 physicalPage);
+
+    //! \brief find the block in a state with the lowest erase count, or the fewest valid pages
+    FwSizeType findBlock(BlockState state, bool fewestValid) const;
+
+    MicroFsBlockDevice& m_device;  //!< device holding the data
+    FwSizeType m_numBlocks;        //!< blocks of the device
+    FwSizeType m_pagesPerBlock;    //!< pages per block
+    FwSizeType m_pageSize;         //!< bytes per page
+    U32* m_pageMap;                //!< physical page of each logical page
+    U32* m_reverseMap;             //!< logical page of each physical page
+    BlockInfo* m_blocks;           //!< state of each block
+    U8* m_pageBuffer;              //!< one page used to move data
+    FwSizeType m_active;           //!< block being appended to, or NO_BLOCK
+    FwSizeType m_writePage;        //!< next page to program in the active block
+    FwSizeType m_freeBlocks;       //!< number of blocks in BLOCK_FREE
+    U64 m_hostWrites;              //!< logical pages written
+    U64 m_flashWrites;             //!< pages programmed
+    U64 m_erases;                  //!< blocks erased
+};
+
+//! \brief translation layer with its own table storage for a device of NUM_BLOCKS blocks of PAGES_PER_BLOCK
+//! pages of PAGE_SIZE bytes
+template <FwSizeType NUM_BLOCKS, FwSizeType PAGES_PER_BLOCK, FwSizeType PAGE_SIZE>
+class MicroFsFtlStorage : public MicroFsFtl {
+    static_assert(NUM_BLOCKS > MICROFS_FTL_RESERVED_BLOCKS, "Device needs more blocks than are reserved");
+    static_assert((PAGES_PER_BLOCK > 0) and (PAGE_SIZE > 0), "Empty device geometry");
+
+  public:
+    explicit MicroFsFtlStorage(MicroFsBlockDevice& device)
+        : MicroFsFtl(device,
+                     NUM_BLOCKS,
+                     PAGES_PER_BLOCK,
+                     PAGE_SIZE,
+                     m_pageMapStorage,
+                     m_reverseMapStorage,
+                     m_blockStorage,
+                     m_pageBufferStorage) {}
+
+  private:
+    U32 m_pageMapStorage[MicroFsFtl::getLogicalPages(NUM_BLOCKS, PAGES_PER_BLOCK)];  //!< logical to physical
+    U32 m_reverseMapStorage[NUM_BLOCKS * PAGES_PER_BLOCK];                          //!< physical to logical
+    BlockInfo m_blockStorage[NUM_BLOCKS];                                           //!< block states
+    U8 m_pageBufferStorage[PAGE_SIZE];                                              //!< page moves
+};
+
+}  // namespace Baremetal
+}  // namespace Os
+
+#endif
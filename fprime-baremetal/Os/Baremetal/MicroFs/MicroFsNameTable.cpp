@@ -0,0 +1,117 @@
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsNameTable.hpp>
+
+#include <cstring>
+
+namespace Os {
+namespace Baremetal {
+
+// FNV-1a parameters
+static const U32 FNV_OFFSET_BASIS = 2166136261U;
+static const U32 FNV_PRIME = 16777619U;
+
+MicroFsNameTable::MicroFsNameTable(Entry* entries, FwSizeType capacity)
+    : m_entries(entries), m_mask(capacity - 1), m_count(0) {
+    FW_ASSERT(entries != nullptr);
+    FW_ASSERT((capacity >= 2) and ((capacity & (capacity - 1)) == 0), static_cast<FwAssertArgType>(capacity));
+    this->clear();
+}
+
+void MicroFsNameTable::clear() {
+    for (FwSizeType index = 0; index <= this->m_mask; index++) {
+        this->m_entries[index].slot = EMPTY_SLOT;
+    }
+    this->m_count = 0;
+}
+
+bool MicroFsNameTable::find(const char* name, FwIndexType& slot) const {
+    FW_ASSERT(name != nullptr);
+    FwSizeType length = 0;
+    const U32 hash = MicroFsNameTable::hashName(name, length);
+    if (length >= MICROFS_MAX_NAME_LENGTH) {
+        return false;
+    }
+
+    // probe until the name or an empty entry is found
+    for (FwSizeType index = hash & this->m_mask;; index = (index + 1) & this->m_mask) {
+        const Entry& entry = this->m_entries[index];
+        if (entry.slot == EMPTY_SLOT) {
+            return false;
+        }
+        if ((entry.hash == hash) and (strcmp(entry.name, name) == 0)) {
+            slot = entry.slot;
+            return true;
+        }
+    }
+}
+
+bool MicroFsNameTable::insert(const char* name, FwIndexType slot, FwSizeType& index) {
+    FW_ASSERT(name != nullptr);
+    FW_ASSERT(slot >= 0, slot);
+    if (not this->canInsert(name)) {
+        return false;
+    }
+    FwSizeType length = 0;
+    const U32 hash = MicroFsNameTable::hashName(name, length);
+
+    index = hash & this->m_mask;
+    while (this->m_entries[index].slot != EMPTY_SLOT) {
+        index = (index + 1) & this->m_mask;
+    }
+    Entry& entry = this->m_entries[index];
+    entry.hash = hash;
+    entry.slot = slot;
+    (void)memcpy(entry.name, name, length + 1);
+    this->m_count++;
+    return true;
+}
+
+bool MicroFsNameTable::canInsert(const char* name) const {
+    FW_ASSERT(name != nullptr);
+    FwSizeType length = 0;
+    (void)MicroFsNameTable::hashName(name, length);
+    return (length > 0) and (length < MICROFS_MAX_NAME_LENGTH) and (this->m_count < this->getMaxCount());
+}
+
+FwSizeType MicroFsNameTable::getCount() const {
+    return this->m_count;
+}
+
+FwSizeType MicroFsNameTable::getMaxCount() const {
+    // keep a quarter of the entries empty so probe sequences stay short
+    return ((this->m_mask + 1) * 3) / 4;
+}
+
+U32 MicroFsNameTable::hashName(const char* name, FwSizeType& length) {
+    U32 hash = FNV_OFFSET_BASIS;
+    length = 0;
+    // stop hashing past the maximum length, such names are rejected anyway
+    while ((name[length] != 0) and (length < MICROFS_MAX_NAME_LENGTH)) {
+        hash = (hash ^ static_cast<U8>(name[length])) * FNV_PRIME;
+        length++;
+    }
+    return hash;
+}
+
+void MicroFsNameTable::remove(FwSizeType index, MoveHook moved) {
+    FW_ASSERT(moved != nullptr);
+    FW_ASSERT(index <= this->m_mask, static_cast<FwAssertArgType>(index));
+    FW_ASSERT(this->m_entries[index].slot != EMPTY_SLOT, static_cast<FwAssertArgType>(index));
+    FW_ASSERT(this->m_count > 0);
+    FwSizeType hole = index;
+    for (FwSizeType next = (hole + 1) & this->m_mask; this->m_entries[next].slot != EMPTY_SLOT;
+         next = (next + 1) & this->m_mask) {
+        // an entry can fill the hole if the hole lies between its home position and where it is now
+        const FwSizeType home = this->m_entries[next].hash & this->m_mask;
+        if (((next - home) & this->m_mask) >= ((next - hole) & this->m_mask)) {
+            this->m_entries[hole] = this->m_entries[next];
+            moved(this->m_entries[hole].slot, hole);
+            hole = next;
+        }
+    }
+    this->m_entries[hole].slot = EMPTY_SLOT;
+    this->m_count--;
+}
+
+}  // namespace Baremetal
+}  // namespace Os
@@ -0,0 +1,115 @@
+#ifndef _MICROFS_NAME_TABLE_HPP_
+#define _MICROFS_NAME_TABLE_HPP_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include "config/MicroFsCfg.hpp"
+
+// MicroFsNameTable - optional mapping from arbitrary short paths to MicroFs file slots
+//
+// Without a name table, every file has to be opened as `/<bin prefix><bin #>/<file prefix><file #>`.
+// With a name table registered through `MicroFs::MicroFsSetNameTable`, any other path of up to
+// `MICROFS_MAX_NAME_LENGTH - 1` characters can be used as well. Opening an unknown name for writing
+// allocates the first free slot of the bin given at registration, and removing the file releases
+// the name. Named files also remain reachable through their bin path, which is what directory
+// listings and snapshots report.
+//
+// The table is a fixed-capacity open-addressing hash table with linear probing. Lookups hash the
+// path once and compare names only on hash matches, so they take constant expected time and never
+// allocate. Removal shifts the following entries back instead of leaving tombstones, so lookups stay
+// short however many files are created and removed. Callers keep the index of each entry, given by
+// insert and by a hook for each entry the removal shifts back, so removal never searches the table.
+// The table accepts entries up to 3/4 of its capacity.
+//
+// Example with room for 16 names, allocating files from bin 2:
+//
+// static Os::Baremetal::MicroFsNameTableStorage<16> nameTable;
+// Os::Baremetal::MicroFs::MicroFsInit(cfg, 0, mallocator);
+// Os::Baremetal::MicroFs::MicroFsSetNameTable(&nameTable, 2);
+//
+// Os::File file;
+// file.open("/seq/boot.bin", Os::File::OPEN_CREATE);
+
+namespace Os {
+namespace Baremetal {
+
+class MicroFsNameTable {
+  public:
+    static constexpr FwIndexType EMPTY_SLOT = -1;  //!< slot value of an unused entry
+    static constexpr FwIndexType NO_ENTRY = -1;    //!< entry index of a slot without a name
+
+    //! \brief called for each entry shifted back by remove, with its slot and its new index
+    using MoveHook = void (*)(FwIndexType slot, FwSizeType index);
+
+    struct Entry {
+        U32 hash;                            //!< hash of the name
+        FwIndexType slot;                    //!< file state index, or EMPTY_SLOT
+        char name[MICROFS_MAX_NAME_LENGTH];  //!< null-terminated name
+    };
+
+    //! \brief construct a table over entry storage
+    //!
+    //! \param entries: storage for the entries
+    //! \param capacity: number of entries. Must be a power of two
+    MicroFsNameTable(Entry* entries, FwSizeType capacity);
+
+    //! \brief remove every name
+    void clear();
+
+    //! \brief look up a name
+    //!
+    //! \param name: path to look up
+    //! \param slot: file state index of the name, if found
+    //! \return true if the name was found
+    bool find(const char* name, FwIndexType& slot) const;
+
+    //! \brief add a name
+    //!
+    //! \param name: path to add. Must not already be in the table
+    //! \param slot: file state index to map it to
+    //! \param index: (output) index of the entry holding the name, if added
+    //! \return true if added, false if the name is too long or the table is full
+    bool insert(const char* name, FwIndexType slot, FwSizeType& index);
+
+    //! \brief check that a name would be added
+    //!
+    //! \param name: path to check
+    //! \return true if insert would add the name, false if the name is too long or the table is full
+    bool canInsert(const char* name) const;
+
+    //! \brief remove the entry at index, shifting back the entries that probed past it
+    //!
+    //! \param index: index of the entry, given by insert or by the move hook of a previous removal
+    //! \param moved: called for each entry shifted back, so the caller can update the index it keeps
+    void remove(FwSizeType index, MoveHook moved);
+
+    //! \brief number of names in the table
+    FwSizeType getCount() const;
+
+    //! \brief maximum number of names in the table
+    FwSizeType getMaxCount() const;
+
+  private:
+    //! \brief hash a name, and get its length
+    static U32 hashName(const char* name, FwSizeType& length);
+
+    Entry* m_entries;    //!< entry storage
+    FwSizeType m_mask;   //!< capacity - 1
+    FwSizeType m_count;  //!< number of names in the table
+};
+
+//! \brief name table with its own storage for CAPACITY entries
+template <FwSizeType CAPACITY>
+class MicroFsNameTableStorage : public MicroFsNameTable {
+    static_assert((CAPACITY >= 2) and ((CAPACITY & (CAPACITY - 1)) == 0), "Capacity must be a power of two");
+
+  public:
+    MicroFsNameTableStorage() : MicroFsNameTable(m_storage, CAPACITY) {}
+
+  private:
+    Entry m_storage[CAPACITY];  //!< entry storage
+};
+
+}  // namespace Baremetal
+}  // namespace Os
+
+#endif
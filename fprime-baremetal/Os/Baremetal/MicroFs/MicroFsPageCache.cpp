@@ -0,0 +1,185 @@
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsPageCache.hpp>
+
+#include <cstring>
+
+namespace Os {
+namespace Baremetal {
+
+MicroFsPageCache::MicroFsPageCache(MicroFsFtl& ftl, Entry* entries, U8* pages, FwSizeType numPages)
+    : m_ftl(ftl),
+      m_entries(entries),
+      m_pages(pages),
+      m_numPages(numPages),
+      m_pageSize(ftl.getPageSize()),
+      m_useCount(0),
+      m_stats() {
+    FW_ASSERT(entries != nullptr);
+    FW_ASSERT(pages != nullptr);
+    FW_ASSERT(numPages > 0);
+    for (FwSizeType entry = 0; entry < numPages; entry++) {
+        this->m_entries[entry].page = MicroFsFtl::UNMAPPED;
+        this->m_entries[entry].lastUse = 0;
+        this->m_entries[entry].dirty = false;
+    }
+}
+
+FwSizeType MicroFsPageCache::getCapacity() const {
+    return this->m_ftl.getLogicalPages() * this->m_pageSize;
+}
+
+FwSizeType MicroFsPageCache::getPageSize() const {
+    return this->m_pageSize;
+}
+
+MicroFsPageCache::Status MicroFsPageCache::read(FwSizeType address, U8* buffer, FwSizeType size) {
+    FW_ASSERT(buffer != nullptr);
+    return this->access(ACCESS_READ, address, buffer, nullptr, size);
+}
+
+MicroFsPageCache::Status MicroFsPageCache::write(FwSizeType address, const U8* buffer, FwSizeType size) {
+    FW_ASSERT(buffer != nullptr);
+    return this->access(ACCESS_WRITE, address, nullptr, buffer, size);
+}
+
+MicroFsPageCache::Status MicroFsPageCache::zero(FwSizeType address, FwSizeType size) {
+    return this->access(ACCESS_ZERO, address, nullptr, nullptr, size);
+}
+
+void MicroFsPageCache::trim(FwSizeType address, FwSizeType size) {
+    FW_ASSERT((address % this->m_pageSize) == 0, static_cast<FwAssertArgType>(address));
+    FW_ASSERT((address + size) <= this->getCapacity(), static_cast<FwAssertArgType>(address),
+              static_cast<FwAssertArgType>(size));
+
+    const FwSizeType first = address / this->m_pageSize;
+    const FwSizeType end = (address + size + this->m_pageSize - 1) / this->m_pageSize;
+    for (FwSizeType page = first; page < end; page++) {
+        // drop any cached copy, even if it changed, since the data is no longer wanted
+        for (FwSizeType entry = 0; entry < this->m_numPages; entry++) {
+            if (this->m_entries[entry].page == page) {
+                this->m_entries[entry].page = MicroFsFtl::UNMAPPED;
+                this->m_entries[entry].dirty = false;
+            }
+        }
+        this->m_ftl.trimPage(static_cast<U32>(page));
+    }
+}
+
+MicroFsPageCache::Status MicroFsPageCache::flush() {
+    for (FwSizeType entry = 0; entry < this->m_numPages; entry++) {
+        const Status status = this->writeBack(entry);
+        if (status != MicroFsFtl::OP_OK) {
+            return status;
+        }
+    }
+    return MicroFsFtl::OP_OK;
+}
+
+void MicroFsPageCache::getStats(Stats& stats) const {
+    stats = this->m_stats;
+}
+
+MicroFsPageCache::Status MicroFsPageCache::access(Access type,
+                                                  FwSizeType address,
+                                                  U8* out,
+                                                  const U8* in,
+                                                  FwSizeType size) {
+    FW_ASSERT((address + size) <= this->getCapacity(), static_cast<FwAssertArgType>(address),
+              static_cast<FwAssertArgType>(size));
+
+    FwSizeType done = 0;
+    while (done < size) {
+        const FwSizeType page = (address + done) / this->m_pageSize;
+        const FwSizeType offset = (address + done) % this->m_pageSize;
+        FwSizeType chunk = this->m_pageSize - offset;
+        if (chunk > (size - done)) {
+            chunk = size - done;
+        }
+
+        // a page that is completely overwritten doesn't need its old contents
+        const bool load = (type == ACCESS_READ) or (chunk != this->m_pageSize);
+        FwSizeType entry = 0;
+        const Status status = this->getEntry(static_cast<U32>(page), load, entry);
+        if (status != MicroFsFtl::OP_OK) {
+            return status;
+        }
+
+        U8* data = &this->m_pages[(entry * this->m_pageSize) + offset];
+        switch (type) {
+            case ACCESS_READ:
+                (void)memcpy(&out[done], data, chunk);
+                break;
+            case ACCESS_WRITE:
+                (void)memcpy(data, &in[done], chunk);
+                this->m_entries[entry].dirty = true;
+                break;
+            case ACCESS_ZERO:
+                (void)memset(data, 0, chunk);
+                this->m_entries[entry].dirty = true;
+                break;
+            default:
+                FW_ASSERT(0, type);
+                break;
+        }
+        done += chunk;
+    }
+    return MicroFsFtl::OP_OK;
+}
+
+MicroFsPageCache::Status MicroFsPageCache::getEntry(U32 page, bool load, FwSizeType& entry) {
+    this->m_useCount++;
+
+    // look for the page, and the least recently used entry in case it isn't there
+    FwSizeType victim = 0;
+    for (FwSizeType index = 0; index < this->m_numPages; index++) {
+        Entry& current = this->m_entries[index];
+        if (current.page == page) {
+            current.lastUse = this->m_useCount;
+            this->m_stats.hits++;
+            entry = index;
+            return MicroFsFtl::OP_OK;
+        }
+        // empty entries go first. The age is computed with wrap-around so the counter can overflow
+        const Entry& oldest = this->m_entries[victim];
+        if ((oldest.page != MicroFsFtl::UNMAPPED) and
+            ((current.page == MicroFsFtl::UNMAPPED) or
+             ((this->m_useCount - current.lastUse) > (this->m_useCount - oldest.lastUse)))) {
+            victim = index;
+        }
+    }
+
+    this->m_stats.misses++;
+    Status status = this->writeBack(victim);
+    if (status != MicroFsFtl::OP_OK) {
+        return status;
+    }
+    Entry& replaced = this->m_entries[victim];
+    replaced.page = MicroFsFtl::UNMAPPED;
+    if (load) {
+        status = this->m_ftl.readPage(page, &this->m_pages[victim * this->m_pageSize]);
+        if (status != MicroFsFtl::OP_OK) {
+            return status;
+        }
+    }
+    replaced.page = page;
+    replaced.lastUse = this->m_useCount;
+    replaced.dirty = false;
+    entry = victim;
+    return MicroFsFtl::OP_OK;
+}
+
+MicroFsPageCache::Status MicroFsPageCache::writeBack(FwSizeType entry) {
+    Entry& current = this->m_entries[entry];
+    if ((current.page == MicroFsFtl::UNMAPPED) or (not current.dirty)) {
+        return MicroFsFtl::OP_OK;
+    }
+    const Status status = this->m_ftl.writePage(current.page, &this->m_pages[entry * this->m_pageSize]);
+    if (status == MicroFsFtl::OP_OK) {
+        current.dirty = false;
+        this->m_stats.writeBacks++;
+    }
+    return status;
+}
+
+}  // namespace Baremetal
+}  // namespace Os
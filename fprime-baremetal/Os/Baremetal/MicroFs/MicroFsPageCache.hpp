@@ -0,0 +1,121 @@
+#ifndef _MICROFS_PAGE_CACHE_HPP_
+#define _MICROFS_PAGE_CACHE_HPP_
+
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsFtl.hpp>
+
+// MicroFsPageCache - write-back page cache over a `MicroFsFtl`
+//
+// Gives byte-addressed access to the logical pages of a translation layer. Pages are loaded into
+// a small set of RAM pages on first access and written back only when they are evicted (least
+// recently used first) or on `flush()`, so the many small writes done by `Os::File` users cost a
+// single page program. Writes that cover a whole page skip loading it. The cache is searched
+// linearly, so it is meant to hold a handful of pages.
+//
+// A cache is given to MicroFs with `MicroFs::MicroFsAddDeviceBin`. Several bins can share one
+// cache; their files are placed one after the other, each starting on a page boundary.
+
+namespace Os {
+namespace Baremetal {
+
+class MicroFsPageCache {
+  public:
+    using Status = MicroFsFtl::Status;
+
+    struct Entry {
+        U32 page;     //!< logical page held, or MicroFsFtl::UNMAPPED
+        U32 lastUse;  //!< access count at the last use
+        bool dirty;   //!< changed since it was loaded
+    };
+
+    struct Stats {
+        U64 hits;        //!< accesses to a cached page
+        U64 misses;      //!< accesses that had to evict a page
+        U64 writeBacks;  //!< pages written to the translation layer
+    };
+
+    //! \brief construct a cache over entry and page storage
+    //!
+    //! \param ftl: translation layer holding the data
+    //! \param entries: storage for numPages entries
+    //! \param pages: storage for numPages pages of the translation layer page size
+    //! \param numPages: number of pages cached
+    MicroFsPageCache(MicroFsFtl& ftl, Entry* entries, U8* pages, FwSizeType numPages);
+
+    //! \brief number of bytes addressable through the cache
+    FwSizeType getCapacity() const;
+
+    //! \brief bytes per page
+    FwSizeType getPageSize() const;
+
+    //! \brief copy bytes out
+    Status read(FwSizeType address, U8* buffer, FwSizeType size);
+
+    //! \brief copy bytes in
+    Status write(FwSizeType address, const U8* buffer, FwSizeType size);
+
+    //! \brief set bytes to zero
+    Status zero(FwSizeType address, FwSizeType size);
+
+    //! \brief discard whole pages, dropping them from the cache and the translation layer
+    //!
+    //! \param address: start of the range. Must be page aligned
+    //! \param size: size of the range. Rounded up to whole pages
+    void trim(FwSizeType address, FwSizeType size);
+
+    //! \brief write every changed page back to the translation layer
+    Status flush();
+
+    //! \brief get the hit and write-back counts
+    void getStats(Stats& stats) const;
+
+  private:
+    enum Access {
+        ACCESS_READ,   //!< copy out of the cache
+        ACCESS_WRITE,  //!< copy into the cache
+        ACCESS_ZERO,   //!< clear in the cache
+    };
+
+    //! \brief do an access page by page
+    Status access(Access type, FwSizeType address, U8* out, const U8* in, FwSizeType size);
+
+    //! \brief get the entry holding a page, evicting the least recently used one if needed
+    //!
+    //! \param page: logical page
+    //! \param load: read the page contents on a miss. Not needed when the whole page is overwritten
+    //! \param entry: index of the entry
+    Status getEntry(U32 page, bool load, FwSizeType& entry);
+
+    //! \brief write an entry back if it is dirty
+    Status writeBack(FwSizeType entry);
+
+    MicroFsFtl& m_ftl;      //!< translation layer holding the data
+    Entry* m_entries;       //!< entry storage
+    U8* m_pages;            //!< page storage
+    FwSizeType m_numPages;  //!< number of pages cached
+    FwSizeType m_pageSize;  //!< bytes per page
+    U32 m_useCount;         //!< access counter for the LRU order
+    Stats m_stats;          //!< hit and write-back counts
+};
+
+//! \brief page cache with its own storage for NUM_PAGES pages of PAGE_SIZE bytes
+template <FwSizeType NUM_PAGES, FwSizeType PAGE_SIZE>
+class MicroFsPageCacheStorage : public MicroFsPageCache {
+    static_assert(NUM_PAGES > 0, "Cache needs at least one page");
+
+  public:
+    explicit MicroFsPageCacheStorage(MicroFsFtl& ftl)
+        : MicroFsPageCache(ftl, m_entryStorage, m_pageStorage, NUM_PAGES) {
+        FW_ASSERT(ftl.getPageSize() == PAGE_SIZE, static_cast<FwAssertArgType>(ftl.getPageSize()));
+    }
+
+  private:
+    Entry m_entryStorage[NUM_PAGES];          //!< entry storage
+    U8 m_pageStorage[NUM_PAGES * PAGE_SIZE];  //!< page storage
+};
+
+}  // namespace Baremetal
+}  // namespace Os
+
+#endif
@@ -0,0 +1,128 @@
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsSimFlash.hpp>
+
+#include <cstring>
+
+namespace Os {
+namespace Baremetal {
+
+MicroFsSimFlash::MicroFsSimFlash(const Config& config, FwEnumStoreType id, Fw::MemAllocator& allocator)
+    : m_config(config),
+      m_id(id),
+      m_allocator(allocator),
+      m_memory(nullptr),
+      m_eraseCounts(nullptr),
+      m_data(nullptr),
+      m_programmed(nullptr),
+      m_busyTimeUs(0),
+      m_reads(0),
+      m_programs(0),
+      m_violations(0) {
+    const Geometry& geometry = config.geometry;
+    FW_ASSERT((geometry.pageSize > 0) and (geometry.pagesPerBlock > 0) and (geometry.numBlocks > 0));
+    const FwSizeType numPages = geometry.numBlocks * geometry.pagesPerBlock;
+
+    // erase counts first so they are aligned, then the page contents and flags
+    const FwSizeType memSize = (geometry.numBlocks * sizeof(U32)) + (numPages * geometry.pageSize) + numPages;
+    FwSizeType reqMem = memSize;
+    bool recoverable = false;
+    this->m_memory = allocator.allocate(id, reqMem, recoverable);
+    FW_ASSERT(this->m_memory != nullptr);
+    FW_ASSERT(reqMem >= memSize, static_cast<FwAssertArgType>(reqMem), static_cast<FwAssertArgType>(memSize));
+
+    this->m_eraseCounts = static_cast<U32*>(this->m_memory);
+    this->m_data = reinterpret_cast<U8*>(&this->m_eraseCounts[geometry.numBlocks]);
+    this->m_programmed = reinterpret_cast<bool*>(&this->m_data[numPages * geometry.pageSize]);
+
+    // parts leave the factory erased
+    (void)memset(this->m_eraseCounts, 0, geometry.numBlocks * sizeof(U32));
+    (void)memset(this->m_data, 0xFF, numPages * geometry.pageSize);
+    for (FwSizeType page = 0; page < numPages; page++) {
+        this->m_programmed[page] = false;
+    }
+}
+
+MicroFsSimFlash::~MicroFsSimFlash() {
+    this->m_allocator.deallocate(this->m_id, this->m_memory);
+}
+
+MicroFsBlockDevice::Geometry MicroFsSimFlash::getGeometry() const {
+    return this->m_config.geometry;
+}
+
+MicroFsBlockDevice::Status MicroFsSimFlash::read(FwSizeType block, FwSizeType page, U8* buffer) {
+    FW_ASSERT(buffer != nullptr);
+    this->checkPage(block, page);
+    const FwSizeType index = (block * this->m_config.geometry.pagesPerBlock) + page;
+    (void)memcpy(buffer, &this->m_data[index * this->m_config.geometry.pageSize], this->m_config.geometry.pageSize);
+    this->m_busyTimeUs += this->m_config.readUs;
+    this->m_reads++;
+    return OP_OK;
+}
+
+MicroFsBlockDevice::Status MicroFsSimFlash::program(FwSizeType block, FwSizeType page, const U8* buffer) {
+    FW_ASSERT(buffer != nullptr);
+    this->checkPage(block, page);
+    const FwSizeType index = (block * this->m_config.geometry.pagesPerBlock) + page;
+    if (this->m_programmed[index] or (this->m_eraseCounts[block] >= this->m_config.endurance)) {
+        this->m_violations++;
+        return ERROR;
+    }
+
+    // programming can only clear bits
+    U8* data = &this->m_data[index * this->m_config.geometry.pageSize];
+    for (FwSizeType byte = 0; byte < this->m_config.geometry.pageSize; byte++) {
+        data[byte] &= buffer[byte];
+    }
+    this->m_programmed[index] = true;
+    this->m_busyTimeUs += this->m_config.programUs;
+    this->m_programs++;
+    return OP_OK;
+}
+
+MicroFsBlockDevice::Status MicroFsSimFlash::erase(FwSizeType block) {
+    this->checkPage(block, 0);
+    if (this->m_eraseCounts[block] >= this->m_config.endurance) {
+        this->m_violations++;
+        return ERROR;
+    }
+
+    const FwSizeType first = block * this->m_config.geometry.pagesPerBlock;
+    (void)memset(&this->m_data[first * this->m_config.geometry.pageSize], 0xFF,
+                 this->m_config.geometry.pagesPerBlock * this->m_config.geometry.pageSize);
+    for (FwSizeType page = 0; page < this->m_config.geometry.pagesPerBlock; page++) {
+        this->m_programmed[first + page] = false;
+    }
+    this->m_eraseCounts[block]++;
+    this->m_busyTimeUs += this->m_config.eraseUs;
+    return OP_OK;
+}
+
+U32 MicroFsSimFlash::getEraseCount(FwSizeType block) const {
+    this->checkPage(block, 0);
+    return this->m_eraseCounts[block];
+}
+
+U64 MicroFsSimFlash::getBusyTimeUs() const {
+    return this->m_busyTimeUs;
+}
+
+U64 MicroFsSimFlash::getReads() const {
+    return this->m_reads;
+}
+
+U64 MicroFsSimFlash::getPrograms() const {
+    return this->m_programs;
+}
+
+U64 MicroFsSimFlash::getViolations() const {
+    return this->m_violations;
+}
+
+void MicroFsSimFlash::checkPage(FwSizeType block, FwSizeType page) const {
+    FW_ASSERT(block < this->m_config.geometry.numBlocks, static_cast<FwAssertArgType>(block));
+    FW_ASSERT(page < this->m_config.geometry.pagesPerBlock, static_cast<FwAssertArgType>(page));
+}
+
+}  // namespace Baremetal
+}  // namespace Os
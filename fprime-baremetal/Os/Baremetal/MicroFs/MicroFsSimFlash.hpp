@@ -0,0 +1,85 @@
+#ifndef _MICROFS_SIM_FLASH_HPP_
+#define _MICROFS_SIM_FLASH_HPP_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <Fw/Types/MemAllocator.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsBlockDevice.hpp>
+
+// MicroFsSimFlash - simulated flash part for host tests and benchmarks
+//
+// Keeps the contents in memory from an allocator and follows the rules of real flash: erased
+// bytes read as 0xFF, programming can only clear bits, each page can be programmed once per
+// erase, and a block fails to erase once it has reached its endurance. Rule violations are
+// counted and rejected, so a bug in the layers above shows up in tests instead of on the part.
+//
+// Every operation adds its configured duration to a simulated busy time instead of sleeping,
+// so throughput can be computed as bytes over `getBusyTimeUs()`, and the erase count of each
+// block gives the wear distribution.
+
+namespace Os {
+namespace Baremetal {
+
+class MicroFsSimFlash : public MicroFsBlockDevice {
+  public:
+    struct Config {
+        Geometry geometry;  //!< layout of the part
+        U32 readUs;         //!< time to read a page
+        U32 programUs;      //!< time to program a page
+        U32 eraseUs;        //!< time to erase a block
+        U32 endurance;      //!< erase cycles before a block wears out
+    };
+
+    //! \brief allocate and erase a simulated part
+    //!
+    //! \param config: geometry, timing and endurance of the part
+    //! \param id: memory id passed to the allocator
+    //! \param allocator: allocator for the contents
+    MicroFsSimFlash(const Config& config, FwEnumStoreType id, Fw::MemAllocator& allocator);
+
+    //! \brief release the contents
+    ~MicroFsSimFlash() override;
+
+    MicroFsSimFlash(const MicroFsSimFlash& other) = delete;
+    MicroFsSimFlash& operator=(const MicroFsSimFlash& other) = delete;
+
+    Geometry getGeometry() const override;
+    Status read(FwSizeType block, FwSizeType page, U8* buffer) override;
+    Status program(FwSizeType block, FwSizeType page, const U8* buffer) override;
+    Status erase(FwSizeType block) override;
+
+    //! \brief number of times a block was erased
+    U32 getEraseCount(FwSizeType block) const;
+
+    //! \brief simulated time spent in operations, in microseconds
+    U64 getBusyTimeUs() const;
+
+    //! \brief number of pages read
+    U64 getReads() const;
+
+    //! \brief number of pages programmed
+    U64 getPrograms() const;
+
+    //! \brief number of rejected operations: programming a page twice, or using a worn out block
+    U64 getViolations() const;
+
+  private:
+    //! \brief check the address of a page
+    void checkPage(FwSizeType block, FwSizeType page) const;
+
+    Config m_config;                //!< geometry, timing and endurance
+    FwEnumStoreType m_id;           //!< memory id of the contents
+    Fw::MemAllocator& m_allocator;  //!< allocator of the contents
+    void* m_memory;                 //!< allocation holding the arrays below
+    U32* m_eraseCounts;             //!< erase count of each block
+    U8* m_data;                     //!< contents of each page
+    bool* m_programmed;             //!< page programmed since its block was erased
+    U64 m_busyTimeUs;               //!< simulated time spent in operations
+    U64 m_reads;                    //!< pages read
+    U64 m_programs;                 //!< pages programmed
+    U64 m_violations;               //!< rejected operations
+};
+
+}  // namespace Baremetal
+}  // namespace Os
+
+#endif
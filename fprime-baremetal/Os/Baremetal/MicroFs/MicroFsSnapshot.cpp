@@ -0,0 +1,185 @@
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsSnapshot.hpp>
+
+#include <cstring>
+
+namespace Os {
+namespace Baremetal {
+
+// out-of-line definitions for constants that are odr-used (required before C++17)
+constexpr U32 MicroFsSnapshot::MAGIC;
+constexpr U8 MicroFsSnapshot::VERSION;
+constexpr U8 MicroFsSnapshot::FLAG_FULL;
+constexpr U8 MicroFsSnapshot::ENTRY_DELETED;
+constexpr FwSizeType MicroFsSnapshot::HEADER_SIZE;
+constexpr FwSizeType MicroFsSnapshot::ENTRY_HEADER_SIZE;
+
+static_assert(MicroFsSnapshot::ENTRY_HEADER_SIZE <= MicroFsSnapshot::HEADER_SIZE,
+              "Entry header must fit in the staging buffer");
+
+// big-endian helpers for the image layout
+static void putU16(U8* dest, U16 value) {
+    dest[0] = static_cast<U8>(value >> 8);
+    dest[1] = static_cast<U8>(value);
+}
+
+static void putU32(U8* dest, U32 value) {
+    dest[0] = static_cast<U8>(value >> 24);
+    dest[1] = static_cast<U8>(value >> 16);
+    dest[2] = static_cast<U8>(value >> 8);
+    dest[3] = static_cast<U8>(value);
+}
+
+MicroFsSnapshot::MicroFsSnapshot()
+    : m_phase(IDLE),
+      m_numSlots(0),
+      m_slot(0),
+      m_entries(0),
+      m_entrySize(0),
+      m_offset(0),
+      m_stagedSize(0),
+      m_sequence(0) {}
+
+FwSizeType MicroFsSnapshot::begin(bool full) {
+    MicroFs& microfs = MicroFs::getSingleton();
+    FW_ASSERT(microfs.s_microFsMem != nullptr);
+
+    this->m_numSlots = microfs.s_binStart[microfs.s_microFsConfig.numBins];
+
+    // latch the slots to export, and clear the dirty flags so that changes made from here on
+    // are picked up by the next snapshot
+    this->m_entries = 0;
+    for (FwSizeType slot = 0; slot < this->m_numSlots; slot++) {
+        MicroFs::MicroFsFileState* state = MicroFs::getFileStateFromIndex(static_cast<FwIndexType>(slot));
+        // slots left over from an abandoned snapshot were never exported
+        if (state->inSnapshot) {
+            state->dirty = true;
+        }
+        // a full snapshot needs all existing files, but removals are meaningless. Read-only files
+        // are part of the build, so the ground already has them
+        state->inSnapshot = full ? (microfs.s_created[slot] and not state->readOnly) : state->dirty;
+        state->dirty = false;
+        if (state->inSnapshot) {
+            this->m_entries++;
+        }
+    }
+    // entry count is serialized as a U16
+    FW_ASSERT(this->m_entries <= 0xFFFF, static_cast<FwAssertArgType>(this->m_entries));
+
+    microfs.s_snapshotSequence++;
+    this->m_sequence = microfs.s_snapshotSequence;
+
+    // stage the image header
+    putU32(&this->m_staged[0], MAGIC);
+    this->m_staged[4] = VERSION;
+    this->m_staged[5] = full ? FLAG_FULL : 0;
+    putU16(&this->m_staged[6], static_cast<U16>(this->m_entries));
+    putU32(&this->m_staged[8], this->m_sequence);
+    this->m_stagedSize = HEADER_SIZE;
+
+    this->m_slot = 0;
+    this->m_offset = 0;
+    this->m_phase = HEADER;
+    return this->m_entries;
+}
+
+FwSizeType MicroFsSnapshot::read(U8* buffer, FwSizeType size) {
+    FW_ASSERT(buffer != nullptr);
+    FwSizeType produced = 0;
+
+    while ((produced < size) and (this->m_phase != DONE) and (this->m_phase != IDLE)) {
+        switch (this->m_phase) {
+            case HEADER:
+                produced += this->emitStaged(&buffer[produced], size - produced);
+                if (this->m_offset == this->m_stagedSize) {
+                    this->nextEntry();
+                }
+                break;
+            case ENTRY_HEADER:
+                produced += this->emitStaged(&buffer[produced], size - produced);
+                if (this->m_offset == this->m_stagedSize) {
+                    this->m_offset = 0;
+                    this->m_phase = ENTRY_DATA;
+                }
+                break;
+            case ENTRY_DATA: {
+                MicroFs::MicroFsFileState* state =
+                    MicroFs::getFileStateFromIndex(static_cast<FwIndexType>(this->m_slot));
+                FwSizeType chunk = this->m_entrySize - this->m_offset;
+                if (chunk > (size - produced)) {
+                    chunk = size - produced;
+                }
+                // the latched size never exceeds the slot buffer, so this stays in bounds even if the
+                // file was truncated after its entry header was emitted. A device error can't be reported
+                // in the middle of the image, so the data reads as zeros instead
+                if (MicroFs::readFileData(state, this->m_offset, &buffer[produced], chunk) != MicroFs::Status::VALID) {
+                    (void)memset(&buffer[produced], 0, chunk);
+                }
+                produced += chunk;
+                this->m_offset += chunk;
+                if (this->m_offset == this->m_entrySize) {
+                    state->inSnapshot = false;
+                    this->m_slot++;
+                    this->nextEntry();
+                }
+                break;
+            }
+            default:
+                FW_ASSERT(0, this->m_phase);
+                break;
+        }
+    }
+    return produced;
+}
+
+bool MicroFsSnapshot::done() const {
+    return (this->m_phase == DONE);
+}
+
+U32 MicroFsSnapshot::getSequence() const {
+    return this->m_sequence;
+}
+
+void MicroFsSnapshot::nextEntry() {
+    MicroFs& microfs = MicroFs::getSingleton();
+
+    for (; this->m_slot < this->m_numSlots; this->m_slot++) {
+        MicroFs::MicroFsFileState* state = MicroFs::getFileStateFromIndex(static_cast<FwIndexType>(this->m_slot));
+        if (not state->inSnapshot) {
+            continue;
+        }
+
+        // map the slot back to its bin and file numbers
+        FwIndexType bin = 0;
+        while (this->m_slot >= microfs.s_binStart[bin + 1]) {
+            bin++;
+        }
+        const FwSizeType file = this->m_slot - microfs.s_binStart[bin];
+
+        // latch the size now so header and data agree even if the file changes while streaming
+        const bool created = microfs.s_created[this->m_slot];
+        this->m_entrySize = created ? microfs.s_currSize[this->m_slot] : 0;
+        putU16(&this->m_staged[0], static_cast<U16>(bin));
+        putU16(&this->m_staged[2], static_cast<U16>(file));
+        this->m_staged[4] = created ? 0 : ENTRY_DELETED;
+        putU32(&this->m_staged[5], static_cast<U32>(this->m_entrySize));
+        this->m_stagedSize = ENTRY_HEADER_SIZE;
+        this->m_offset = 0;
+        this->m_phase = ENTRY_HEADER;
+        return;
+    }
+    this->m_phase = DONE;
+}
+
+FwSizeType MicroFsSnapshot::emitStaged(U8* buffer, FwSizeType size) {
+    FwSizeType chunk = this->m_stagedSize - this->m_offset;
+    if (chunk > size) {
+        chunk = size;
+    }
+    (void)memcpy(buffer, &this->m_staged[this->m_offset], chunk);
+    this->m_offset += chunk;
+    return chunk;
+}
+
+}  // namespace Baremetal
+}  // namespace Os
@@ -0,0 +1,111 @@
+#ifndef _MICROFS_SNAPSHOT_HPP_
+#define _MICROFS_SNAPSHOT_HPP_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFs.hpp>
+
+// MicroFsSnapshot - incremental export of the MicroFs contents
+//
+// Every file slot carries a `dirty` flag that is set whenever the slot is created, truncated,
+// written, extended or removed. A snapshot captures the set of dirty slots (or every created
+// slot for a full snapshot), clears their flags and then streams a compact image in chunks
+// of any size. The image can be written to a file and sent with `Svc/FileDownlink`, or placed
+// directly into outgoing buffers. A slot changed while its snapshot is still streaming is
+// flagged dirty again and will appear in the next snapshot.
+//
+// The image is big-endian and laid out as follows:
+//
+// Header (HEADER_SIZE bytes):
+//   U32 magic       - `MAGIC` ("MFSS")
+//   U8  version     - `VERSION`
+//   U8  flags       - `FLAG_FULL` if every created file is included
+//   U16 entryCount  - number of entries that follow
+//   U32 sequence    - snapshot sequence number, incremented on each `begin()` since `MicroFsInit`
+//
+// Then `entryCount` entries, each made of (ENTRY_HEADER_SIZE bytes):
+//   U16 bin         - bin number of the slot
+//   U16 file        - file number of the slot within the bin
+//   U8  flags       - `ENTRY_DELETED` if the file was removed
+//   U32 size        - number of data bytes that follow
+// followed by `size` bytes of file data.
+//
+// Example of writing a snapshot into a file for downlink:
+//
+// Os::Baremetal::MicroFsSnapshot snapshot;
+// snapshot.begin(false);
+// U8 chunk[128];
+// FwSizeType size = 0;
+// while ((size = snapshot.read(chunk, sizeof(chunk))) > 0) {
+//     (void)file.write(chunk, size);
+// }
+//
+// Snapshots can be unpacked on the ground with the `microfs-unpack` tool (see `tools/`).
+
+namespace Os {
+namespace Baremetal {
+
+class MicroFsSnapshot {
+  public:
+    static constexpr U32 MAGIC = 0x4D465353;  //!< "MFSS"
+    static constexpr U8 VERSION = 1;          //!< image format version
+    static constexpr U8 FLAG_FULL = 0x01;     //!< header flag: image includes every created file
+    static constexpr U8 ENTRY_DELETED = 0x01;  //!< entry flag: file was removed since the last snapshot
+    static constexpr FwSizeType HEADER_SIZE = 12;       //!< size of the serialized image header
+    static constexpr FwSizeType ENTRY_HEADER_SIZE = 9;  //!< size of each serialized entry header
+
+    //! \brief construct an idle snapshot stream
+    MicroFsSnapshot();
+
+    //! \brief start a new snapshot
+    //!
+    //! Latches the slots to export and clears their dirty flags. A snapshot already in progress is abandoned;
+    //! its remaining slots stay dirty for the next one.
+    //!
+    //! \param full: include every created file instead of only the changed ones
+    //! \return number of entries in the snapshot
+    FwSizeType begin(bool full);
+
+    //! \brief get the next chunk of the image
+    //!
+    //! \param buffer: destination for the image bytes
+    //! \param size: capacity of the destination
+    //! \return number of bytes written to buffer. Zero once the image is complete.
+    FwSizeType read(U8* buffer, FwSizeType size);
+
+    //! \brief check if the current snapshot has been fully streamed
+    bool done() const;
+
+    //! \brief sequence number of the current snapshot
+    U32 getSequence() const;
+
+  private:
+    //! stream phases
+    enum Phase {
+        IDLE,          //!< no snapshot started
+        HEADER,        //!< emitting the image header
+        ENTRY_HEADER,  //!< emitting an entry header
+        ENTRY_DATA,    //!< emitting entry file data
+        DONE,          //!< image complete
+    };
+
+    //! \brief find the next captured slot at or after m_slot, and stage its entry header
+    void nextEntry();
+
+    //! \brief copy staged header bytes to the buffer
+    FwSizeType emitStaged(U8* buffer, FwSizeType size);
+
+    Phase m_phase;             //!< current stream phase
+    FwSizeType m_numSlots;     //!< number of slots in the file system
+    FwSizeType m_slot;         //!< slot currently being emitted
+    FwSizeType m_entries;      //!< number of entries latched by begin()
+    FwSizeType m_entrySize;    //!< data size latched for the current entry
+    FwSizeType m_offset;       //!< offset within the staged header or entry data
+    FwSizeType m_stagedSize;   //!< number of bytes in m_staged
+    U32 m_sequence;            //!< sequence number of this snapshot
+    U8 m_staged[HEADER_SIZE];  //!< serialized header waiting to be emitted
+};
+
+}  // namespace Baremetal
+}  // namespace Os
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef _MICROFS_STATIC_HPP_
+#define _MICROFS_STATIC_HPP_
+
+#include <Fw/Types/BasicTypes.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFs.hpp>
+
+// MicroFsStaticLayout - compile-time MicroFs layout
+//
+// `MicroFsInit` computes the layout at runtime and requests the memory from an allocator.
+// When the bins are fixed for a build, `MicroFsStaticLayout` computes the configuration,
+// the first file state of each bin, and the storage size at compile time, and reserves the
+// storage as a static object. The storage lands in `.bss` where it is visible to the size
+// tool, and no allocator is needed.
+//
+// Each bin is described by a `MicroFsBinSpec<file size, number of files>`. The example from
+// `MicroFs.hpp` with three 1K files and ten 10K files becomes:
+//
+// using MyFs = Os::Baremetal::MicroFsStaticLayout<Os::Baremetal::MicroFsBinSpec<1024, 3>,
+//                                                 Os::Baremetal::MicroFsBinSpec<10 * 1024, 10>>;
+// MyFs::init();
+//
+// Read-only bins are described by a `MicroFsRomBinSpec<file table, number of files>`, for
+// example with a table generated by `baremetal-romfs`:
+//
+// using MyFs = Os::Baremetal::MicroFsStaticLayout<Os::Baremetal::MicroFsBinSpec<1024, 3>,
+//                                                 Os::Baremetal::MicroFsRomBinSpec<BootFiles, BOOT_FILES_COUNT>>;
+//
+// Bins stored on a block device are described by a `MicroFsDeviceBinSpec<&cache, file size, number of
+// files>`, where `cache` is a `MicroFsPageCache` with static storage duration.
+//
+// `MyFs::STORAGE_SIZE` holds the number of bytes reserved. If the program is meant to terminate,
+// call `MyFs::cleanup()` at the end.
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief a bin of NUM_FILES files of FILE_SIZE bytes. See `MicroFs::MicroFsSetBinEviction` for EVICT
+template <FwSizeType FILE_SIZE, FwSizeType NUM_FILES, MicroFs::EvictPolicy EVICT = MicroFs::EVICT_NONE>
+struct MicroFsBinSpec {
+    static constexpr FwSizeType fileSize = FILE_SIZE;                    //!< size of the files in the bin
+    static constexpr FwSizeType numFiles = NUM_FILES;                    //!< number of files in the bin
+    static constexpr const MicroFs::MicroFsRomFile* romFiles = nullptr;  //!< RAM bin
+    static constexpr MicroFs::EvictPolicy evictPolicy = EVICT;           //!< how to get a new file when full
+    static constexpr MicroFsPageCache* device = nullptr;                 //!< data in memory
+    static constexpr FwSizeType bufferSize = FILE_SIZE;                  //!< memory per file
+};
+
+//! \brief a read-only bin of the NUM_FILES files in the table FILES. See `MicroFs::MicroFsAddRomBin`
+template <const MicroFs::MicroFsRomFile* FILES, FwSizeType NUM_FILES>
+struct MicroFsRomBinSpec {
+    static constexpr FwSizeType fileSize = 0;                                 //!< no RAM is reserved for the file data
+    static constexpr FwSizeType numFiles = NUM_FILES;                         //!< number of files in the bin
+    static constexpr const MicroFs::MicroFsRomFile* romFiles = FILES;         //!< contents of the files
+    static constexpr MicroFs::EvictPolicy evictPolicy = MicroFs::EVICT_NONE;  //!< read-only files are kept
+    static constexpr MicroFsPageCache* device = nullptr;                      //!< data in read-only memory
+    static constexpr FwSizeType bufferSize = 0;                               //!< no memory per file
+};
+
+//! \brief a bin of NUM_FILES files of FILE_SIZE bytes stored through the page cache DEVICE. See
+//! `MicroFs::MicroFsAddDeviceBin`
+template <MicroFsPageCache* DEVICE,
+          FwSizeType FILE_SIZE,
+          FwSizeType NUM_FILES,
+          MicroFs::EvictPolicy EVICT = MicroFs::EVICT_NONE>
+struct MicroFsDeviceBinSpec {
+    static constexpr FwSizeType fileSize = FILE_SIZE;                    //!< size of the files in the bin
+    static constexpr FwSizeType numFiles = NUM_FILES;                    //!< number of files in the bin
+    static constexpr const MicroFs::MicroFsRomFile* romFiles = nullptr;  //!< writable bin
+    static constexpr MicroFs::EvictPolicy evictPolicy = EVICT;           //!< how to get a new file when full
+    static constexpr MicroFsPageCache* device = DEVICE;                  //!< cache of the device holding the data
+    static constexpr FwSizeType bufferSize = 0;                          //!< no memory per file
+};
+
+namespace MicroFsStaticDetail {
+
+//! totals over a list of bins
+template <typename... Bins>
+struct Totals;
+
+template <>
+struct Totals<> {
+    static constexpr FwSizeType files = 0;
+    static constexpr FwSizeType bytes = 0;
+};
+
+template <typename First, typename... Rest>
+struct Totals<First, Rest...> {
+    static constexpr FwSizeType files = First::numFiles + Totals<Rest...>::files;
+    static constexpr FwSizeType bytes =
+        (First::numFiles * First::bufferSize) + Totals<Rest...>::bytes;
+};
+
+//! compile-time sequence of indices 0..N-1
+template <FwSizeType... I>
+struct Indices {};
+
+template <FwSizeType N, FwSizeType... I>
+struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+
+template <FwSizeType... I>
+struct MakeIndices<0, I...> {
+    using type = Indices<I...>;
+};
+
+//! first file state of bin `bin`, given the number of files in each bin
+constexpr FwSizeType binStart(const FwSizeType* numFiles, FwSizeType bin) {
+    return (bin == 0) ? 0 : binStart(numFiles, bin - 1) + numFiles[bin - 1];
+}
+
+//! table of the first file state of each bin, followed by the total number of file states
+template <typename Layout, typename Sequence>
+struct BinStartTable;
+
+template <typename Layout, FwSizeType... I>
+struct BinStartTable<Layout, Indices<I...>> {
+    static constexpr FwSizeType values[sizeof...(I)] = {binStart(Layout::NUM_FILES, I)...};
+};
+
+template <typename Layout, FwSizeType... I>
+constexpr FwSizeType BinStartTable<Layout, Indices<I...>>::values[sizeof...(I)];
+
+}  // namespace MicroFsStaticDetail
+
+//! \brief MicroFs layout computed at compile time from a list of `MicroFsBinSpec`
+template <typename... Bins>
+class MicroFsStaticLayout {
+  public:
+    static constexpr FwIndexType NUM_BINS = sizeof...(Bins);  //!< number of bins
+    static constexpr FwSizeType NUM_FILES[NUM_BINS] = {Bins::numFiles...};  //!< number of files in each bin
+    static constexpr FwSizeType TOTAL_FILES = MicroFsStaticDetail::Totals<Bins...>::files;  //!< number of files
+    //! bytes needed for the file states, the file sizes and existence flags, and the file data
+    static constexpr FwSizeType STORAGE_SIZE = (TOTAL_FILES * sizeof(MicroFs::MicroFsFileState)) +
+                                               MicroFs::getHotSize(TOTAL_FILES) +
+                                               MicroFsStaticDetail::Totals<Bins...>::bytes;
+
+    static_assert(NUM_BINS > 0, "MicroFs needs at least one bin");
+    static_assert(NUM_BINS <= MAX_MICROFS_BINS, "Too many bins for MAX_MICROFS_BINS");
+    static_assert(TOTAL_FILES > 0, "MicroFs needs at least one file");
+
+    //! first file state of each bin, followed by the total number of file states
+    using BinStart = MicroFsStaticDetail::BinStartTable<MicroFsStaticLayout,
+                                                        typename MicroFsStaticDetail::MakeIndices<NUM_BINS + 1>::type>;
+
+    //! configuration equivalent to the one built with `MicroFsAddBin`
+    static constexpr MicroFs::MicroFsConfig CONFIG = {
+        NUM_BINS,
+        {{Bins::fileSize, Bins::numFiles, Bins::romFiles, Bins::evictPolicy, Bins::device}...}};
+
+    //! \brief initialize MicroFs in the static storage
+    static void init() { MicroFs::MicroFsInitStatic(CONFIG, BinStart::values, s_storage.bytes, STORAGE_SIZE); }
+
+    //! \brief release the static storage
+    static void cleanup() { MicroFs::MicroFsCleanupStatic(); }
+
+  private:
+    //! storage for the file states and file data
+    struct alignas(MicroFs::MicroFsFileState) Storage {
+        U8 bytes[STORAGE_SIZE];
+    };
+    static Storage s_storage;
+};
+
+template <typename... Bins>
+constexpr FwIndexType MicroFsStaticLayout<Bins...>::NUM_BINS;
+
+template <typename... Bins>
+constexpr FwSizeType MicroFsStaticLayout<Bins...>::NUM_FILES[MicroFsStaticLayout<Bins...>::NUM_BINS];
+
+template <typename... Bins>
+constexpr FwSizeType MicroFsStaticLayout<Bins...>::TOTAL_FILES;
+
+template <typename... Bins>
+constexpr FwSizeType MicroFsStaticLayout<Bins...>::STORAGE_SIZE;
+
+template <typename... Bins>
+constexpr MicroFs::MicroFsConfig MicroFsStaticLayout<Bins...>::CONFIG;
+
+template <typename... Bins>
+typename MicroFsStaticLayout<Bins...>::Storage MicroFsStaticLayout<Bins...>::s_storage;
+
+}  // namespace Baremetal
+}  // namespace Os
+
+#endif
@@ -12,6 +12,14 @@
 #define OFF_NOMINAL
 #define NEW_TEST
 #define SIM_FILE_TEST
+#define SNAPSHOT_TEST
+#define STATIC_LAYOUT_TEST
+#define ROM_BIN_TEST
+#define NAME_TABLE_TEST
+#define EVICTION_TEST
+#define HOT_COLD_TEST
+#define FTL_TEST
+#define DEVICE_BIN_TEST
 
 #ifdef FULL_TEST
 
@@ -125,6 +133,62 @@ TEST(FileOps, NewTest) {
 }
 #endif
 
+#ifdef SNAPSHOT_TEST
+TEST(FileOps, SnapshotTest) {
+    Os::Tester tester;
+    tester.SnapshotTest();
+}
+#endif
+
+#ifdef STATIC_LAYOUT_TEST
+TEST(Initialization, StaticLayoutTest) {
+    Os::Tester tester;
+    tester.StaticLayoutTest();
+}
+#endif
+
+#ifdef ROM_BIN_TEST
+TEST(FileOps, RomBinTest) {
+    Os::Tester tester;
+    tester.RomBinTest();
+}
+#endif
+
+#ifdef NAME_TABLE_TEST
+TEST(FileOps, NameTableTest) {
+    Os::Tester tester;
+    tester.NameTableTest();
+}
+#endif
+
+#ifdef EVICTION_TEST
+TEST(FileOps, EvictionTest) {
+    Os::Tester tester;
+    tester.EvictionTest();
+}
+#endif
+
+#ifdef HOT_COLD_TEST
+TEST(FileOps, HotColdTest) {
+    Os::Tester tester;
+    tester.HotColdTest();
+}
+#endif
+
+#ifdef FTL_TEST
+TEST(FileOps, FtlTest) {
+    Os::Tester tester;
+    tester.FtlTest();
+}
+#endif
+
+#ifdef DEVICE_BIN_TEST
+TEST(FileOps, DeviceBinTest) {
+    Os::Tester tester;
+    tester.DeviceBinTest();
+}
+#endif
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -4,6 +4,9 @@
 #include <Fw/Test/UnitTest.hpp>
 #include <Fw/Types/Assert.hpp>
 #include "STest/Random/Random.hpp"
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsSimFlash.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsSnapshot.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFsStatic.hpp>
 
 namespace Os {
 
@@ -54,6 +57,629 @@ void Tester ::NewTest() {
     cleanup.apply(*this);
 }
 
+// ----------------------------------------------------------------------
+// SnapshotTest
+// ----------------------------------------------------------------------
+
+// Stream a snapshot in small chunks and return the image size
+static FwSizeType readSnapshot(Os::Baremetal::MicroFsSnapshot& snapshot, U8* image, FwSizeType capacity) {
+    const FwSizeType CHUNK = 5;  // smaller than the headers to exercise partial emission
+    FwSizeType size = 0;
+    FwSizeType chunk = 0;
+    do {
+        FW_ASSERT(size + CHUNK <= capacity, static_cast<FwAssertArgType>(size));
+        chunk = snapshot.read(&image[size], CHUNK);
+        size += chunk;
+    } while (chunk > 0);
+    EXPECT_TRUE(snapshot.done());
+    return size;
+}
+
+void Tester ::SnapshotTest() {
+    const U16 NumberBins = 2;
+    const U16 NumberFiles = 2;
+    const FwSizeType HEADER = Os::Baremetal::MicroFsSnapshot::HEADER_SIZE;
+    const FwSizeType ENTRY = Os::Baremetal::MicroFsSnapshot::ENTRY_HEADER_SIZE;
+
+    InitFileSystem initFileSystem(NumberBins, FILE_SIZE, NumberFiles);
+    Cleanup cleanup;
+    initFileSystem.apply(*this);
+
+    Os::Baremetal::MicroFsSnapshot snapshot;
+    U8 image[2 * FILE_SIZE];
+    BYTE data[] = {1, 2, 3, 4, 5, 6, 7};
+    FwSizeType size = sizeof(data);
+
+    // Nothing has changed since initialization
+    ASSERT_EQ(0, snapshot.begin(false));
+    ASSERT_EQ(HEADER, readSnapshot(snapshot, image, sizeof(image)));
+    ASSERT_EQ(Os::Baremetal::MicroFsSnapshot::MAGIC,
+              (static_cast<U32>(image[0]) << 24) | (image[1] << 16) | (image[2] << 8) | image[3]);
+    ASSERT_EQ(1, snapshot.getSequence());
+
+    // Write /bin1/file0 and check it is the only entry
+    Os::File file;
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file0", Os::File::OPEN_WRITE));
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+    file.close();
+
+    ASSERT_EQ(1, snapshot.begin(false));
+    ASSERT_EQ(HEADER + ENTRY + sizeof(data), readSnapshot(snapshot, image, sizeof(image)));
+    ASSERT_EQ(0, image[HEADER + 0]);  // bin 1
+    ASSERT_EQ(1, image[HEADER + 1]);
+    ASSERT_EQ(0, image[HEADER + 3]);  // file 0
+    ASSERT_EQ(0, image[HEADER + 4]);  // not deleted
+    ASSERT_EQ(sizeof(data), image[HEADER + 8]);
+    ASSERT_EQ(0, memcmp(data, &image[HEADER + ENTRY], sizeof(data)));
+
+    // Exported changes are not repeated
+    ASSERT_EQ(0, snapshot.begin(false));
+    ASSERT_EQ(HEADER, readSnapshot(snapshot, image, sizeof(image)));
+
+    // A full snapshot includes every created file
+    ASSERT_EQ(1, snapshot.begin(true));
+    ASSERT_EQ(HEADER + ENTRY + sizeof(data), readSnapshot(snapshot, image, sizeof(image)));
+    ASSERT_EQ(Os::Baremetal::MicroFsSnapshot::FLAG_FULL, image[5]);
+
+    // Removal is reported as a deleted entry without data
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/bin1/file0"));
+    ASSERT_EQ(1, snapshot.begin(false));
+    ASSERT_EQ(HEADER + ENTRY, readSnapshot(snapshot, image, sizeof(image)));
+    ASSERT_EQ(Os::Baremetal::MicroFsSnapshot::ENTRY_DELETED, image[HEADER + 4]);
+
+    // Slots of an abandoned snapshot are carried into the next one
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin0/file1", Os::File::OPEN_WRITE));
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+    file.close();
+    ASSERT_EQ(1, snapshot.begin(false));
+    ASSERT_EQ(HEADER, snapshot.read(image, HEADER));
+    ASSERT_EQ(1, snapshot.begin(false));
+    ASSERT_EQ(HEADER + ENTRY + sizeof(data), readSnapshot(snapshot, image, sizeof(image)));
+    ASSERT_EQ(7, snapshot.getSequence());
+
+    cleanup.apply(*this);
+}
+
+// ----------------------------------------------------------------------
+// StaticLayoutTest
+// ----------------------------------------------------------------------
+
+void Tester ::StaticLayoutTest() {
+    using Layout = Os::Baremetal::MicroFsStaticLayout<Os::Baremetal::MicroFsBinSpec<FILE_SIZE, 3>,
+                                                      Os::Baremetal::MicroFsBinSpec<FILE_SIZE / 2, 2>>;
+    static_assert(Layout::TOTAL_FILES == 5, "Wrong file count");
+    static_assert(Layout::BinStart::values[1] == 3, "Wrong bin start");
+    static_assert(Layout::BinStart::values[2] == 5, "Wrong total");
+    static_assert(Layout::STORAGE_SIZE ==
+                      (5 * sizeof(Os::Baremetal::MicroFs::MicroFsFileState)) +
+                          Os::Baremetal::MicroFs::getHotSize(5) + (3 * FILE_SIZE) + FILE_SIZE,
+                  "Wrong storage size");
+
+    Layout::init();
+
+    // Files map to the same slots as with a runtime configuration
+    FwIndexType index = 0;
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::getFileStateIndex("/bin1/file1", index));
+    ASSERT_EQ(4, index);
+    ASSERT_EQ(Os::Baremetal::MicroFs::INVALID, Os::Baremetal::MicroFs::getFileStateIndex("/bin1/file2", index));
+    ASSERT_EQ(Os::Baremetal::MicroFs::INVALID, Os::Baremetal::MicroFs::getFileStateIndex("/bin2/file0", index));
+
+    // Writes are limited to the file size of the bin
+    Os::File file;
+    BYTE data[FILE_SIZE];
+    memset(data, 0x5A, sizeof(data));
+    FwSizeType size = sizeof(data);
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file1", Os::File::OPEN_WRITE));
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+    ASSERT_EQ(FILE_SIZE / 2, size);
+    file.close();
+
+    FwSizeType totalBytes = 0;
+    FwSizeType freeBytes = 0;
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::getFreeSpace("/", totalBytes, freeBytes));
+    ASSERT_EQ(4 * FILE_SIZE, totalBytes);
+    ASSERT_EQ(4 * FILE_SIZE - FILE_SIZE / 2, freeBytes);
+
+    // Re-initialization starts from an empty file system
+    Layout::cleanup();
+    Layout::init();
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/bin1/file1", Os::File::OPEN_READ));
+    Layout::cleanup();
+}
+
+// ----------------------------------------------------------------------
+// RomBinTest
+// ----------------------------------------------------------------------
+
+static const U8 romFile0[] = {'s', 'e', 'q', 'u', 'e', 'n', 'c', 'e'};
+static const U8 romFile1[] = {0xDE, 0xAD, 0xBE, 0xEF};
+static const Os::Baremetal::MicroFs::MicroFsRomFile romFiles[] = {
+    {romFile0, sizeof(romFile0)},
+    {romFile1, sizeof(romFile1)},
+};
+
+void Tester ::RomBinTest() {
+    Os::Baremetal::MicroFs::MicroFsSetCfgBins(this->testCfg, 2);
+    Os::Baremetal::MicroFs::MicroFsAddBin(this->testCfg, 0, FILE_SIZE, 2);
+    Os::Baremetal::MicroFs::MicroFsAddRomBin(this->testCfg, 1, romFiles, 2);
+    Os::Baremetal::MicroFs::MicroFsInit(this->testCfg, 0, this->alloc);
+
+    // Read-only files exist from initialization and are read in place
+    Os::File file;
+    BYTE buffer[FILE_SIZE];
+    FwSizeType size = sizeof(buffer);
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file0", Os::File::OPEN_READ));
+    ASSERT_EQ(Os::File::OP_OK, file.read(buffer, size));
+    ASSERT_EQ(sizeof(romFile0), size);
+    ASSERT_EQ(0, memcmp(romFile0, buffer, size));
+    file.close();
+
+    FwIndexType index = 0;
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::getFileStateIndex("/bin1/file1", index));
+    ASSERT_EQ(romFile1, Os::Baremetal::MicroFs::getFileStateFromIndex(index)->data);
+
+    // They can't be changed
+    ASSERT_EQ(Os::File::NO_PERMISSION, file.open("/bin1/file0", Os::File::OPEN_WRITE));
+    ASSERT_EQ(Os::File::NO_PERMISSION, file.open("/bin1/file0", Os::File::OPEN_CREATE, Os::File::OVERWRITE));
+    ASSERT_EQ(Os::File::NO_PERMISSION, file.open("/bin1/file1", Os::File::OPEN_APPEND));
+    ASSERT_EQ(Os::FileSystem::NO_PERMISSION, Os::FileSystem::removeFile("/bin1/file0"));
+    ASSERT_EQ(Os::FileSystem::NO_PERMISSION, Os::FileSystem::moveFile("/bin1/file0", "/bin0/file0"));
+
+    // They can be copied to RAM
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::copyFile("/bin1/file1", "/bin0/file1"));
+    FwSizeType fileSize = 0;
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::getFileSize("/bin0/file1", fileSize));
+    ASSERT_EQ(sizeof(romFile1), fileSize);
+
+    // They use no RAM file space
+    FwSizeType totalBytes = 0;
+    FwSizeType freeBytes = 0;
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::getFreeSpace("/", totalBytes, freeBytes));
+    ASSERT_EQ(2 * FILE_SIZE, totalBytes);
+    ASSERT_EQ(FILE_SIZE, freeBytes);
+
+    Os::Baremetal::MicroFs::MicroFsCleanup(0, this->alloc);
+}
+
+// ----------------------------------------------------------------------
+// NameTableTest
+// ----------------------------------------------------------------------
+
+void Tester ::NameTableTest() {
+    const U16 NumberBins = 2;
+    const U16 NumberFiles = 3;
+
+    InitFileSystem initFileSystem(NumberBins, FILE_SIZE, NumberFiles);
+    Cleanup cleanup;
+    initFileSystem.apply(*this);
+
+    Os::Baremetal::MicroFsNameTableStorage<8> nameTable;
+    Os::File file;
+    BYTE data[] = {1, 2, 3, 4};
+    BYTE buffer[sizeof(data)];
+    FwSizeType size = sizeof(data);
+
+    // Names can't be used without a name table
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/params/gains.dat", Os::File::OPEN_CREATE));
+
+    Os::Baremetal::MicroFs::MicroFsSetNameTable(&nameTable, 1);
+
+    // Unknown names don't exist for reading
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/params/gains.dat", Os::File::OPEN_READ));
+
+    // Creating a name takes the first free file of the bin, skipping files in use through their bin path
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file0", Os::File::OPEN_CREATE));
+    file.close();
+    ASSERT_EQ(Os::File::OP_OK, file.open("/params/gains.dat", Os::File::OPEN_CREATE));
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+    file.close();
+    FwIndexType index = 0;
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::getFileStateIndex("/params/gains.dat", index));
+    ASSERT_EQ(NumberFiles + 1, index);
+
+    // The file is the same through its name and its bin path
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file1", Os::File::OPEN_READ));
+    size = sizeof(buffer);
+    ASSERT_EQ(Os::File::OP_OK, file.read(buffer, size));
+    ASSERT_EQ(sizeof(data), size);
+    ASSERT_EQ(0, memcmp(data, buffer, size));
+    file.close();
+
+    // Bin paths still resolve
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::getFileStateIndex("/bin0/file2", index));
+    ASSERT_EQ(2, index);
+
+    // Names fail when the bin is full or the name is too long
+    ASSERT_EQ(Os::File::OP_OK, file.open("/log", Os::File::OPEN_WRITE));
+    file.close();
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/full", Os::File::OPEN_WRITE));
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/log"));
+    char longName[Os::MICROFS_MAX_NAME_LENGTH + 1];
+    memset(longName, 'a', sizeof(longName) - 1);
+    longName[0] = '/';
+    longName[sizeof(longName) - 1] = 0;
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open(longName, Os::File::OPEN_WRITE));
+
+    // Bin paths out of range or with an extension never get a name, however often they are opened
+    for (U32 attempt = 0; attempt < 2; attempt++) {
+        ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/bin9/file0", Os::File::OPEN_WRITE));
+        ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/bin0/file0.crc", Os::File::OPEN_WRITE));
+    }
+
+    // Removing a file releases its name
+    ASSERT_EQ(1, nameTable.getCount());
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/bin1/file1"));
+    ASSERT_EQ(0, nameTable.getCount());
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/params/gains.dat", Os::File::OPEN_READ));
+
+    // Renaming gives a new name to the data
+    ASSERT_EQ(Os::File::OP_OK, file.open("/a", Os::File::OPEN_WRITE));
+    size = sizeof(data);
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+    file.close();
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::moveFile("/a", "/b"));
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/a", Os::File::OPEN_READ));
+    ASSERT_EQ(Os::File::OP_OK, file.open("/b", Os::File::OPEN_READ));
+    size = sizeof(buffer);
+    ASSERT_EQ(Os::File::OP_OK, file.read(buffer, size));
+    ASSERT_EQ(sizeof(data), size);
+    file.close();
+
+    // Removing a name shifts back the names that probed past it, and their files still release the right names.
+    // "/n0" and "/z" both hash to the first of 4 entries and "/y" to the second, so removing "/n0" moves both
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/b"));
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/bin1/file0"));
+    Os::Baremetal::MicroFsNameTableStorage<4> smallTable;
+    Os::Baremetal::MicroFs::MicroFsSetNameTable(&smallTable, 1);
+    for (const char* name : {"/n0", "/z", "/y"}) {
+        ASSERT_EQ(Os::File::OP_OK, file.open(name, Os::File::OPEN_CREATE));
+        file.close();
+    }
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/n0"));
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/z"));
+    ASSERT_EQ(1, smallTable.getCount());
+    ASSERT_EQ(Os::File::OP_OK, file.open("/y", Os::File::OPEN_READ));
+    file.close();
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/z", Os::File::OPEN_READ));
+
+    cleanup.apply(*this);
+}
+
+// ----------------------------------------------------------------------
+// EvictionTest
+// ----------------------------------------------------------------------
+
+void Tester ::writeFile(const char* fileName, Os::File::Mode mode) {
+    Os::File file;
+    BYTE data[] = {1, 2, 3};
+    FwSizeType size = sizeof(data);
+    ASSERT_EQ(Os::File::OP_OK, file.open(fileName, mode));
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+    file.close();
+}
+
+void Tester ::waitForClockTick() {
+    // make sure the next change gets a later time
+    Os::RawTime start;
+    Os::RawTime now;
+    Fw::TimeInterval interval;
+    ASSERT_EQ(Os::RawTime::OP_OK, start.now());
+    do {
+        ASSERT_EQ(Os::RawTime::OP_OK, now.now());
+        ASSERT_EQ(Os::RawTime::OP_OK, now.getTimeInterval(start, interval));
+    } while ((interval.getSeconds() == 0) and (interval.getUSeconds() == 0));
+}
+
+void Tester ::EvictionTest() {
+    const U16 NumberFiles = 3;
+    char path[20];
+    U64 createTime = 0;
+    U64 modifyTime = 0;
+    U64 lastModifyTime = 0;
+
+    Os::Baremetal::MicroFs::MicroFsSetCfgBins(this->testCfg, 3);
+    Os::Baremetal::MicroFs::MicroFsAddBin(this->testCfg, 0, FILE_SIZE, NumberFiles);
+    Os::Baremetal::MicroFs::MicroFsAddBin(this->testCfg, 1, FILE_SIZE, NumberFiles);
+    Os::Baremetal::MicroFs::MicroFsAddBin(this->testCfg, 2, FILE_SIZE, NumberFiles);
+    Os::Baremetal::MicroFs::MicroFsSetBinEviction(this->testCfg, 1, Os::Baremetal::MicroFs::EVICT_LRU);
+    Os::Baremetal::MicroFs::MicroFsSetBinEviction(this->testCfg, 2, Os::Baremetal::MicroFs::EVICT_LRU_DOWNLINKED);
+    Os::Baremetal::MicroFs::MicroFsInit(this->testCfg, 0, this->alloc);
+
+    // Times are recorded on creation and modification
+    ASSERT_EQ(Os::Baremetal::MicroFs::INVALID,
+              Os::Baremetal::MicroFs::MicroFsGetFileTimes("/bin0/file0", createTime, modifyTime));
+    this->writeFile("/bin0/file0", Os::File::OPEN_CREATE);
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID,
+              Os::Baremetal::MicroFs::MicroFsGetFileTimes("/bin0/file0", createTime, lastModifyTime));
+    ASSERT_LE(createTime, lastModifyTime);
+    this->waitForClockTick();
+    this->writeFile("/bin0/file0", Os::File::OPEN_APPEND);
+    U64 appendCreateTime = 0;
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID,
+              Os::Baremetal::MicroFs::MicroFsGetFileTimes("/bin0/file0", appendCreateTime, modifyTime));
+    ASSERT_EQ(createTime, appendCreateTime);
+    ASSERT_GT(modifyTime, lastModifyTime);
+
+    // Free files are handed out first, and full bins without a policy have no free file
+    for (U16 file = 0; file < NumberFiles; file++) {
+        for (FwIndexType bin = 1; bin < 3; bin++) {
+            ASSERT_EQ(Os::Baremetal::MicroFs::VALID,
+                      Os::Baremetal::MicroFs::MicroFsGetFreeFile(bin, path, sizeof(path)));
+            this->writeFile(path, Os::File::OPEN_CREATE);
+        }
+        this->waitForClockTick();
+    }
+    for (U16 file = 1; file < NumberFiles; file++) {
+        ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::MicroFsGetFreeFile(0, path, sizeof(path)));
+        this->writeFile(path, Os::File::OPEN_CREATE);
+    }
+    ASSERT_EQ(Os::Baremetal::MicroFs::INVALID, Os::Baremetal::MicroFs::MicroFsGetFreeFile(0, path, sizeof(path)));
+
+    // LRU reclaims the least recently modified closed file
+    this->writeFile("/bin1/file0", Os::File::OPEN_APPEND);
+    Os::File openFile;
+    ASSERT_EQ(Os::File::OP_OK, openFile.open("/bin1/file1", Os::File::OPEN_READ));
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::MicroFsGetFreeFile(1, path, sizeof(path)));
+    ASSERT_STREQ("/bin1/file2", path);
+    openFile.close();
+    Os::File file;
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open("/bin1/file2", Os::File::OPEN_READ));
+
+    // LRU_DOWNLINKED only reclaims downlinked files, until they change again
+    ASSERT_EQ(Os::Baremetal::MicroFs::INVALID, Os::Baremetal::MicroFs::MicroFsGetFreeFile(2, path, sizeof(path)));
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::MicroFsSetDownlinked("/bin2/file1"));
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::MicroFsSetDownlinked("/bin2/file2"));
+    this->writeFile("/bin2/file1", Os::File::OPEN_APPEND);
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::MicroFsGetFreeFile(2, path, sizeof(path)));
+    ASSERT_STREQ("/bin2/file2", path);
+
+    // A name that can't be added doesn't evict a file for nothing
+    this->writeFile("/bin1/file2", Os::File::OPEN_CREATE);
+    Os::Baremetal::MicroFsNameTableStorage<4> nameTable;
+    Os::Baremetal::MicroFs::MicroFsSetNameTable(&nameTable, 1);
+    char longName[Os::MICROFS_MAX_NAME_LENGTH + 1];
+    memset(longName, 'a', sizeof(longName) - 1);
+    longName[0] = '/';
+    longName[sizeof(longName) - 1] = 0;
+    ASSERT_EQ(Os::File::DOESNT_EXIST, file.open(longName, Os::File::OPEN_WRITE));
+    for (U16 index = 0; index < NumberFiles; index++) {
+        (void)snprintf(path, sizeof(path), "/bin1/file%u", index);
+        ASSERT_EQ(Os::File::OP_OK, file.open(path, Os::File::OPEN_READ));
+        file.close();
+    }
+    ASSERT_EQ(Os::File::OP_OK, file.open("/named", Os::File::OPEN_WRITE));
+    file.close();
+    ASSERT_EQ(1, nameTable.getCount());
+
+    Os::Baremetal::MicroFs::MicroFsCleanup(0, this->alloc);
+}
+
+// ----------------------------------------------------------------------
+// HotColdTest
+// ----------------------------------------------------------------------
+
+void Tester ::HotColdTest() {
+    const FwSizeType NumFiles = 500;
+    const FwSizeType SmallSize = 64;
+
+    Os::Baremetal::MicroFs::MicroFsSetCfgBins(this->testCfg, 2);
+    Os::Baremetal::MicroFs::MicroFsAddBin(this->testCfg, 0, FILE_SIZE, NumFiles);
+    Os::Baremetal::MicroFs::MicroFsAddBin(this->testCfg, 1, SmallSize, NumFiles);
+    Os::Baremetal::MicroFs::MicroFsInit(this->testCfg, 0, this->alloc);
+
+    // The sizes and existence flags are dense arrays between the file states and the file data
+    Os::Baremetal::MicroFs& microfs = Os::Baremetal::MicroFs::getSingleton();
+    const BYTE* states = static_cast<const BYTE*>(microfs.s_microFsMem);
+    const BYTE* hot = reinterpret_cast<const BYTE*>(microfs.s_currSize);
+    ASSERT_EQ(states + (2 * NumFiles * sizeof(Os::Baremetal::MicroFs::MicroFsFileState)), hot);
+    ASSERT_EQ(reinterpret_cast<const BYTE*>(&microfs.s_currSize[2 * NumFiles]),
+              reinterpret_cast<const BYTE*>(microfs.s_created));
+    ASSERT_EQ(hot + Os::Baremetal::MicroFs::getHotSize(2 * NumFiles),
+              Os::Baremetal::MicroFs::getFileStateFromIndex(0)->data);
+
+    // Create every other file of the first bin
+    Os::File file;
+    BYTE data[10] = {};
+    char path[20];
+    for (FwSizeType f = 0; f < NumFiles; f += 2) {
+        (void)snprintf(path, sizeof(path), "/bin0/file%d", static_cast<int>(f));
+        FwSizeType size = sizeof(data);
+        ASSERT_EQ(Os::File::OP_OK, file.open(path, Os::File::OPEN_CREATE));
+        ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+        file.close();
+        FwIndexType index = 0;
+        ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::getFileStateIndex(path, index));
+        ASSERT_TRUE(Os::Baremetal::MicroFs::isFileCreated(index));
+        ASSERT_EQ(sizeof(data), Os::Baremetal::MicroFs::getFileSize(index));
+    }
+
+    // The whole-volume scans only read the dense arrays
+    FwSizeType totalBytes = 0;
+    FwSizeType freeBytes = 0;
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::getFreeSpace("/", totalBytes, freeBytes));
+    ASSERT_EQ((NumFiles * FILE_SIZE) + (NumFiles * SmallSize), totalBytes);
+    ASSERT_EQ(((NumFiles / 2) * FILE_SIZE) + (NumFiles * SmallSize), freeBytes);
+
+    FwSizeType found = 0;
+    for (FwSizeType slot = 0; slot < 2 * NumFiles; slot++) {
+        found += Os::Baremetal::MicroFs::isFileCreated(static_cast<FwIndexType>(slot)) ? 1 : 0;
+    }
+    ASSERT_EQ(NumFiles / 2, found);
+
+    // Removing a file only clears its flag
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/bin0/file0"));
+    ASSERT_FALSE(Os::Baremetal::MicroFs::isFileCreated(0));
+
+    Os::Baremetal::MicroFs::MicroFsCleanup(0, this->alloc);
+}
+
+// ----------------------------------------------------------------------
+// FtlTest
+// ----------------------------------------------------------------------
+
+void Tester ::FtlTest() {
+    const FwSizeType PageSize = 64;
+    const FwSizeType PagesPerBlock = 8;
+    const FwSizeType NumBlocks = 16;
+    const U32 HotPages = 8;
+    const U32 Rewrites = 4000;
+
+    Os::Baremetal::MicroFsSimFlash::Config flashCfg = {{PageSize, PagesPerBlock, NumBlocks}, 25, 200, 2000, 100000};
+    Os::Baremetal::MicroFsSimFlash flash(flashCfg, 0, this->alloc);
+    Os::Baremetal::MicroFsFtlStorage<NumBlocks, PagesPerBlock, PageSize> ftl(flash);
+    const U32 logicalPages = static_cast<U32>(ftl.getLogicalPages());
+    ASSERT_EQ((NumBlocks - Os::MICROFS_FTL_RESERVED_BLOCKS) * PagesPerBlock, logicalPages);
+
+    // Pages never written read as zeros
+    U8 page[PageSize];
+    U8 expected[PageSize];
+    ASSERT_EQ(Os::Baremetal::MicroFsFtl::OP_OK, ftl.readPage(0, page));
+    (void)memset(expected, 0, sizeof(expected));
+    ASSERT_EQ(0, memcmp(expected, page, sizeof(page)));
+
+    // Fill the whole capacity with cold data, then keep rewriting a few hot pages. Every page
+    // holds its number and the generation it was written in
+    U32 generation[FwSizeType(NumBlocks) * PagesPerBlock] = {};
+    for (U32 lpn = 0; lpn < logicalPages; lpn++) {
+        (void)memset(page, static_cast<int>(lpn), sizeof(page));
+        ASSERT_EQ(Os::Baremetal::MicroFsFtl::OP_OK, ftl.writePage(lpn, page));
+    }
+    for (U32 write = 0; write < Rewrites; write++) {
+        const U32 lpn = write % HotPages;
+        generation[lpn]++;
+        (void)memset(page, static_cast<int>(lpn), sizeof(page));
+        (void)memcpy(page, &generation[lpn], sizeof(generation[lpn]));
+        ASSERT_EQ(Os::Baremetal::MicroFsFtl::OP_OK, ftl.writePage(lpn, page));
+    }
+
+    // Garbage collection and wear leveling kept every page intact, and never broke the flash rules
+    for (U32 lpn = 0; lpn < logicalPages; lpn++) {
+        (void)memset(expected, static_cast<int>(lpn), sizeof(expected));
+        if (generation[lpn] > 0) {
+            (void)memcpy(expected, &generation[lpn], sizeof(generation[lpn]));
+        }
+        ASSERT_EQ(Os::Baremetal::MicroFsFtl::OP_OK, ftl.readPage(lpn, page));
+        ASSERT_EQ(0, memcmp(expected, page, sizeof(page))) << "page " << lpn;
+    }
+    ASSERT_EQ(0, flash.getViolations());
+
+    // The cold blocks were moved so all blocks wear at about the same rate
+    Os::Baremetal::MicroFsFtl::Stats stats;
+    ftl.getStats(stats);
+    ASSERT_EQ(logicalPages + Rewrites, stats.hostWrites);
+    ASSERT_EQ(flash.getPrograms(), stats.flashWrites);
+    ASSERT_EQ(0, stats.badBlocks);
+    ASSERT_LE(stats.maxEraseCount - stats.minEraseCount, Os::MICROFS_FTL_WEAR_THRESHOLD + 2);
+    for (FwSizeType block = 0; block < NumBlocks; block++) {
+        ASSERT_EQ(flash.getEraseCount(block), ftl.getEraseCount(block));
+    }
+
+    // Trimmed pages read as zeros again
+    ftl.trimPage(HotPages);
+    ASSERT_EQ(Os::Baremetal::MicroFsFtl::OP_OK, ftl.readPage(HotPages, page));
+    (void)memset(expected, 0, sizeof(expected));
+    ASSERT_EQ(0, memcmp(expected, page, sizeof(page)));
+}
+
+// ----------------------------------------------------------------------
+// DeviceBinTest
+// ----------------------------------------------------------------------
+
+void Tester ::DeviceBinTest() {
+    const FwSizeType PageSize = 64;
+    const FwSizeType PagesPerBlock = 8;
+    const FwSizeType NumBlocks = 16;
+    const FwSizeType DeviceFileSize = 1000;
+    const FwSizeType DeviceFiles = 4;
+
+    Os::Baremetal::MicroFsSimFlash::Config flashCfg = {{PageSize, PagesPerBlock, NumBlocks}, 25, 200, 2000, 100000};
+    Os::Baremetal::MicroFsSimFlash flash(flashCfg, 0, this->alloc);
+    Os::Baremetal::MicroFsFtlStorage<NumBlocks, PagesPerBlock, PageSize> ftl(flash);
+    Os::Baremetal::MicroFsPageCacheStorage<4, PageSize> cache(ftl);
+
+    Os::Baremetal::MicroFs::MicroFsSetCfgBins(this->testCfg, 2);
+    Os::Baremetal::MicroFs::MicroFsAddBin(this->testCfg, 0, DeviceFileSize, 2);
+    Os::Baremetal::MicroFs::MicroFsAddDeviceBin(this->testCfg, 1, DeviceFileSize, DeviceFiles, cache);
+    Os::Baremetal::MicroFs::MicroFsInit(this->testCfg, 0, this->alloc);
+
+    // Device files use no file buffer in memory, but count in the free space
+    FwIndexType index = 0;
+    ASSERT_EQ(Os::Baremetal::MicroFs::VALID, Os::Baremetal::MicroFs::getFileStateIndex("/bin1/file2", index));
+    ASSERT_EQ(nullptr, Os::Baremetal::MicroFs::getFileStateFromIndex(index)->data);
+    FwSizeType totalBytes = 0;
+    FwSizeType freeBytes = 0;
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::getFreeSpace("/", totalBytes, freeBytes));
+    ASSERT_EQ((2 + DeviceFiles) * DeviceFileSize, totalBytes);
+    ASSERT_EQ(totalBytes, freeBytes);
+
+    // Small writes are gathered in the cache, so each page is programmed once
+    BYTE data[DeviceFileSize + 10];
+    for (FwSizeType i = 0; i < sizeof(data); i++) {
+        data[i] = static_cast<BYTE>(i * 7);
+    }
+    Os::File file;
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file1", Os::File::OPEN_CREATE));
+    for (FwSizeType offset = 0; offset < sizeof(data); offset += 10) {
+        FwSizeType size = 10;
+        ASSERT_EQ(Os::File::OP_OK, file.write(&data[offset], size));
+        ASSERT_EQ((offset < DeviceFileSize) ? 10 : 0, size);
+    }
+    ASSERT_EQ(Os::File::OP_OK, file.flush());
+    file.close();
+    Os::Baremetal::MicroFsFtl::Stats stats;
+    ftl.getStats(stats);
+    ASSERT_EQ((DeviceFileSize + PageSize - 1) / PageSize, stats.hostWrites);
+    ASSERT_EQ(0, flash.getViolations());
+
+    // Read back through the file system, and copy to a file in memory
+    BYTE buffer[DeviceFileSize];
+    FwSizeType size = sizeof(buffer);
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file1", Os::File::OPEN_READ));
+    ASSERT_EQ(Os::File::OP_OK, file.read(buffer, size));
+    ASSERT_EQ(DeviceFileSize, size);
+    ASSERT_EQ(0, memcmp(data, buffer, size));
+    file.close();
+
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::copyFile("/bin1/file1", "/bin0/file0"));
+    size = sizeof(buffer);
+    (void)memset(buffer, 0, sizeof(buffer));
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin0/file0", Os::File::OPEN_READ));
+    ASSERT_EQ(Os::File::OP_OK, file.read(buffer, size));
+    ASSERT_EQ(DeviceFileSize, size);
+    ASSERT_EQ(0, memcmp(data, buffer, size));
+    file.close();
+
+    // A seek past the end of a device file is zero filled by the next write
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file3", Os::File::OPEN_CREATE));
+    ASSERT_EQ(Os::File::OP_OK, file.seek(100, Os::File::SeekType::ABSOLUTE));
+    size = 1;
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+    file.close();
+    size = sizeof(buffer);
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file3", Os::File::OPEN_READ));
+    ASSERT_EQ(Os::File::OP_OK, file.read(buffer, size));
+    file.close();
+    ASSERT_EQ(101, size);
+    for (FwSizeType i = 0; i < 100; i++) {
+        ASSERT_EQ(0, buffer[i]);
+    }
+    ASSERT_EQ(data[0], buffer[100]);
+
+    // Removing a file releases its pages on the device
+    ASSERT_EQ(Os::FileSystem::OP_OK, Os::FileSystem::removeFile("/bin1/file1"));
+    ASSERT_EQ(Os::File::OP_OK, file.open("/bin1/file1", Os::File::OPEN_CREATE));
+    size = 10;
+    ASSERT_EQ(Os::File::OP_OK, file.write(data, size));
+    file.close();
+    const FwSizeType secondPage = (((DeviceFileSize + PageSize - 1) / PageSize) * PageSize) + PageSize;
+    ASSERT_EQ(Os::Baremetal::MicroFsFtl::OP_OK, cache.read(secondPage, buffer, PageSize));
+    for (FwSizeType i = 0; i < PageSize; i++) {
+        ASSERT_EQ(0, buffer[i]);
+    }
+
+    Os::Baremetal::MicroFs::MicroFsCleanup(0, this->alloc);
+}
+
 // ----------------------------------------------------------------------
 // CopyTest
 // ----------------------------------------------------------------------
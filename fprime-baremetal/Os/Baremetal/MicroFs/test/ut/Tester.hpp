@@ -84,11 +84,21 @@ class Tester {
     void AppendTest();
     void SimFileTest();
     void NewTest();
+    void SnapshotTest();
+    void StaticLayoutTest();
+    void RomBinTest();
+    void NameTableTest();
+    void EvictionTest();
+    void HotColdTest();
+    void FtlTest();
+    void DeviceBinTest();
 
     // Helper functions
     void clearFileBuffer();
     FileModel* getFileModel(const char* filename);
     void getFileNames(char fileNames[][20], U16 numBins, U16 numFiles);
+    void writeFile(const char* fileName, Os::File::Mode mode);
+    void waitForClockTick();
 
   private:
   private:
@@ -0,0 +1,124 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/MicroFs/tools/MicroFsUnpack.cpp
+// \brief host tool applying MicroFs snapshot images to a directory tree
+//
+// Usage: microfs-unpack <output directory> <image> [<image> ...]
+//
+// Images are applied in the order given, so a full snapshot followed by the incremental
+// snapshots taken after it reproduces the on-board file system as
+// `<output directory>/<bin prefix><bin>/<file prefix><file>`. See MicroFsSnapshot.hpp for the
+// image layout.
+// ======================================================================
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t MAGIC = 0x4D465353;
+constexpr std::uint8_t VERSION = 1;
+constexpr std::uint8_t FLAG_FULL = 0x01;
+constexpr std::uint8_t ENTRY_DELETED = 0x01;
+constexpr std::size_t HEADER_SIZE = 12;
+constexpr std::size_t ENTRY_HEADER_SIZE = 9;
+
+// Must match MICROFS_BIN_STRING and MICROFS_FILE_STRING in the flight configuration
+const char* const BIN_PREFIX = "bin";
+const char* const FILE_PREFIX = "file";
+
+std::uint16_t getU16(const std::uint8_t* source) {
+    return static_cast<std::uint16_t>((source[0] << 8) | source[1]);
+}
+
+std::uint32_t getU32(const std::uint8_t* source) {
+    return (static_cast<std::uint32_t>(source[0]) << 24) | (static_cast<std::uint32_t>(source[1]) << 16) |
+           (static_cast<std::uint32_t>(source[2]) << 8) | static_cast<std::uint32_t>(source[3]);
+}
+
+//! Apply one image to the output directory. Returns false on a malformed image.
+bool applyImage(const std::filesystem::path& root, const std::string& imagePath) {
+    std::ifstream input(imagePath, std::ios::binary);
+    if (not input) {
+        std::cerr << imagePath << ": cannot open" << std::endl;
+        return false;
+    }
+    std::vector<std::uint8_t> image((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    if (image.size() < HEADER_SIZE or getU32(&image[0]) != MAGIC) {
+        std::cerr << imagePath << ": not a MicroFs snapshot" << std::endl;
+        return false;
+    }
+    if (image[4] != VERSION) {
+        std::cerr << imagePath << ": unsupported version " << static_cast<unsigned>(image[4]) << std::endl;
+        return false;
+    }
+    const bool full = (image[5] & FLAG_FULL) != 0;
+    const std::uint16_t entries = getU16(&image[6]);
+    const std::uint32_t sequence = getU32(&image[8]);
+    std::cout << imagePath << ": " << (full ? "full" : "incremental") << " snapshot " << sequence << ", " << entries
+              << " entries" << std::endl;
+
+    // a full snapshot replaces everything previously unpacked
+    if (full) {
+        for (const auto& entry : std::filesystem::directory_iterator(root)) {
+            if (entry.is_directory() and entry.path().filename().string().rfind(BIN_PREFIX, 0) == 0) {
+                std::filesystem::remove_all(entry.path());
+            }
+        }
+    }
+
+    std::size_t offset = HEADER_SIZE;
+    for (std::uint16_t i = 0; i < entries; i++) {
+        if ((image.size() - offset) < ENTRY_HEADER_SIZE) {
+            std::cerr << imagePath << ": truncated entry header " << i << std::endl;
+            return false;
+        }
+        const std::uint16_t bin = getU16(&image[offset]);
+        const std::uint16_t file = getU16(&image[offset + 2]);
+        const std::uint8_t flags = image[offset + 4];
+        const std::uint32_t size = getU32(&image[offset + 5]);
+        offset += ENTRY_HEADER_SIZE;
+        if ((image.size() - offset) < size) {
+            std::cerr << imagePath << ": truncated data for entry " << i << std::endl;
+            return false;
+        }
+
+        const std::filesystem::path directory = root / (BIN_PREFIX + std::to_string(bin));
+        const std::filesystem::path target = directory / (FILE_PREFIX + std::to_string(file));
+        if ((flags & ENTRY_DELETED) != 0) {
+            std::filesystem::remove(target);
+            std::cout << "  removed " << target.string() << std::endl;
+        } else {
+            std::filesystem::create_directories(directory);
+            std::ofstream output(target, std::ios::binary | std::ios::trunc);
+            output.write(reinterpret_cast<const char*>(&image[offset]), size);
+            std::cout << "  wrote   " << target.string() << " (" << size << " bytes)" << std::endl;
+        }
+        offset += size;
+    }
+    if (offset != image.size()) {
+        std::cerr << imagePath << ": " << (image.size() - offset) << " trailing bytes ignored" << std::endl;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output directory> <image> [<image> ...]" << std::endl;
+        return 1;
+    }
+    const std::filesystem::path root(argv[1]);
+    std::filesystem::create_directories(root);
+    for (int i = 2; i < argc; i++) {
+        if (not applyImage(root, argv[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/Mutex.cpp
+// \brief implementation for Os::Baremetal::BaremetalMutex
+// ======================================================================
+#include <fprime-baremetal/Os/Baremetal/Mutex.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+#if BAREMETAL_MUTEX_MASKS_INTERRUPTS
+static BaremetalMutex::MaskInterrupts s_maskInterrupts = nullptr;        //!< masks interrupts, or nullptr
+static BaremetalMutex::RestoreInterrupts s_restoreInterrupts = nullptr;  //!< restores the interrupt mask, or nullptr
+#endif
+
+void BaremetalMutex::setInterruptMask(MaskInterrupts mask, RestoreInterrupts restore) {
+#if BAREMETAL_MUTEX_MASKS_INTERRUPTS
+    FW_ASSERT((mask == nullptr) == (restore == nullptr));
+    s_maskInterrupts = mask;
+    s_restoreInterrupts = restore;
+#else
+    (void)mask;
+    (void)restore;
+#endif
+}
+
+MutexHandle* BaremetalMutex::getHandle() {
+    return &this->m_handle;
+}
+
+MutexInterface::Status BaremetalMutex::take() {
+#if BAREMETAL_MUTEX_MASKS_INTERRUPTS
+    if (s_maskInterrupts != nullptr) {
+        this->m_handle.m_savedMask = s_maskInterrupts();
+    }
+#endif
+    return Status::OP_OK;
+}
+
+MutexInterface::Status BaremetalMutex::release() {
+#if BAREMETAL_MUTEX_MASKS_INTERRUPTS
+    if (s_restoreInterrupts != nullptr) {
+        s_restoreInterrupts(this->m_handle.m_savedMask);
+    }
+#endif
+    return Status::OP_OK;
+}
+
+}  // namespace Baremetal
+}  // namespace Os
@@ -0,0 +1,83 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/Mutex.hpp
+// \brief implementation for Os::Baremetal::BaremetalMutex, header definitions
+// ======================================================================
+#include <Os/Mutex.hpp>
+#include "config/MutexCfg.hpp"
+#ifndef OS_BAREMETAL_MUTEX_HPP
+#define OS_BAREMETAL_MUTEX_HPP
+
+namespace Os {
+namespace Baremetal {
+
+//! MutexHandle class definition for baremetal implementations.
+//!
+struct BaremetalMutexHandle : public MutexHandle {
+#if BAREMETAL_MUTEX_MASKS_INTERRUPTS
+    U32 m_savedMask = 0;  //!< interrupt mask state saved by take and restored by release
+#endif
+};
+
+//! \brief baremetal implementation of Os::MutexInterface
+//!
+//! Cooperative tasks run one unit of work at a time to completion, so no other task can run while one holds a mutex
+//! and taking or releasing one does nothing. Only interrupt handlers can preempt a task: when
+//! `BAREMETAL_MUTEX_MASKS_INTERRUPTS` is set in `config/MutexCfg.hpp`, taking a mutex masks interrupts through the
+//! functions given to `setInterruptMask` and releasing it restores the mask saved when it was taken, so mutexes nest.
+//!
+//! Must not be used with the `MultiTaskRunner`: its workers run units of work of different tasks in parallel, and
+//! a mutex that does nothing, or only masks the interrupts of one core, lets them race.
+//!
+class BaremetalMutex : public MutexInterface {
+  public:
+    //! \brief function masking interrupts and returning the previous mask state, such as PRIMASK
+    typedef U32 (*MaskInterrupts)();
+
+    //! \brief function restoring a mask state returned by MaskInterrupts
+    typedef void (*RestoreInterrupts)(U32 state);
+
+    //! \brief constructor
+    //!
+    BaremetalMutex() = default;
+
+    //! \brief copy constructor
+    BaremetalMutex(const BaremetalMutex& other) = delete;
+
+    //! \brief default copy assignment
+    MutexInterface& operator=(const MutexInterface& other) override = delete;
+
+    //! \brief destructor
+    //!
+    ~BaremetalMutex() override = default;
+
+    //! \brief set the platform functions masking and restoring interrupts
+    //!
+    //! Only used when `BAREMETAL_MUTEX_MASKS_INTERRUPTS` is set. Until they are set, mutexes mask nothing.
+    //!
+    //! \param mask: function masking interrupts, or nullptr
+    //! \param restore: function restoring the interrupt mask, or nullptr
+    static void setInterruptMask(MaskInterrupts mask, RestoreInterrupts restore);
+
+    // ------------------------------------
+    // Functions overrides
+    // ------------------------------------
+
+    //! \brief return the underlying mutex handle (implementation specific)
+    //! \return internal mutex handle representation
+    MutexHandle* getHandle() override;
+
+    //! \brief lock the mutex, masking interrupts when configured to
+    //! \return OP_OK
+    Status take() override;
+
+    //! \brief unlock the mutex, restoring the interrupt mask when configured to
+    //! \return OP_OK
+    Status release() override;
+
+  private:
+    //! Internal handle
+    BaremetalMutexHandle m_handle;
+};
+}  // namespace Baremetal
+}  // namespace Os
+#endif  // OS_BAREMETAL_MUTEX_HPP
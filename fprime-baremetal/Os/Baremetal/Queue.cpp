@@ -0,0 +1,242 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/Queue.cpp
+// \brief implementation for Os::Baremetal::BaremetalQueue
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/Queue.hpp>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace Os {
+namespace Baremetal {
+
+// ----------------------------------------------------------------------
+// MessageRing
+// ----------------------------------------------------------------------
+
+MessageRing::~MessageRing() {
+    delete[] this->m_data;
+    delete[] this->m_info;
+    delete[] this->m_order;
+    delete[] this->m_free;
+}
+
+bool MessageRing::create(FwSizeType depth, FwSizeType messageSize) {
+    FW_ASSERT(not this->isCreated());
+    FW_ASSERT(depth > 0);
+    FW_ASSERT(messageSize <= (std::numeric_limits<FwSizeType>::max() / depth), static_cast<FwAssertArgType>(depth),
+              static_cast<FwAssertArgType>(messageSize));
+    this->m_data = new (std::nothrow) U8[depth * messageSize];
+    this->m_info = new (std::nothrow) SlotInfo[depth];
+    this->m_order = new (std::nothrow) FwSizeType[depth];
+    this->m_free = new (std::nothrow) FwSizeType[depth];
+    if ((this->m_data == nullptr) or (this->m_info == nullptr) or (this->m_order == nullptr) or
+        (this->m_free == nullptr)) {
+        delete[] this->m_data;
+        delete[] this->m_info;
+        delete[] this->m_order;
+        delete[] this->m_free;
+        this->m_data = nullptr;
+        this->m_info = nullptr;
+        this->m_order = nullptr;
+        this->m_free = nullptr;
+        return false;
+    }
+    this->m_depth = depth;
+    this->m_messageSize = messageSize;
+    // Lowest slots on top, so a lightly used queue keeps to the start of its storage
+    for (FwSizeType i = 0; i < depth; i++) {
+        this->m_free[i] = depth - 1 - i;
+    }
+    this->m_freeCount = depth;
+    return true;
+}
+
+bool MessageRing::isCreated() const {
+    return this->m_data != nullptr;
+}
+
+bool MessageRing::send(const U8* buffer, FwSizeType size, FwQueuePriorityType priority) {
+    FW_ASSERT(this->isCreated());
+    FW_ASSERT((buffer != nullptr) or (size == 0));
+    FW_ASSERT(size <= this->m_messageSize, static_cast<FwAssertArgType>(size));
+    // A reserved slot stays on top of the free stack, so take the one below it
+    const FwSizeType reserved = this->m_reserved ? 1 : 0;
+    if (this->m_freeCount == reserved) {
+        return false;
+    }
+    const FwSizeType slot = this->m_free[this->m_freeCount - 1 - reserved];
+    if (this->m_reserved) {
+        this->m_free[this->m_freeCount - 2] = this->m_free[this->m_freeCount - 1];
+    }
+    this->m_freeCount--;
+    if (size > 0) {
+        (void)std::memcpy(&this->m_data[slot * this->m_messageSize], buffer, static_cast<size_t>(size));
+    }
+    this->insert(slot, size, priority);
+    return true;
+}
+
+bool MessageRing::receive(U8* destination, FwSizeType& size, FwQueuePriorityType& priority) {
+    const U8* message = this->peek(size, priority);
+    if (message == nullptr) {
+        return false;
+    }
+    if (size > 0) {
+        FW_ASSERT(destination != nullptr);
+        (void)std::memcpy(destination, message, static_cast<size_t>(size));
+    }
+    this->release();
+    return true;
+}
+
+U8* MessageRing::reserve(FwSizeType& capacity) {
+    FW_ASSERT(this->isCreated());
+    if (this->m_reserved or (this->m_freeCount == 0)) {
+        return nullptr;
+    }
+    this->m_reserved = true;
+    capacity = this->m_messageSize;
+    return &this->m_data[this->m_free[this->m_freeCount - 1] * this->m_messageSize];
+}
+
+void MessageRing::commit(FwSizeType size, FwQueuePriorityType priority) {
+    FW_ASSERT(this->m_reserved);
+    FW_ASSERT(size <= this->m_messageSize, static_cast<FwAssertArgType>(size));
+    this->m_reserved = false;
+    this->m_freeCount--;
+    this->insert(this->m_free[this->m_freeCount], size, priority);
+}
+
+const U8* MessageRing::peek(FwSizeType& size, FwQueuePriorityType& priority) const {
+    if (this->m_count == 0) {
+        return nullptr;
+    }
+    const FwSizeType slot = this->m_order[this->m_head];
+    size = this->m_info[slot].size;
+    priority = this->m_info[slot].priority;
+    return &this->m_data[slot * this->m_messageSize];
+}
+
+void MessageRing::release() {
+    FW_ASSERT(this->m_count > 0);
+    const FwSizeType slot = this->m_order[this->m_head];
+    this->m_head = this->getOrderIndex(1);
+    this->m_count--;
+    // A reserved slot must stay on top of the free stack
+    if (this->m_reserved) {
+        this->m_free[this->m_freeCount] = this->m_free[this->m_freeCount - 1];
+        this->m_free[this->m_freeCount - 1] = slot;
+    } else {
+        this->m_free[this->m_freeCount] = slot;
+    }
+    this->m_freeCount++;
+}
+
+FwSizeType MessageRing::getMessageSize() const {
+    return this->m_messageSize;
+}
+
+FwSizeType MessageRing::getCount() const {
+    return this->m_count;
+}
+
+FwSizeType MessageRing::getHighWaterMark() const {
+    return this->m_highWaterMark;
+}
+
+TaskWaker& MessageRing::getWaker() {
+    return this->m_waker;
+}
+
+void MessageRing::insert(FwSizeType slot, FwSizeType size, FwQueuePriorityType priority) {
+    this->m_info[slot].size = size;
+    this->m_info[slot].priority = priority;
+    // Move lower-priority messages back by one, starting from the last
+    FwSizeType position = this->m_count;
+    while (position > 0) {
+        const FwSizeType previous = this->m_order[this->getOrderIndex(position - 1)];
+        if (this->m_info[previous].priority >= priority) {
+            break;
+        }
+        this->m_order[this->getOrderIndex(position)] = previous;
+        position--;
+    }
+    this->m_order[this->getOrderIndex(position)] = slot;
+    this->m_count++;
+    if (this->m_count > this->m_highWaterMark) {
+        this->m_highWaterMark = this->m_count;
+    }
+    this->m_waker.notify();
+}
+
+FwSizeType MessageRing::getOrderIndex(FwSizeType offset) const {
+    // Both are below the depth, so one subtraction wraps the sum
+    const FwSizeType index = this->m_head + offset;
+    return (index >= this->m_depth) ? (index - this->m_depth) : index;
+}
+
+// ----------------------------------------------------------------------
+// BaremetalQueue
+// ----------------------------------------------------------------------
+
+QueueInterface::Status BaremetalQueue::create(FwEnumStoreType id,
+                                              const Fw::ConstStringBase& name,
+                                              FwSizeType depth,
+                                              FwSizeType messageSize) {
+    (void)id;
+    (void)name;
+    if (this->m_handle.m_ring.isCreated()) {
+        return Status::ALREADY_CREATED;
+    }
+    return this->m_handle.m_ring.create(depth, messageSize) ? Status::OP_OK : Status::ALLOCATION_FAILED;
+}
+
+QueueInterface::Status BaremetalQueue::send(const U8* buffer,
+                                            FwSizeType size,
+                                            FwQueuePriorityType priority,
+                                            BlockingType blockType) {
+    (void)blockType;
+    if (size > this->m_handle.m_ring.getMessageSize()) {
+        return Status::SIZE_MISMATCH;
+    }
+    return this->m_handle.m_ring.send(buffer, size, priority) ? Status::OP_OK : Status::FULL;
+}
+
+QueueInterface::Status BaremetalQueue::receive(U8* destination,
+                                               FwSizeType capacity,
+                                               BlockingType blockType,
+                                               FwSizeType& actualSize,
+                                               FwQueuePriorityType& priority) {
+    MessageRing& ring = this->m_handle.m_ring;
+    if (blockType == BlockingType::BLOCKING) {
+        ring.getWaker().bindCurrent(static_cast<U32>(ring.getCount()));
+    }
+    FwSizeType size = 0;
+    FwQueuePriorityType messagePriority = 0;
+    if (ring.peek(size, messagePriority) == nullptr) {
+        return Status::EMPTY;
+    }
+    // The message stays queued when it does not fit
+    if (size > capacity) {
+        return Status::SIZE_MISMATCH;
+    }
+    (void)ring.receive(destination, actualSize, priority);
+    return Status::OP_OK;
+}
+
+FwSizeType BaremetalQueue::getMessagesAvailable() const {
+    return this->m_handle.m_ring.getCount();
+}
+
+FwSizeType BaremetalQueue::getMessageHighWaterMark() const {
+    return this->m_handle.m_ring.getHighWaterMark();
+}
+
+QueueHandle* BaremetalQueue::getHandle() {
+    return &this->m_handle;
+}
+
+}  // namespace Baremetal
+}  // namespace Os
@@ -0,0 +1,203 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/Queue.hpp
+// \brief implementation for Os::Baremetal::BaremetalQueue, header definitions
+// ======================================================================
+#include <Os/Queue.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+#ifndef OS_BAREMETAL_QUEUE_HPP
+#define OS_BAREMETAL_QUEUE_HPP
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief fixed-capacity priority queue of messages for a single cooperative core
+//!
+//! Messages are kept in fixed-size slots. A ring of slot indices orders them highest priority first and in order of
+//! sending within a priority, so receiving takes the head of the ring and sending only moves the indices of
+//! lower-priority messages, none when all messages share a priority. Nothing is locked: the queue must only be used
+//! from tasks of the cooperative `TaskRunner`, never from interrupt handlers (see `Os_Baremetal_DeferredWork`).
+//!
+//! A sender that builds its message itself can serialize it straight into a slot with `reserve` and `commit`, and a
+//! receiver can read it in place with `peek` and `release`, saving the copies of `send` and `receive`.
+class MessageRing {
+  public:
+    MessageRing() = default;
+
+    //! \brief release the slots
+    ~MessageRing();
+
+    //! \brief allocate depth slots of messageSize bytes
+    //!
+    //! \return false if the allocation failed
+    bool create(FwSizeType depth, FwSizeType messageSize);
+
+    //! \brief check whether the slots were allocated
+    bool isCreated() const;
+
+    //! \brief copy a message into a slot
+    //!
+    //! \return false if every slot is in use
+    bool send(const U8* buffer, FwSizeType size, FwQueuePriorityType priority);
+
+    //! \brief copy the first message out of its slot and free the slot
+    //!
+    //! \return false if no message is waiting
+    bool receive(U8* destination, FwSizeType& size, FwQueuePriorityType& priority);
+
+    //! \brief get a free slot to serialize a message into, before `commit`
+    //!
+    //! \param capacity: (output) size of the slot
+    //! \return slot, or nullptr if every slot is in use or a slot is already reserved
+    U8* reserve(FwSizeType& capacity);
+
+    //! \brief queue the message serialized into the reserved slot
+    void commit(FwSizeType size, FwQueuePriorityType priority);
+
+    //! \brief get the first message without taking it, to be freed with `release`
+    //!
+    //! \param size: (output) size of the message
+    //! \param priority: (output) priority of the message
+    //! \return message, or nullptr if no message is waiting
+    const U8* peek(FwSizeType& size, FwQueuePriorityType& priority) const;
+
+    //! \brief take the first message, freeing its slot
+    void release();
+
+    //! \brief get the size of a slot
+    FwSizeType getMessageSize() const;
+
+    //! \brief get the number of waiting messages
+    FwSizeType getCount() const;
+
+    //! \brief get the largest number of messages waiting at once
+    FwSizeType getHighWaterMark() const;
+
+    //! \brief get the waker of the task receiving from the ring, notified of each message
+    TaskWaker& getWaker();
+
+  private:
+    //! \brief place a filled slot in the order ring, behind the messages of the same or a higher priority
+    void insert(FwSizeType slot, FwSizeType size, FwQueuePriorityType priority);
+
+    //! \brief get the index of the order ring that is a number of entries past the head
+    FwSizeType getOrderIndex(FwSizeType offset) const;
+
+    //! \brief size and priority of the message in a slot
+    struct SlotInfo {
+        FwSizeType size;               //!< size of the message
+        FwQueuePriorityType priority;  //!< priority of the message
+    };
+
+    U8* m_data = nullptr;            //!< depth slots of m_messageSize bytes
+    SlotInfo* m_info = nullptr;      //!< message held by each slot
+    FwSizeType* m_order = nullptr;   //!< ring of the slots holding messages, in order of receiving
+    FwSizeType* m_free = nullptr;    //!< stack of the free slots
+    FwSizeType m_depth = 0;          //!< number of slots
+    FwSizeType m_messageSize = 0;    //!< size of a slot
+    FwSizeType m_head = 0;           //!< index of the first message in the order ring
+    FwSizeType m_count = 0;          //!< messages in the order ring
+    FwSizeType m_freeCount = 0;      //!< slots in the free stack
+    FwSizeType m_highWaterMark = 0;  //!< largest message count
+    bool m_reserved = false;         //!< the top of the free stack is reserved by a sender
+    TaskWaker m_waker;               //!< task receiving from the ring
+};
+
+//! QueueHandle class definition for baremetal implementations.
+//!
+struct BaremetalQueueHandle : public QueueHandle {
+    MessageRing m_ring;  //!< messages of the queue
+};
+
+//! \brief baremetal implementation of Os::QueueInterface
+//!
+//! Implementation of `QueueInterface` over a `MessageRing`, without the mutex and condition variable of the generic
+//! priority queue. A cooperative task cannot wait, so `BLOCKING` sends and receives behave as `NONBLOCKING` ones and
+//! return `FULL` or `EMPTY`. A `BLOCKING` receive is what an active component does from its own task, so its first
+//! call binds the task to the queue through a `TaskWaker`: from then on the task only runs once per sent message, and
+//! `TaskRunner::setDrain` lets it dispatch several messages per slice.
+//!
+//! Must not be used with the `MultiTaskRunner`, whose workers would send and receive in parallel without a lock.
+//!
+class BaremetalQueue : public QueueInterface {
+  public:
+    //! \brief constructor
+    //!
+    BaremetalQueue() = default;
+
+    //! \brief copy constructor
+    BaremetalQueue(const BaremetalQueue& other) = delete;
+
+    //! \brief default copy assignment
+    QueueInterface& operator=(const QueueInterface& other) override = delete;
+
+    //! \brief destructor
+    //!
+    ~BaremetalQueue() override = default;
+
+    // ------------------------------------
+    // Functions overrides
+    // ------------------------------------
+
+    //! \brief create queue storage
+    //!
+    //! Allocates depth slots of messageSize bytes from the heap.
+    //!
+    //! \param id: id of the queue
+    //! \param name: name of the queue
+    //! \param depth: maximum number of messages
+    //! \param messageSize: maximum size of a message
+    //! \return ALREADY_CREATED if created before, ALLOCATION_FAILED if the slots could not be allocated, OP_OK
+    //! otherwise
+    Status create(FwEnumStoreType id,
+                  const Fw::ConstStringBase& name,
+                  FwSizeType depth,
+                  FwSizeType messageSize) override;
+
+    //! \brief send a message into the queue
+    //!
+    //! \param buffer: message data
+    //! \param size: size of the message data
+    //! \param priority: priority of the message, higher priorities are received first
+    //! \param blockType: ignored, the queue never blocks
+    //! \return SIZE_MISMATCH if the message does not fit a slot, FULL if the queue is full, OP_OK otherwise
+    Status send(const U8* buffer, FwSizeType size, FwQueuePriorityType priority, BlockingType blockType) override;
+
+    //! \brief receive a message from the queue
+    //!
+    //! \param destination: buffer receiving the message data
+    //! \param capacity: size of the destination buffer
+    //! \param blockType: BLOCKING binds the calling task to the queue, the queue never blocks
+    //! \param actualSize: (output) size of the message data
+    //! \param priority: (output) priority of the message
+    //! \return SIZE_MISMATCH if the message does not fit the destination, EMPTY if no message waits, OP_OK otherwise
+    Status receive(U8* destination,
+                   FwSizeType capacity,
+                   BlockingType blockType,
+                   FwSizeType& actualSize,
+                   FwQueuePriorityType& priority) override;
+
+    //! \brief get number of messages available
+    //!
+    //! \return number of messages available
+    FwSizeType getMessagesAvailable() const override;
+
+    //! \brief get maximum messages stored at any given time
+    //!
+    //! \return maximum messages stored at any given time
+    FwSizeType getMessageHighWaterMark() const override;
+
+    //! \brief return the underlying queue handle (implementation specific)
+    //!
+    //! The handle gives access to the `MessageRing`, to serialize messages in place.
+    //!
+    //! \return internal queue handle representation
+    QueueHandle* getHandle() override;
+
+  private:
+    //! Internal handle
+    BaremetalQueueHandle m_handle;
+};
+}  // namespace Baremetal
+}  // namespace Os
+
+#endif  // OS_BAREMETAL_QUEUE_HPP
@@ -0,0 +1,123 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/RawTime.cpp
+// \brief implementation for Os::Baremetal::BaremetalRawTime
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/RawTime.hpp>
+#include <fprime-baremetal/Os/Baremetal/error.hpp>
+#include <limits>
+
+// Hosts running the unit tests have a monotonic clock to stand in for a hardware counter
+#if defined(__linux__) || defined(__APPLE__)
+#define BAREMETAL_RAWTIME_HOST_CLOCK 1
+#include <time.h>
+#include <cerrno>
+#else
+#define BAREMETAL_RAWTIME_HOST_CLOCK 0
+#endif
+
+namespace Os {
+namespace Baremetal {
+
+static const U64 NANOSECONDS_PER_SECOND = 1000000000;
+static const U64 MICROSECONDS_PER_SECOND = 1000000;
+
+static BaremetalRawTime::Counter s_counter = nullptr;  //!< counter set by setCounter, or nullptr
+static void* s_counterContext = nullptr;               //!< argument of the counter
+static U32 s_frequencyHz = 0;                          //!< ticks per second of the counter
+static U64 s_counterMask = 0;                          //!< bits of the counter
+static U64 s_lastRaw = 0;                              //!< counter value at the previous read
+static U64 s_ticks = 0;                                //!< ticks counted up to the previous read
+
+//! \brief get the ticks of a RawTime
+static U64 getTicks(const Os::RawTime& time) {
+    return static_cast<const BaremetalRawTimeHandle*>(const_cast<Os::RawTime&>(time).getHandle())->m_ticks;
+}
+
+void BaremetalRawTime::setCounter(Counter counter, U32 frequencyHz, U8 bits, void* context) {
+    s_counter = counter;
+    s_counterContext = context;
+    if (counter == nullptr) {
+        s_frequencyHz = 0;
+        return;
+    }
+    FW_ASSERT(frequencyHz > 0);
+    FW_ASSERT((bits > 0) and (bits <= 64), static_cast<FwAssertArgType>(bits));
+    s_frequencyHz = frequencyHz;
+    s_counterMask = (bits == 64) ? std::numeric_limits<U64>::max() : ((static_cast<U64>(1) << bits) - 1);
+    s_lastRaw = counter(context) & s_counterMask;
+}
+
+U32 BaremetalRawTime::getFrequency() {
+    if (s_counter != nullptr) {
+        return s_frequencyHz;
+    }
+    return BAREMETAL_RAWTIME_HOST_CLOCK ? static_cast<U32>(NANOSECONDS_PER_SECOND) : 0;
+}
+
+U64 BaremetalRawTime::getNanoseconds(const Os::RawTime& start, const Os::RawTime& end) {
+    const U64 startTicks = getTicks(start);
+    const U64 endTicks = getTicks(end);
+    const U64 frequency = getFrequency();
+    if ((frequency == 0) or (endTicks <= startTicks)) {
+        return 0;
+    }
+    // Whole seconds and the remainder apart, so the products cannot overflow
+    const U64 ticks = endTicks - startTicks;
+    return ((ticks / frequency) * NANOSECONDS_PER_SECOND) +
+           (((ticks % frequency) * NANOSECONDS_PER_SECOND) / frequency);
+}
+
+RawTimeHandle* BaremetalRawTime::getHandle() {
+    return &this->m_handle;
+}
+
+BaremetalRawTime::Status BaremetalRawTime::now() {
+    if (s_counter == nullptr) {
+#if BAREMETAL_RAWTIME_HOST_CLOCK
+        timespec time;
+        if (clock_gettime(CLOCK_MONOTONIC, &time) != 0) {
+            return errno_to_rawtime_status(errno);
+        }
+        this->m_handle.m_ticks =
+            (static_cast<U64>(time.tv_sec) * NANOSECONDS_PER_SECOND) + static_cast<U64>(time.tv_nsec);
+        return Status::OP_OK;
+#else
+        return Status::NOT_SUPPORTED;
+#endif
+    }
+    // Masked difference, so the turns of a narrow counter are counted as long as one read is made per turn
+    const U64 raw = s_counter(s_counterContext) & s_counterMask;
+    s_ticks += (raw - s_lastRaw) & s_counterMask;
+    s_lastRaw = raw;
+    this->m_handle.m_ticks = s_ticks;
+    return Status::OP_OK;
+}
+
+BaremetalRawTime::Status BaremetalRawTime::getTimeInterval(const Os::RawTime& other, Fw::TimeInterval& result) const {
+    const U64 frequency = getFrequency();
+    if (frequency == 0) {
+        return Status::NOT_SUPPORTED;
+    }
+    const U64 otherTicks = getTicks(other);
+    const U64 ticks = (this->m_handle.m_ticks > otherTicks) ? (this->m_handle.m_ticks - otherTicks)
+                                                            : (otherTicks - this->m_handle.m_ticks);
+    const U64 seconds = ticks / frequency;
+    if (seconds > std::numeric_limits<U32>::max()) {
+        return Status::OP_OVERFLOW;
+    }
+    const U64 useconds = ((ticks % frequency) * MICROSECONDS_PER_SECOND) / frequency;
+    result = Fw::TimeInterval(static_cast<U32>(seconds), static_cast<U32>(useconds));
+    return Status::OP_OK;
+}
+
+Fw::SerializeStatus BaremetalRawTime::serializeTo(Fw::SerializeBufferBase& buffer) const {
+    return buffer.serializeFrom(this->m_handle.m_ticks);
+}
+
+Fw::SerializeStatus BaremetalRawTime::deserializeFrom(Fw::SerializeBufferBase& buffer) {
+    return buffer.deserializeTo(this->m_handle.m_ticks);
+}
+
+}  // namespace Baremetal
+}  // namespace Os
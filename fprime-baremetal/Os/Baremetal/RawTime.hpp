@@ -0,0 +1,107 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Baremetal/RawTime.hpp
+// \brief implementation for Os::Baremetal::BaremetalRawTime, header definitions
+// ======================================================================
+#include <Os/RawTime.hpp>
+#ifndef OS_BAREMETAL_RAWTIME_HPP
+#define OS_BAREMETAL_RAWTIME_HPP
+
+namespace Os {
+namespace Baremetal {
+
+//! RawTimeHandle class definition for baremetal implementations.
+//!
+struct BaremetalRawTimeHandle : public RawTimeHandle {
+    U64 m_ticks = 0;  //!< counter ticks since the counter was set, extended to 64 bits
+};
+
+//! \brief baremetal implementation of Os::RawTimeInterface
+//!
+//! Implementation of `RawTimeInterface` reading a free-running hardware counter, such as the DWT cycle counter or a
+//! timer, given to `setCounter` with its frequency and width. Counters narrower than 64 bits are extended to 64 bits by
+//! adding the ticks elapsed since the previous read, so time must be read at least once per turn of the counter, which
+//! takes 42 seconds for a 32-bit cycle counter at 100 MHz. `TaskRunner` profiling and tracing read it on every slice,
+//! otherwise a rate group or the idle hook can. Reads are not interrupt safe and must be made from tasks.
+//!
+//! On hosts the default counter is `clock_gettime(CLOCK_MONOTONIC)` in nanoseconds, so the same instrumentation runs
+//! in unit tests. Elsewhere, `now` returns `NOT_SUPPORTED` until a counter is set.
+//!
+//! `getTimeInterval` is limited to the microseconds of `Fw::TimeInterval`. `getNanoseconds` converts the difference
+//! of two times at the full resolution of the counter.
+//!
+class BaremetalRawTime : public RawTimeInterface {
+  public:
+    //! \brief function reading the counter, counting up
+    typedef U64 (*Counter)(void* context);
+
+    //! \brief constructor
+    //!
+    BaremetalRawTime() = default;
+
+    //! \brief destructor
+    //!
+    ~BaremetalRawTime() override = default;
+
+    //! \brief set the counter read by `now`
+    //!
+    //! Time read before the counter was set stays comparable with time read after it only if the frequency is the same.
+    //!
+    //! \param counter: function reading the counter, or nullptr for the host clock where there is one
+    //! \param frequencyHz: ticks of the counter per second
+    //! \param bits: width of the counter, up to 64
+    //! \param context: argument of the counter function
+    static void setCounter(Counter counter, U32 frequencyHz, U8 bits = 32, void* context = nullptr);
+
+    //! \brief get the ticks per second of the counter, 0 if there is none
+    static U32 getFrequency();
+
+    //! \brief get the nanoseconds between two times
+    //!
+    //! \param start: earlier time
+    //! \param end: later time
+    //! \return nanoseconds from start to end, 0 if end is not after start or no counter is set
+    static U64 getNanoseconds(const Os::RawTime& start, const Os::RawTime& end);
+
+    // ------------------------------------
+    // Functions overrides
+    // ------------------------------------
+
+    //! \brief return the underlying RawTime handle (implementation specific)
+    //! \return internal RawTime handle representation
+    RawTimeHandle* getHandle() override;
+
+    //! \brief Get the current time.
+    //!
+    //! This function retrieves the current time and stores it in the RawTime object.
+    //!
+    //! \return Status indicating the result of the operation: NOT_SUPPORTED if no counter is set
+    Status now() override;
+
+    //! \brief Calculate the time interval between this and another raw time.
+    //!
+    //! \param other The other RawTime object to compare with.
+    //! \param result A reference to a Fw::TimeInterval object where the result will be stored.
+    //! \return Status indicating the result of the operation: OP_OVERFLOW if the seconds do not fit 32 bits
+    Status getTimeInterval(const Os::RawTime& other, Fw::TimeInterval& result) const override;
+
+    //! \brief Serialize the contents of the RawTimeInterface object into a buffer.
+    //!
+    //! The 64-bit tick count is serialized.
+    //!
+    //! \param buffer The buffer where the serialized data will be stored.
+    //! \return Fw::SerializeStatus indicating the result of the serialization.
+    Fw::SerializeStatus serializeTo(Fw::SerializeBufferBase& buffer) const override;
+
+    //! \brief Deserialize the contents of the RawTimeInterface object from a buffer.
+    //!
+    //! \param buffer The buffer from which the serialized data will be read.
+    //! \return Fw::SerializeStatus indicating the result of the deserialization.
+    Fw::SerializeStatus deserializeFrom(Fw::SerializeBufferBase& buffer) override;
+
+  private:
+    //! Internal handle
+    BaremetalRawTimeHandle m_handle;
+};
+}  // namespace Baremetal
+}  // namespace Os
+#endif  // OS_BAREMETAL_RAWTIME_HPP
@@ -23,6 +23,10 @@ void BaremetalTask::suspend(Os::TaskInterface::SuspensionType suspensionType) {
 
 void BaremetalTask::resume() {
     this->m_handle.m_enabled = true;
+    // Suspended tasks are taken out of the ready lists, put it back
+    if (this->m_handle.m_node.runner != nullptr) {
+        this->m_handle.m_node.runner->resumeTask(this->m_handle.m_node.task);
+    }
 }
 
 Os::TaskHandle* BaremetalTask::getHandle() {
@@ -46,9 +50,21 @@ bool BaremetalTask::isCooperative() {
 }
 
 Os::Task::Status BaremetalTask::_delay(const Fw::TimeInterval& interval) {
-    // It is an error to attempt to delay a baremetal task because this would amount to [insert something bad here]
-    FW_ASSERT(0);
-    return Os::Task::Status::UNKNOWN_ERROR;
+    const U64 delayUs = (static_cast<U64>(interval.getSeconds()) * 1000000U) + interval.getUSeconds();
+    TaskRunner& runner = TaskRunner::getSingleton();
+    // A cooperative task cannot block, it is held back by the task runner once its unit of work returns
+    if (runner.delayCurrentTask(delayUs)) {
+        return Os::Task::Status::OP_OK;
+    }
+    // Outside of any task (e.g. during initialization) there is nothing else to run, so wait in place, unless the clock
+    // cannot be read and the wait would never end
+    if (not runner.hasClock()) {
+        return Os::Task::Status::DELAY_ERROR;
+    }
+    const U64 endUs = runner.getTimeUs() + delayUs;
+    while (runner.getTimeUs() < endUs) {
+    }
+    return Os::Task::Status::OP_OK;
 }
 
 }  // namespace Baremetal
@@ -3,6 +3,7 @@
 // \brief stub definitions for Os::Task
 // ======================================================================
 #include "Os/Task.hpp"
+#include "fprime-baremetal/Os/TaskRunner/TaskRunner.hpp"
 
 #ifndef OS_BAREMETAL_TASK_HPP
 #define OS_BAREMETAL_TASK_HPP
@@ -14,6 +15,7 @@ struct BaremetalTaskHandle : public TaskHandle {
     bool m_enabled;                            //!< Is this task enabled or not
     Os::TaskInterface::taskRoutine m_routine;  //!< Function passed into the task
     void* m_argument;                          //!< Argument input pointer
+    TaskRunnerNode m_node;                     //!< Scheduling links used by the task runner
 };
 
 //! Implementation of task
@@ -56,6 +58,9 @@ class BaremetalTask : public TaskInterface {
     //! Delays, or sleeps, the current task by the supplied time interval. In non-preempting os implementations
     //! the task will resume no earlier than expected but an exact wake-up time is not guaranteed.
     //!
+    //! Called from a unit of work, this returns right away and the task runner holds the task back until the delay
+    //! has passed. Called outside of any task, it waits in place.
+    //!
     //! \param interval: delay time
     //! \return status of the delay
     Status _delay(const Fw::TimeInterval& interval) override;
@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------
+// MemoryTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/MallocAllocator.hpp>
+#include <fprime-baremetal/Os/Baremetal/Memory.hpp>
+#include <fprime-baremetal/Os/HeapStats/HeapStats.hpp>
+
+TEST(BaremetalMemory, NoCapacity) {
+    Os::Baremetal::HeapStats::reset();
+    Os::Baremetal::HeapStats::setCapacity(0);
+    Fw::MallocAllocator malloc;
+    Os::Baremetal::AccountingAllocator allocator(malloc);
+    bool recoverable = false;
+    FwSizeType size = 100;
+    void* memory = allocator.allocate(0, size, recoverable);
+    ASSERT_NE(nullptr, memory);
+
+    // Allocations alone do not tell how large the heap is
+    Os::Baremetal::BaremetalMemory baremetalMemory;
+    Os::Memory::Usage usage;
+    EXPECT_EQ(Os::MemoryInterface::Status::ERROR, baremetalMemory._getUsage(usage));
+    allocator.deallocate(0, memory);
+}
+
+TEST(BaremetalMemory, UsageOfCapacity) {
+    Os::Baremetal::HeapStats::reset();
+    static U8 heap[1000];
+    Os::Baremetal::HeapStats::setCapacity(&heap[0], &heap[1000]);
+    ASSERT_EQ(1000, Os::Baremetal::HeapStats::getCapacity());
+    Fw::MallocAllocator malloc;
+    Os::Baremetal::AccountingAllocator allocator(malloc);
+    bool recoverable = false;
+    FwSizeType size = 100;
+    void* memory = allocator.allocate(0, size, recoverable);
+    ASSERT_NE(nullptr, memory);
+
+    Os::Baremetal::BaremetalMemory baremetalMemory;
+    Os::Memory::Usage usage;
+    ASSERT_EQ(Os::MemoryInterface::Status::OP_OK, baremetalMemory._getUsage(usage));
+    EXPECT_EQ(100, usage.used);
+    EXPECT_EQ(1000, usage.total);
+
+    // Usage follows frees, not the peak
+    allocator.deallocate(0, memory);
+    ASSERT_EQ(Os::MemoryInterface::Status::OP_OK, baremetalMemory._getUsage(usage));
+    EXPECT_EQ(0, usage.used);
+    EXPECT_EQ(1000, usage.total);
+    Os::Baremetal::HeapStats::setCapacity(0);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
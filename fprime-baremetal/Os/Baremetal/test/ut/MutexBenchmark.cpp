@@ -0,0 +1,78 @@
+// ----------------------------------------------------------------------
+// MutexBenchmark.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Os/Mutex.hpp>
+#include <fprime-baremetal/Os/Baremetal/Mutex.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace {
+
+const U32 WRITES = 2000000;  //!< telemetry writes timed per measure
+
+//! stands in for the telemetry database of a component such as TlmChan: one guarded write per channel update
+template <class Lock>
+struct TlmStore {
+    Lock lock;
+    U8 buffer[16] = {};
+
+    void write(U32 value, U32 time) {
+        this->lock.lock();
+        (void)std::memcpy(&this->buffer[0], &value, sizeof value);
+        (void)std::memcpy(&this->buffer[sizeof value], &time, sizeof time);
+        this->buffer[8]++;
+        this->lock.unLock();
+    }
+};
+
+//! std::mutex with the Os::Mutex names, as taken by hosted builds
+struct HostedLock {
+    std::mutex mutex;
+    void lock() { this->mutex.lock(); }
+    void unLock() { this->mutex.unlock(); }
+};
+
+//! no lock at all, the floor of a write. The fences keep the compiler from merging the writes
+struct NoLock {
+    void lock() { std::atomic_signal_fence(std::memory_order_seq_cst); }
+    void unLock() { std::atomic_signal_fence(std::memory_order_seq_cst); }
+};
+
+//! return nanoseconds per telemetry write
+template <class Lock>
+F64 measure(TlmStore<Lock>& store) {
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 write = 0; write < WRITES; write++) {
+        store.write(write, write >> 3);
+    }
+    const F64 nanoseconds = std::chrono::duration<F64, std::nano>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(static_cast<U8>(WRITES), store.buffer[8]);
+    return nanoseconds / WRITES;
+}
+
+}  // namespace
+
+TEST(BaremetalMutex, TelemetryWriteCost) {
+    TlmStore<Os::Mutex> baremetal;
+    TlmStore<HostedLock> hosted;
+    TlmStore<NoLock> unlocked;
+    const F64 baremetalNs = measure(baremetal);
+    const F64 hostedNs = measure(hosted);
+    const F64 unlockedNs = measure(unlocked);
+    std::printf("%-20s %9.2f ns per write\n", "no lock", unlockedNs);
+    std::printf("%-20s %9.2f ns per write, %zu byte handle\n", "Os::Mutex baremetal", baremetalNs,
+                sizeof(Os::Baremetal::BaremetalMutexHandle));
+    std::printf("%-20s %9.2f ns per write, %zu byte handle\n", "std::mutex", hostedNs, sizeof(std::mutex));
+    std::printf("saved per write: %.2f ns\n", hostedNs - baremetalNs);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
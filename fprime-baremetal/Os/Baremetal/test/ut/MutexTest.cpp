@@ -0,0 +1,94 @@
+// ----------------------------------------------------------------------
+// MutexTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Os/Mutex.hpp>
+#include <fprime-baremetal/Os/Baremetal/ConditionVariable.hpp>
+#include <fprime-baremetal/Os/Baremetal/Mutex.hpp>
+
+namespace {
+
+U32 primask = 0;  //!< stands in for the interrupt mask register
+U32 maskCalls = 0;
+
+U32 maskInterrupts() {
+    maskCalls++;
+    const U32 previous = primask;
+    primask = 1;
+    return previous;
+}
+
+void restoreInterrupts(U32 state) {
+    primask = state;
+}
+
+}  // namespace
+
+TEST(BaremetalMutex, TakeAndRelease) {
+    Os::Mutex mutex;
+    EXPECT_EQ(Os::Mutex::Status::OP_OK, mutex.take());
+    EXPECT_EQ(Os::Mutex::Status::OP_OK, mutex.release());
+    // Nothing to protect against without interrupts involved, so taking twice does not deadlock
+    mutex.lock();
+    mutex.lock();
+    mutex.unLock();
+    mutex.unLock();
+}
+
+TEST(BaremetalMutex, MasksInterrupts) {
+    Os::Baremetal::BaremetalMutex::setInterruptMask(maskInterrupts, restoreInterrupts);
+    Os::Mutex outer;
+    Os::Mutex inner;
+    primask = 0;
+    maskCalls = 0;
+    outer.lock();
+    inner.lock();
+    inner.unLock();
+#if BAREMETAL_MUTEX_MASKS_INTERRUPTS
+    // Releasing a nested mutex restores the mask of the outer one
+    EXPECT_EQ(1, primask);
+    outer.unLock();
+    EXPECT_EQ(0, primask);
+    EXPECT_EQ(2, maskCalls);
+#else
+    outer.unLock();
+    EXPECT_EQ(0, primask);
+    EXPECT_EQ(0, maskCalls);
+#endif
+    Os::Baremetal::BaremetalMutex::setInterruptMask(nullptr, nullptr);
+}
+
+TEST(BaremetalMutex, GuardedWrites) {
+    // A telemetry store as in TlmChan, one guarded write per channel update
+    Os::Baremetal::BaremetalMutex::setInterruptMask(maskInterrupts, restoreInterrupts);
+    Os::Mutex mutex;
+    primask = 0;
+    maskCalls = 0;
+    U32 value = 0;
+    for (U32 write = 0; write < 1000; write++) {
+        Os::ScopeLock lock(mutex);
+        value = write;
+    }
+    EXPECT_EQ(999, value);
+    EXPECT_EQ(0, primask);
+    EXPECT_EQ(BAREMETAL_MUTEX_MASKS_INTERRUPTS ? 1000 : 0, maskCalls);
+    // The handle holds at most the saved interrupt mask
+    EXPECT_LE(sizeof(Os::Baremetal::BaremetalMutexHandle), sizeof(Os::MutexHandle) + sizeof(U32));
+    Os::Baremetal::BaremetalMutex::setInterruptMask(nullptr, nullptr);
+}
+
+TEST(BaremetalConditionVariable, CannotWait) {
+    Os::Baremetal::BaremetalConditionVariable condition;
+    Os::Mutex mutex;
+    mutex.lock();
+    EXPECT_EQ(Os::ConditionVariableInterface::Status::ERROR_NOT_IMPLEMENTED, condition.pend(mutex));
+    mutex.unLock();
+    condition.notify();
+    condition.notifyAll();
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
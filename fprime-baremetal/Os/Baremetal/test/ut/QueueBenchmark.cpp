@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------
+// QueueBenchmark.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/Generic/PriorityQueue.hpp>
+#include <fprime-baremetal/Os/Baremetal/Queue.hpp>
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+const FwSizeType DEPTH = 16;         //!< queue depth
+const FwSizeType MESSAGE_SIZE = 64;  //!< size of a slot and of each message
+const U32 ROUNDS = 200000;           //!< send and receive pairs timed per measure
+
+//! time send and receive pairs through a half-full queue and return nanoseconds per pair
+//!
+//! \param levels: number of priorities the messages cycle through, 1 for the common case of a single priority
+F64 measure(Os::QueueInterface& queue, U8 levels) {
+    U8 message[MESSAGE_SIZE] = {};
+    FwSizeType size = 0;
+    FwQueuePriorityType priority = 0;
+    for (FwSizeType i = 0; i < (DEPTH / 2); i++) {
+        EXPECT_EQ(Os::QueueInterface::Status::OP_OK,
+                  queue.send(message, sizeof message, static_cast<U8>(i % levels), Os::QueueInterface::NONBLOCKING));
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (U32 round = 0; round < ROUNDS; round++) {
+        message[0] = static_cast<U8>(round);
+        (void)queue.send(message, sizeof message, static_cast<U8>(round % levels), Os::QueueInterface::NONBLOCKING);
+        (void)queue.receive(message, sizeof message, Os::QueueInterface::NONBLOCKING, size, priority);
+    }
+    const F64 nanoseconds = std::chrono::duration<F64, std::nano>(std::chrono::steady_clock::now() - start).count();
+    while (queue.receive(message, sizeof message, Os::QueueInterface::NONBLOCKING, size, priority) ==
+           Os::QueueInterface::Status::OP_OK) {
+    }
+    return nanoseconds / ROUNDS;
+}
+
+}  // namespace
+
+TEST(BaremetalQueue, Latency) {
+    Os::Baremetal::BaremetalQueue baremetal;
+    Os::Generic::PriorityQueue generic;
+    ASSERT_EQ(Os::QueueInterface::Status::OP_OK, baremetal.create(0, Fw::String("baremetal"), DEPTH, MESSAGE_SIZE));
+    ASSERT_EQ(Os::QueueInterface::Status::OP_OK, generic.create(0, Fw::String("generic"), DEPTH, MESSAGE_SIZE));
+
+    std::printf("%-8s %12s %12s %8s\n", "levels", "baremetal", "generic", "ratio");
+    for (const U8 levels : {1, 4}) {
+        const F64 baremetalNs = measure(baremetal, levels);
+        const F64 genericNs = measure(generic, levels);
+        std::printf("%-8u %9.1f ns %9.1f ns %8.2f\n", static_cast<unsigned int>(levels), baremetalNs, genericNs,
+                    genericNs / baremetalNs);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
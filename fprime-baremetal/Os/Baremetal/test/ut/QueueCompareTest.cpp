@@ -0,0 +1,93 @@
+// ----------------------------------------------------------------------
+// QueueCompareTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/Generic/PriorityQueue.hpp>
+#include <fprime-baremetal/Os/Baremetal/Queue.hpp>
+
+#include <cstring>
+
+namespace {
+
+const FwSizeType DEPTH = 16;         //!< queue depth
+const FwSizeType MESSAGE_SIZE = 64;  //!< size of a slot and of the largest message
+const U32 OPERATIONS = 20000;        //!< sends and receives compared per number of priorities
+
+//! \brief xorshift32, so the sequence of operations is the same on every host
+U32 nextRandom(U32& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+//! \brief run the same random sends and receives on both queues and expect the same results
+//!
+//! \param levels: number of priorities the messages cycle through, 1 for the common case of a single priority
+void compare(U8 levels) {
+    Os::Baremetal::BaremetalQueue baremetal;
+    Os::Generic::PriorityQueue generic;
+    ASSERT_EQ(Os::QueueInterface::Status::OP_OK, baremetal.create(0, Fw::String("baremetal"), DEPTH, MESSAGE_SIZE));
+    ASSERT_EQ(Os::QueueInterface::Status::OP_OK, generic.create(0, Fw::String("generic"), DEPTH, MESSAGE_SIZE));
+    U32 random = 1;
+    U8 message[MESSAGE_SIZE] = {};
+    FwSizeType fullSends = 0;
+    FwSizeType emptyReceives = 0;
+    for (U32 operation = 0; operation < OPERATIONS; operation++) {
+        const U32 draw = nextRandom(random);
+        // Sends lead for the first half and receives for the second, so the queues fill up and run dry
+        const bool sending = (draw % 8) < ((operation < (OPERATIONS / 2)) ? 5U : 3U);
+        if (sending) {
+            const FwSizeType size = 1 + ((draw >> 8) % MESSAGE_SIZE);
+            const FwQueuePriorityType priority = static_cast<FwQueuePriorityType>((draw >> 16) % levels);
+            for (FwSizeType i = 0; i < size; i++) {
+                message[i] = static_cast<U8>(operation + i);
+            }
+            const Os::QueueInterface::Status status =
+                baremetal.send(message, size, priority, Os::QueueInterface::NONBLOCKING);
+            ASSERT_EQ(generic.send(message, size, priority, Os::QueueInterface::NONBLOCKING), status);
+            fullSends += (status == Os::QueueInterface::Status::FULL) ? 1 : 0;
+        } else {
+            U8 baremetalMessage[MESSAGE_SIZE] = {};
+            U8 genericMessage[MESSAGE_SIZE] = {};
+            FwSizeType baremetalSize = 0;
+            FwSizeType genericSize = 0;
+            FwQueuePriorityType baremetalPriority = 0;
+            FwQueuePriorityType genericPriority = 0;
+            const Os::QueueInterface::Status status = baremetal.receive(
+                baremetalMessage, sizeof baremetalMessage, Os::QueueInterface::NONBLOCKING, baremetalSize,
+                baremetalPriority);
+            ASSERT_EQ(generic.receive(genericMessage, sizeof genericMessage, Os::QueueInterface::NONBLOCKING,
+                                      genericSize, genericPriority),
+                      status);
+            if (status == Os::QueueInterface::Status::OP_OK) {
+                ASSERT_EQ(genericSize, baremetalSize);
+                ASSERT_EQ(genericPriority, baremetalPriority);
+                ASSERT_EQ(0, std::memcmp(genericMessage, baremetalMessage, baremetalSize));
+            }
+            emptyReceives += (status == Os::QueueInterface::Status::EMPTY) ? 1 : 0;
+        }
+        ASSERT_EQ(generic.getMessagesAvailable(), baremetal.getMessagesAvailable());
+    }
+    EXPECT_EQ(generic.getMessageHighWaterMark(), baremetal.getMessageHighWaterMark());
+    // Both edges of the queue were reached
+    EXPECT_GT(fullSends, 0U);
+    EXPECT_GT(emptyReceives, 0U);
+}
+
+}  // namespace
+
+TEST(BaremetalQueue, MatchesGenericQueueOnePriority) {
+    compare(1);
+}
+
+TEST(BaremetalQueue, MatchesGenericQueueFourPriorities) {
+    compare(4);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
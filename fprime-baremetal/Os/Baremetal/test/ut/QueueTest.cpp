@@ -0,0 +1,180 @@
+// ----------------------------------------------------------------------
+// QueueTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/Queue.hpp>
+#include <Os/Task.hpp>
+#include <fprime-baremetal/Os/Baremetal/Queue.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const FwSizeType MESSAGE_SIZE = 8;
+
+void sendValue(Os::Queue& queue, U8 value, FwQueuePriorityType priority) {
+    const U8 message[2] = {value, priority};
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.send(message, sizeof message, priority, Os::Queue::NONBLOCKING));
+}
+
+U8 receiveValue(Os::Queue& queue) {
+    U8 message[MESSAGE_SIZE];
+    FwSizeType size = 0;
+    FwQueuePriorityType priority = 0;
+    EXPECT_EQ(Os::Queue::Status::OP_OK, queue.receive(message, sizeof message, Os::Queue::NONBLOCKING, size, priority));
+    EXPECT_EQ(2, size);
+    EXPECT_EQ(message[1], priority);
+    return message[0];
+}
+
+}  // namespace
+
+TEST(BaremetalQueue, PriorityOrder) {
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("queue"), 4, MESSAGE_SIZE));
+    EXPECT_EQ(Os::Queue::Status::ALREADY_CREATED, queue.create(0, Fw::String("queue"), 4, MESSAGE_SIZE));
+
+    // Higher priorities first, in order of sending within a priority
+    sendValue(queue, 1, 1);
+    sendValue(queue, 2, 5);
+    sendValue(queue, 3, 1);
+    sendValue(queue, 4, 5);
+    const U8 message[MESSAGE_SIZE] = {};
+    EXPECT_EQ(Os::Queue::Status::FULL, queue.send(message, 1, 9, Os::Queue::BLOCKING));
+    EXPECT_EQ(4, queue.getMessagesAvailable());
+    EXPECT_EQ(4, queue.getMessageHighWaterMark());
+    EXPECT_EQ(2, receiveValue(queue));
+    EXPECT_EQ(4, receiveValue(queue));
+    EXPECT_EQ(1, receiveValue(queue));
+    EXPECT_EQ(3, receiveValue(queue));
+
+    U8 destination[MESSAGE_SIZE];
+    FwSizeType size = 0;
+    FwQueuePriorityType priority = 0;
+    EXPECT_EQ(Os::Queue::Status::EMPTY,
+              queue.receive(destination, sizeof destination, Os::Queue::BLOCKING, size, priority));
+    EXPECT_EQ(4, queue.getMessageHighWaterMark());
+
+    // Messages larger than a slot are refused, and a message larger than the destination stays queued
+    const U8 large[MESSAGE_SIZE + 1] = {};
+    EXPECT_EQ(Os::Queue::Status::SIZE_MISMATCH, queue.send(large, sizeof large, 0, Os::Queue::NONBLOCKING));
+    sendValue(queue, 5, 0);
+    EXPECT_EQ(Os::Queue::Status::SIZE_MISMATCH, queue.receive(destination, 1, Os::Queue::NONBLOCKING, size, priority));
+    EXPECT_EQ(5, receiveValue(queue));
+}
+
+TEST(BaremetalQueue, MatchesReferenceModel) {
+    Os::Queue queue;
+    const FwSizeType depth = 7;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("queue"), depth, MESSAGE_SIZE));
+    // Reference model: messages in sending order
+    std::vector<std::pair<U8, U8>> model;
+    std::srand(7);
+    U8 value = 0;
+    for (FwSizeType step = 0; step < 5000; step++) {
+        if ((model.size() < depth) and ((model.empty()) or ((std::rand() % 2) == 0))) {
+            const U8 priority = static_cast<U8>(std::rand() % 3);
+            sendValue(queue, value, priority);
+            model.emplace_back(value, priority);
+            value++;
+        } else {
+            // The first of the highest priority messages
+            const auto first = std::max_element(model.begin(), model.end(),
+                                                [](const std::pair<U8, U8>& left, const std::pair<U8, U8>& right) {
+                                                    return left.second < right.second;
+                                                });
+            ASSERT_EQ(first->first, receiveValue(queue));
+            model.erase(first);
+        }
+        ASSERT_EQ(model.size(), queue.getMessagesAvailable());
+    }
+}
+
+TEST(BaremetalQueue, InPlace) {
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("queue"), 2, MESSAGE_SIZE));
+    Os::Baremetal::MessageRing& ring = static_cast<Os::Baremetal::BaremetalQueueHandle*>(queue.getHandle())->m_ring;
+
+    // A reserved slot is kept from plain sends until committed
+    FwSizeType capacity = 0;
+    U8* slot = ring.reserve(capacity);
+    ASSERT_NE(nullptr, slot);
+    EXPECT_EQ(MESSAGE_SIZE, capacity);
+    FwSizeType unused = 0;
+    EXPECT_EQ(nullptr, ring.reserve(unused));
+    sendValue(queue, 1, 0);
+    const U8 message[1] = {};
+    EXPECT_EQ(Os::Queue::Status::FULL, queue.send(message, 1, 0, Os::Queue::NONBLOCKING));
+    EXPECT_EQ(1, receiveValue(queue));
+    slot[0] = 2;
+    slot[1] = 3;
+    ring.commit(2, 3);
+
+    // Read in place, then freed
+    FwSizeType size = 0;
+    FwQueuePriorityType priority = 0;
+    const U8* received = ring.peek(size, priority);
+    ASSERT_NE(nullptr, received);
+    EXPECT_EQ(2, size);
+    EXPECT_EQ(3, priority);
+    EXPECT_EQ(2, received[0]);
+    ring.release();
+    EXPECT_EQ(nullptr, ring.peek(size, priority));
+    EXPECT_EQ(0, queue.getMessagesAvailable());
+}
+
+namespace {
+
+std::vector<U8> dispatched;
+
+//! dispatches like an active component on a cooperative task
+void dispatch(void* argument) {
+    Os::Queue& queue = *static_cast<Os::Queue*>(argument);
+    if (queue.getMessagesAvailable() == 0) {
+        return;
+    }
+    U8 message[MESSAGE_SIZE];
+    FwSizeType size = 0;
+    FwQueuePriorityType priority = 0;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.receive(message, sizeof message, Os::Queue::BLOCKING, size, priority));
+    dispatched.push_back(message[0]);
+}
+
+}  // namespace
+
+TEST(BaremetalQueue, WakesReceiver) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Queue queue;
+    ASSERT_EQ(Os::Queue::Status::OP_OK, queue.create(0, Fw::String("queue"), 4, MESSAGE_SIZE));
+    Os::Task task;
+    Fw::String name("active");
+    Os::Task::Arguments arguments(name, dispatch, &queue, 10);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+
+    // Polls until its first receive binds it, then runs once per message
+    runner.run();
+    EXPECT_TRUE(runner.hasReadyTask());
+    sendValue(queue, 1, 0);
+    sendValue(queue, 2, 0);
+    runner.run();
+    EXPECT_EQ(std::vector<U8>({1}), dispatched);
+    runner.run();
+    EXPECT_EQ(std::vector<U8>({1, 2}), dispatched);
+    EXPECT_FALSE(runner.hasReadyTask());
+    sendValue(queue, 3, 0);
+    EXPECT_TRUE(runner.hasReadyTask());
+    runner.run();
+    EXPECT_EQ(std::vector<U8>({1, 2, 3}), dispatched);
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    runner.removeTask(&task);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
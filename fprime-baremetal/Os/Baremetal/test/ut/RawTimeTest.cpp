@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------
+// RawTimeTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Os/RawTime.hpp>
+#include <fprime-baremetal/Os/Baremetal/RawTime.hpp>
+
+namespace {
+
+U64 counterValue = 0;
+
+U64 readCounter(void* context) {
+    return *static_cast<U64*>(context);
+}
+
+}  // namespace
+
+TEST(BaremetalRawTime, ExtendsNarrowCounter) {
+    // 16-bit timer at 1 MHz, turning every 65.536 ms
+    counterValue = 0xFF00;
+    Os::Baremetal::BaremetalRawTime::setCounter(readCounter, 1000000, 16, &counterValue);
+    EXPECT_EQ(1000000, Os::Baremetal::BaremetalRawTime::getFrequency());
+    Os::RawTime start;
+    ASSERT_EQ(Os::RawTime::OP_OK, start.now());
+
+    // Each read counts the ticks since the previous one, across the turns of the counter
+    Os::RawTime later;
+    for (U32 read = 0; read < 100; read++) {
+        counterValue = (counterValue + 50000) & 0xFFFF;
+        ASSERT_EQ(Os::RawTime::OP_OK, later.now());
+    }
+    Fw::TimeInterval interval;
+    ASSERT_EQ(Os::RawTime::OP_OK, later.getTimeInterval(start, interval));
+    EXPECT_EQ(5, interval.getSeconds());
+    EXPECT_EQ(0, interval.getUSeconds());
+    // Either order gives the same interval
+    ASSERT_EQ(Os::RawTime::OP_OK, start.getTimeInterval(later, interval));
+    EXPECT_EQ(5, interval.getSeconds());
+
+    // Bits above the width of the counter are ignored
+    counterValue = 0x10000 | ((counterValue + 7) & 0xFFFF);
+    Os::RawTime last;
+    ASSERT_EQ(Os::RawTime::OP_OK, last.now());
+    EXPECT_EQ(7000, Os::Baremetal::BaremetalRawTime::getNanoseconds(later, last));
+    EXPECT_EQ(0, Os::Baremetal::BaremetalRawTime::getNanoseconds(last, later));
+}
+
+TEST(BaremetalRawTime, Resolution) {
+    // Cycle counter at 3 GHz: a third of a nanosecond per tick
+    counterValue = 0;
+    Os::Baremetal::BaremetalRawTime::setCounter(readCounter, 3000000000U, 64, &counterValue);
+    Os::RawTime start;
+    ASSERT_EQ(Os::RawTime::OP_OK, start.now());
+    counterValue = (3000000000ULL * 2) + 4500;
+    Os::RawTime end;
+    ASSERT_EQ(Os::RawTime::OP_OK, end.now());
+    EXPECT_EQ(2000001500, Os::Baremetal::BaremetalRawTime::getNanoseconds(start, end));
+    Fw::TimeInterval interval;
+    ASSERT_EQ(Os::RawTime::OP_OK, end.getTimeInterval(start, interval));
+    EXPECT_EQ(2, interval.getSeconds());
+    EXPECT_EQ(1, interval.getUSeconds());
+
+    // Intervals past 2^32 seconds do not fit Fw::TimeInterval
+    Os::Baremetal::BaremetalRawTime::setCounter(readCounter, 1, 64, &counterValue);
+    ASSERT_EQ(Os::RawTime::OP_OK, start.now());
+    counterValue += 0x100000000ULL;
+    ASSERT_EQ(Os::RawTime::OP_OK, end.now());
+    EXPECT_EQ(Os::RawTime::OP_OVERFLOW, end.getTimeInterval(start, interval));
+}
+
+TEST(BaremetalRawTime, HostClock) {
+    Os::Baremetal::BaremetalRawTime::setCounter(nullptr, 0);
+    EXPECT_EQ(1000000000, Os::Baremetal::BaremetalRawTime::getFrequency());
+    Os::RawTime start;
+    Os::RawTime end;
+    ASSERT_EQ(Os::RawTime::OP_OK, start.now());
+    ASSERT_EQ(Os::RawTime::OP_OK, end.now());
+    Fw::TimeInterval interval;
+    ASSERT_EQ(Os::RawTime::OP_OK, end.getTimeInterval(start, interval));
+    EXPECT_EQ(0, interval.getSeconds());
+    EXPECT_LT(Os::Baremetal::BaremetalRawTime::getNanoseconds(start, end), 1000000000);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
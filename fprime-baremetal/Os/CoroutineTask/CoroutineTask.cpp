@@ -0,0 +1,148 @@
+// ======================================================================
+// \title fprime-baremetal/Os/CoroutineTask/CoroutineTask.cpp
+// \brief CoroutineTask implementations
+// ======================================================================
+#include <fprime-baremetal/Os/CoroutineTask/CoroutineTask.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+CoroutineFramePool::Frame CoroutineFramePool::s_frames[COROUTINE_TASK_FRAMES];
+bool CoroutineFramePool::s_used[COROUTINE_TASK_FRAMES] = {};
+
+void* CoroutineFramePool::allocate(std::size_t size) {
+    // Frames larger than the configured size cannot be pooled, COROUTINE_TASK_FRAME_SIZE must grow
+    if (size > COROUTINE_TASK_FRAME_SIZE) {
+        return nullptr;
+    }
+    for (FwSizeType i = 0; i < COROUTINE_TASK_FRAMES; i++) {
+        if (not s_used[i]) {
+            s_used[i] = true;
+            return s_frames[i].bytes;
+        }
+    }
+    return nullptr;
+}
+
+void CoroutineFramePool::deallocate(void* frame) {
+    FW_ASSERT(frame != nullptr);
+    const FwSizeType index = static_cast<FwSizeType>(static_cast<Frame*>(frame) - s_frames);
+    FW_ASSERT(index < COROUTINE_TASK_FRAMES, static_cast<FwAssertArgType>(index));
+    FW_ASSERT(s_used[index], static_cast<FwAssertArgType>(index));
+    s_used[index] = false;
+}
+
+FwSizeType CoroutineFramePool::getFreeCount() {
+    FwSizeType count = 0;
+    for (FwSizeType i = 0; i < COROUTINE_TASK_FRAMES; i++) {
+        count += s_used[i] ? 0 : 1;
+    }
+    return count;
+}
+
+Coroutine::Coroutine(Handle handle) : m_handle(handle) {}
+
+Coroutine::Coroutine(Coroutine&& other) noexcept : m_handle(other.release()) {}
+
+Coroutine::~Coroutine() {
+    if (this->m_handle) {
+        this->m_handle.destroy();
+    }
+}
+
+Coroutine::Handle Coroutine::release() {
+    Handle handle = this->m_handle;
+    this->m_handle = nullptr;
+    return handle;
+}
+
+void CoroutineTask::DelayAwaiter::await_suspend(Coroutine::Handle) const {
+    // The task runner holds the task back once the unit of work returns, which it does right after this
+    (void)Os::Task::delay(this->interval);
+}
+
+bool CoroutineTask::ReadyAwaiter::await_suspend(Coroutine::Handle handle) const {
+    FW_ASSERT(handle.promise().owner != nullptr);
+    return handle.promise().owner->waitFor(this->waker, this->check, this->source);
+}
+
+CoroutineTask::~CoroutineTask() {
+    if (this->m_handle) {
+        TaskRunner::getSingleton().removeTask(&this->m_task);
+        this->m_handle.destroy();
+    }
+}
+
+Os::Task::Status CoroutineTask::start(const Fw::StringBase& name,
+                                      Routine routine,
+                                      void* argument,
+                                      FwTaskPriorityType priority) {
+    FW_ASSERT(routine != nullptr);
+    FW_ASSERT(not this->m_handle);  // Cannot start a task twice
+    Coroutine coroutine = routine(argument);
+    this->m_handle = coroutine.release();
+    if (not this->m_handle) {
+        return Os::Task::Status::ERROR_RESOURCES;
+    }
+    this->m_handle.promise().owner = this;
+    Os::Task::Arguments arguments(name, CoroutineTask::step, this, priority);
+    return this->m_task.start(arguments);
+}
+
+bool CoroutineTask::isDone() const {
+    return not this->m_handle;
+}
+
+Os::Task& CoroutineTask::getTask() {
+    return this->m_task;
+}
+
+std::suspend_always CoroutineTask::yield() {
+    return {};
+}
+
+CoroutineTask::DelayAwaiter CoroutineTask::delay(const Fw::TimeInterval& interval) {
+    return DelayAwaiter{interval};
+}
+
+void CoroutineTask::step(void* argument) {
+    FW_ASSERT(argument != nullptr);
+    CoroutineTask& self = *static_cast<CoroutineTask*>(argument);
+    TaskRunner& runner = TaskRunner::getSingleton();
+    // The unit of work run by Os::Task::start is outside of the runner, where the coroutine could not wait
+    if ((runner.getCurrentTask() != &self.m_task) or (not self.m_handle)) {
+        return;
+    }
+    if (self.m_check != nullptr) {
+        // Wakeups may outnumber the messages the coroutine took, it waits on until the source has work
+        if (not self.m_check(self.m_source)) {
+            return;
+        }
+        self.m_check = nullptr;
+        runner.setWaitForWake(&self.m_task, false);
+    }
+    self.m_handle.resume();
+    if (self.m_handle.done()) {
+        self.m_handle.destroy();
+        self.m_handle = nullptr;
+        runner.removeTask(&self.m_task);
+    }
+}
+
+bool CoroutineTask::waitFor(TaskWaker& waker, ReadyCheck check, const void* source) {
+    TaskRunner& runner = TaskRunner::getSingleton();
+    waker.bindCurrent(0);
+    FW_ASSERT(waker.getTask() == &this->m_task);  // A waker wakes a single task
+    runner.setWaitForWake(&this->m_task, true, 0);
+    // Wakeups were reset, so work that came since await_ready is only seen by checking again
+    if (check(source)) {
+        runner.setWaitForWake(&this->m_task, false);
+        return false;
+    }
+    this->m_check = check;
+    this->m_source = source;
+    return true;
+}
+
+}  // End namespace Baremetal
+}  // End Namespace Os
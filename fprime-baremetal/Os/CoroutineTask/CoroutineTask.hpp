@@ -0,0 +1,234 @@
+// ======================================================================
+// \title fprime-baremetal/Os/CoroutineTask/CoroutineTask.hpp
+// \brief CoroutineTask definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_COROUTINETASK_COROUTINETASK_HPP_
+#define FPRIME_BAREMETAL_COROUTINETASK_COROUTINETASK_HPP_
+#include <Fw/Time/TimeInterval.hpp>
+#include <Fw/Types/Assert.hpp>
+#include <Os/Task.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+#include <coroutine>
+#include <cstddef>
+#include "config/TaskRunnerCfg.hpp"
+
+#if !defined(__cpp_impl_coroutine)
+#error "CoroutineTask requires C++20 coroutines"
+#endif
+
+namespace Os {
+namespace Baremetal {
+
+class CoroutineTask;
+
+//! \brief fixed pool of frames for the coroutines of coroutine tasks
+//!
+//! Holds `COROUTINE_TASK_FRAMES` frames of `COROUTINE_TASK_FRAME_SIZE` bytes, so coroutine tasks never use the heap.
+//! Only used from cooperative tasks and initialization code, never from interrupts.
+class CoroutineFramePool {
+  public:
+    //! \brief take a frame
+    //!
+    //! \param size: size of the coroutine frame asked for by the compiler
+    //! \return frame, or nullptr if the size does not fit a frame or no frame is free
+    static void* allocate(std::size_t size);
+
+    //! \brief give back a frame taken with allocate
+    static void deallocate(void* frame);
+
+    //! \brief get the number of free frames
+    static FwSizeType getFreeCount();
+
+  private:
+    //! \brief storage of one frame
+    struct Frame {
+        alignas(std::max_align_t) U8 bytes[COROUTINE_TASK_FRAME_SIZE];  //!< frame memory
+    };
+
+    static Frame s_frames[COROUTINE_TASK_FRAMES];  //!< frames
+    static bool s_used[COROUTINE_TASK_FRAMES];     //!< frames taken
+};
+
+//! \brief return type of the routine of a coroutine task, owning the coroutine until the task takes it
+class Coroutine {
+  public:
+    //! \brief promise of a coroutine task routine
+    struct promise_type {
+        CoroutineTask* owner = nullptr;  //!< task running the coroutine
+
+        //! Coroutine owning the new coroutine
+        Coroutine get_return_object() { return Coroutine(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+        //! Empty coroutine, reported by `CoroutineTask::start`, when no frame was available
+        static Coroutine get_return_object_on_allocation_failure() { return Coroutine(); }
+
+        //! The routine starts on the first unit of work run by the task runner
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        //! The frame is kept until the task sees the routine finished and frees it
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        //! Nothing returned
+        void return_void() {}
+
+        //! Exceptions are not supported
+        void unhandled_exception() { FW_ASSERT(0); }
+
+        //! Frames come from the pool
+        static void* operator new(std::size_t size) noexcept { return CoroutineFramePool::allocate(size); }
+
+        //! Frames go back to the pool
+        static void operator delete(void* frame) { CoroutineFramePool::deallocate(frame); }
+    };
+
+    typedef std::coroutine_handle<promise_type> Handle;  //!< handle of a coroutine task routine
+
+    //! Empty coroutine
+    Coroutine() = default;
+
+    //! Coroutine owning a handle
+    explicit Coroutine(Handle handle);
+
+    //! Take the coroutine of another
+    Coroutine(Coroutine&& other) noexcept;
+
+    //! Destroy the coroutine, if still owned
+    ~Coroutine();
+
+    Coroutine(const Coroutine&) = delete;
+    Coroutine& operator=(const Coroutine&) = delete;
+
+    //! \brief hand the coroutine over, leaving this one empty
+    Handle release();
+
+  private:
+    Handle m_handle;  //!< owned coroutine
+};
+
+//! \brief a cooperative task running a stackless C++20 coroutine
+//!
+//! Multi-step work such as a protocol handshake or a chunked copy can be written as straight-line code instead of a
+//! state machine. Each unit of work run by the `TaskRunner` resumes the coroutine, which runs until its next
+//! `co_await` and gives control back there:
+//! - `co_await CoroutineTask::yield()` lets the other tasks run and resumes on the next pass.
+//! - `co_await CoroutineTask::delay(interval)` resumes once the delay has passed, using `Os::Task::delay`.
+//! - `co_await CoroutineTask::queueReady(waker, queue)` resumes once `queue.getMessagesAvailable()` is not 0, with the
+//!   task waiting for wakeups from the `TaskWaker` of the queue in the meantime.
+//!
+//! Coroutine frames are taken from `CoroutineFramePool` rather than the heap, and the task has no stack of its own:
+//! locals living across a `co_await` are kept in the frame. When the routine returns, its frame goes back to the pool
+//! and the task is removed from the task runner.
+//!
+//! ```c++
+//! Os::Baremetal::Coroutine handshake(void* argument) {
+//!     Link& link = *static_cast<Link*>(argument);
+//!     link.sendHello();
+//!     co_await Os::Baremetal::CoroutineTask::queueReady(link.waker, link.replies);
+//!     link.readReply();
+//!     co_await Os::Baremetal::CoroutineTask::delay(Fw::TimeInterval(0, 10000));
+//!     link.sendReady();
+//! }
+//!
+//! static Os::Baremetal::CoroutineTask task;
+//! task.start(Fw::String("Handshake"), handshake, &link, 10);
+//! ```
+class CoroutineTask {
+  public:
+    //! \brief routine of a coroutine task
+    typedef Coroutine (*Routine)(void* argument);
+
+    //! \brief function telling whether the source waited for has work
+    typedef bool (*ReadyCheck)(const void* source);
+
+    //! \brief awaiter of `delay`
+    struct DelayAwaiter {
+        Fw::TimeInterval interval;  //!< time to wait
+
+        //! Always waits
+        bool await_ready() const { return false; }
+
+        //! Delays the task
+        void await_suspend(Coroutine::Handle handle) const;
+
+        //! Nothing to return
+        void await_resume() const {}
+    };
+
+    //! \brief awaiter of `queueReady`
+    struct ReadyAwaiter {
+        TaskWaker& waker;    //!< waker notified by the source
+        ReadyCheck check;    //!< check of the source
+        const void* source;  //!< source waited for
+
+        //! Does not wait when the source already has work
+        bool await_ready() const { return this->check(this->source); }
+
+        //! Waits for wakeups until the source has work
+        bool await_suspend(Coroutine::Handle handle) const;
+
+        //! Nothing to return
+        void await_resume() const {}
+    };
+
+    //! Not started
+    CoroutineTask() = default;
+
+    //! Free the frame of a coroutine that did not finish
+    ~CoroutineTask();
+
+    //! \brief create the coroutine and start the task running it
+    //!
+    //! \param name: name of the task
+    //! \param routine: coroutine run by the task
+    //! \param argument: argument passed to the routine
+    //! \param priority: priority of the task
+    //! \return ERROR_RESOURCES if no frame of the pool fits the coroutine, or the status of the task start
+    Os::Task::Status start(const Fw::StringBase& name,
+                           Routine routine,
+                           void* argument = nullptr,
+                           FwTaskPriorityType priority = Os::Task::TASK_PRIORITY_DEFAULT);
+
+    //! \brief check whether the routine returned
+    bool isDone() const;
+
+    //! \brief get the task running the coroutine
+    Os::Task& getTask();
+
+    //! \brief give control back until the next pass
+    static std::suspend_always yield();
+
+    //! \brief give control back until a delay has passed
+    static DelayAwaiter delay(const Fw::TimeInterval& interval);
+
+    //! \brief give control back until a source, such as an `Os::Queue`, has messages
+    //!
+    //! \param waker: waker notified by the source for each message
+    //! \param source: object whose `getMessagesAvailable()` counts its messages
+    template <class Source>
+    static ReadyAwaiter queueReady(TaskWaker& waker, const Source& source) {
+        return ReadyAwaiter{waker, CoroutineTask::hasMessages<Source>, &source};
+    }
+
+  private:
+    //! \brief check a source of `queueReady`
+    template <class Source>
+    static bool hasMessages(const void* source) {
+        return static_cast<const Source*>(source)->getMessagesAvailable() > 0;
+    }
+
+    //! \brief routine of the task, resuming the coroutine
+    static void step(void* argument);
+
+    //! \brief switch the task to waiting for wakeups until a source has work
+    //!
+    //! \return false if the source got work meanwhile and the coroutine goes on
+    bool waitFor(TaskWaker& waker, ReadyCheck check, const void* source);
+
+    Os::Task m_task;                 //!< task running the coroutine
+    Coroutine::Handle m_handle;      //!< coroutine, empty when not started or done
+    ReadyCheck m_check = nullptr;    //!< check of the source waited for, nullptr when not waiting
+    const void* m_source = nullptr;  //!< source waited for
+};
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_COROUTINETASK_COROUTINETASK_HPP_ */
@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------
+// CoroutineTaskTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <fprime-baremetal/Os/CoroutineTask/CoroutineTask.hpp>
+
+#include <vector>
+
+namespace {
+
+std::vector<U32> steps;
+
+U64 virtualTimeUs = 0;
+
+U64 virtualClock(void*) {
+    return virtualTimeUs;
+}
+
+//! stands in for an Os::Queue
+struct FakeQueue {
+    FwSizeType messages = 0;
+    Os::Baremetal::TaskWaker waker;
+
+    FwSizeType getMessagesAvailable() const { return this->messages; }
+
+    void send() {
+        this->messages++;
+        this->waker.notify();
+    }
+};
+
+Os::Baremetal::Coroutine stepper(void* argument) {
+    const U32 id = *static_cast<U32*>(argument);
+    for (U32 step = 0; step < 3; step++) {
+        steps.push_back((id * 10) + step);
+        co_await Os::Baremetal::CoroutineTask::yield();
+    }
+}
+
+Os::Baremetal::Coroutine sleeper(void*) {
+    steps.push_back(1);
+    co_await Os::Baremetal::CoroutineTask::delay(Fw::TimeInterval(0, 3000));
+    steps.push_back(2);
+}
+
+Os::Baremetal::Coroutine consumer(void* argument) {
+    FakeQueue& queue = *static_cast<FakeQueue*>(argument);
+    for (U32 batch = 0; batch < 2; batch++) {
+        co_await Os::Baremetal::CoroutineTask::queueReady(queue.waker, queue);
+        while (queue.messages > 0) {
+            queue.messages--;
+            steps.push_back(batch);
+        }
+    }
+}
+
+void expectSteps(const std::vector<U32>& expected) {
+    EXPECT_EQ(expected, steps);
+    steps.clear();
+}
+
+}  // namespace
+
+TEST(CoroutineTask, YieldsInTurn) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    const FwSizeType freeFrames = Os::Baremetal::CoroutineFramePool::getFreeCount();
+    Os::Baremetal::CoroutineTask tasks[2];
+    U32 ids[2] = {1, 2};
+    for (FwSizeType i = 0; i < 2; i++) {
+        ASSERT_EQ(Os::Task::Status::OP_OK, tasks[i].start(Fw::String("stepper"), stepper, &ids[i], 10));
+    }
+    EXPECT_EQ(freeFrames - 2, Os::Baremetal::CoroutineFramePool::getFreeCount());
+    // Starting does not run the coroutines
+    expectSteps({});
+
+    // Each unit of work runs up to the next co_await
+    for (FwSizeType i = 0; i < 6; i++) {
+        runner.run();
+    }
+    expectSteps({10, 20, 11, 21, 12, 22});
+
+    // Returning frees the frame and removes the task
+    runner.runAll();
+    EXPECT_TRUE(tasks[0].isDone());
+    EXPECT_TRUE(tasks[1].isDone());
+    EXPECT_EQ(freeFrames, Os::Baremetal::CoroutineFramePool::getFreeCount());
+    EXPECT_FALSE(runner.hasReadyTask());
+}
+
+TEST(CoroutineTask, Delays) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    virtualTimeUs = 1000;
+    runner.setClock(virtualClock);
+    Os::Baremetal::CoroutineTask task;
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(Fw::String("sleeper"), sleeper));
+
+    runner.run();
+    expectSteps({1});
+    EXPECT_TRUE(runner.hasDelayedTask());
+    virtualTimeUs += 2000;
+    runner.run();
+    expectSteps({});
+    virtualTimeUs += 1000;
+    runner.run();
+    expectSteps({2});
+    EXPECT_TRUE(task.isDone());
+    runner.setClock(nullptr);
+}
+
+TEST(CoroutineTask, WaitsForQueue) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    FakeQueue queue;
+    Os::Baremetal::CoroutineTask task;
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(Fw::String("consumer"), consumer, &queue));
+
+    // Nothing queued, the task waits for wakeups
+    runner.run();
+    EXPECT_FALSE(runner.hasReadyTask());
+    queue.send();
+    queue.send();
+    EXPECT_TRUE(runner.hasReadyTask());
+    runner.run();
+    expectSteps({0, 0});
+
+    // The second wakeup finds the queue already emptied and the coroutine waits on
+    runner.run();
+    expectSteps({});
+    EXPECT_FALSE(runner.hasReadyTask());
+    queue.send();
+    runner.run();
+    expectSteps({1});
+    EXPECT_TRUE(task.isDone());
+}
+
+TEST(CoroutineTask, PoolExhausted) {
+    Os::Baremetal::CoroutineTask tasks[Os::COROUTINE_TASK_FRAMES + 1];
+    U32 id = 0;
+    for (FwSizeType i = 0; i < Os::COROUTINE_TASK_FRAMES; i++) {
+        ASSERT_EQ(Os::Task::Status::OP_OK, tasks[i].start(Fw::String("stepper"), stepper, &id));
+    }
+    EXPECT_EQ(0, Os::Baremetal::CoroutineFramePool::getFreeCount());
+    EXPECT_EQ(Os::Task::Status::ERROR_RESOURCES,
+              tasks[Os::COROUTINE_TASK_FRAMES].start(Fw::String("stepper"), stepper, &id));
+    EXPECT_TRUE(tasks[Os::COROUTINE_TASK_FRAMES].isDone());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,175 @@
+// ======================================================================
+// \title fprime-baremetal/Os/DeferredWork/DeferredWork.cpp
+// \brief DeferredWork implementations
+// ======================================================================
+#include <fprime-baremetal/Os/DeferredWork/DeferredWork.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+// ----------------------------------------------------------------------
+// DeferredWorkRing
+// ----------------------------------------------------------------------
+
+DeferredWorkRing::DeferredWorkRing(FwSizeType capacity) : m_mask(static_cast<U32>(capacity - 1)) {
+    FW_ASSERT((capacity > 0) and ((capacity & (capacity - 1)) == 0), static_cast<FwAssertArgType>(capacity));
+    FW_ASSERT(capacity <= (static_cast<FwSizeType>(1) << 31), static_cast<FwAssertArgType>(capacity));
+}
+
+U32 DeferredWorkRing::getDropped() const {
+    return this->m_dropped.load(std::memory_order_relaxed);
+}
+
+Task* DeferredWorkRing::getConsumer() const {
+    return this->m_waker.getTask();
+}
+
+// ----------------------------------------------------------------------
+// SpscWorkRing
+// ----------------------------------------------------------------------
+
+SpscWorkRing::SpscWorkRing(DeferredWork* entries, FwSizeType capacity)
+    : DeferredWorkRing(capacity), m_entries(entries) {
+    FW_ASSERT(entries != nullptr);
+}
+
+bool SpscWorkRing::post(DeferredWork::Handler handler, void* context, U32 argument) {
+    FW_ASSERT(handler != nullptr);
+    const U32 tail = this->m_tail.load(std::memory_order_relaxed);
+    // Acquire pairs with the release of receive, so the entry is not overwritten before it was copied out
+    if ((tail - this->m_head.load(std::memory_order_acquire)) > this->m_mask) {
+        // The one producer owns the count, so it needs no read-modify-write, which some cores cannot do atomically
+        this->m_dropped.store(this->m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+    DeferredWork& entry = this->m_entries[tail & this->m_mask];
+    entry.handler = handler;
+    entry.context = context;
+    entry.argument = argument;
+    this->m_tail.store(tail + 1, std::memory_order_release);
+#if TASK_RUNNER_ISR_WAKEUPS
+    this->m_waker.notifyFromIsr();
+#endif
+    return true;
+}
+
+bool SpscWorkRing::receive(DeferredWork& work) {
+#if TASK_RUNNER_ISR_WAKEUPS
+    if (this->m_waker.getTask() == nullptr) {
+        const FwSizeType counted = this->getCount();
+        this->m_waker.bindCurrent(static_cast<U32>(counted));
+        // Posts made before the task was bound did not wake it
+        for (FwSizeType missed = this->getCount() - counted; missed > 0; missed--) {
+            this->m_waker.notify();
+        }
+    }
+#endif
+    const U32 head = this->m_head.load(std::memory_order_relaxed);
+    if (head == this->m_tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    work = this->m_entries[head & this->m_mask];
+    this->m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool SpscWorkRing::runOne() {
+    DeferredWork work;
+    if (not this->receive(work)) {
+        return false;
+    }
+    work.handler(work.context, work.argument);
+    return true;
+}
+
+FwSizeType SpscWorkRing::getCount() const {
+    return this->m_tail.load(std::memory_order_acquire) - this->m_head.load(std::memory_order_acquire);
+}
+
+// ----------------------------------------------------------------------
+// MpscWorkRing
+// ----------------------------------------------------------------------
+// Only built where compare-and-swap is lock-free, so the single producer ring still builds on cores without it
+#if TASK_RUNNER_ISR_WAKEUPS
+
+// Each slot carries the first position of the turn of the ring it is in: t when free for the producer claiming the
+// position of the slot in turn t, t + 1 once that work is published, and t + capacity when the consumer handed it back
+// for the next turn. Zeroed slots are free for the first turn, so the slots need no setup, and are not overwritten by
+// the storage of MpscWorkRingStorage being constructed after this class. A single slot would read published work of
+// turn t as free for turn t + 1, so the ring has at least 2.
+
+MpscWorkRing::MpscWorkRing(Slot* slots, FwSizeType capacity) : DeferredWorkRing(capacity), m_slots(slots) {
+    FW_ASSERT(slots != nullptr);
+    FW_ASSERT(capacity >= 2, static_cast<FwAssertArgType>(capacity));
+}
+
+bool MpscWorkRing::post(DeferredWork::Handler handler, void* context, U32 argument) {
+    FW_ASSERT(handler != nullptr);
+    U32 position = this->m_tail.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &this->m_slots[position & this->m_mask];
+        const U32 turn = position & ~this->m_mask;
+        const I32 difference = static_cast<I32>(slot->sequence.load(std::memory_order_acquire) - turn);
+        if (difference == 0) {
+            // Free for this position: claim it, or retry from the position another producer moved the tail to
+            if (this->m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Still holding the work of the previous turn
+            this->m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = this->m_tail.load(std::memory_order_relaxed);
+        }
+    }
+    slot->work.handler = handler;
+    slot->work.context = context;
+    slot->work.argument = argument;
+    slot->sequence.store((position & ~this->m_mask) + 1, std::memory_order_release);
+    this->m_waker.notifyFromIsr();
+    return true;
+}
+
+bool MpscWorkRing::receive(DeferredWork& work) {
+    if (this->m_waker.getTask() == nullptr) {
+        const FwSizeType counted = this->getCount();
+        this->m_waker.bindCurrent(static_cast<U32>(counted));
+        // Posts made before the task was bound did not wake it
+        for (FwSizeType missed = this->getCount() - counted; missed > 0; missed--) {
+            this->m_waker.notify();
+        }
+    }
+    Slot& slot = this->m_slots[this->m_head & this->m_mask];
+    const U32 turn = this->m_head & ~this->m_mask;
+    if (slot.sequence.load(std::memory_order_acquire) != (turn + 1)) {
+        // Claimed but not yet published: the wakeup of this run belongs to a later entry, so keep it for the next run
+        if (this->getCount() > 0) {
+            this->m_waker.notify();
+        }
+        return false;
+    }
+    work = slot.work;
+    slot.sequence.store(turn + this->m_mask + 1, std::memory_order_release);
+    this->m_head++;
+    return true;
+}
+
+bool MpscWorkRing::runOne() {
+    DeferredWork work;
+    if (not this->receive(work)) {
+        return false;
+    }
+    work.handler(work.context, work.argument);
+    return true;
+}
+
+FwSizeType MpscWorkRing::getCount() const {
+    return this->m_tail.load(std::memory_order_acquire) - this->m_head;
+}
+
+#endif
+
+}  // End namespace Baremetal
+}  // End Namespace Os
@@ -0,0 +1,165 @@
+// ======================================================================
+// \title fprime-baremetal/Os/DeferredWork/DeferredWork.hpp
+// \brief DeferredWork definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_DEFERREDWORK_DEFERREDWORK_HPP_
+#define FPRIME_BAREMETAL_DEFERREDWORK_DEFERREDWORK_HPP_
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+#include <atomic>
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief work handed from an interrupt handler to a cooperative task
+struct DeferredWork {
+    //! \brief function doing the work, called from the consumer task
+    typedef void (*Handler)(void* context, U32 argument);
+
+    Handler handler = nullptr;  //!< function doing the work
+    void* context = nullptr;    //!< context of the function, such as the component owning the interrupt
+    U32 argument = 0;           //!< value captured by the interrupt, such as a status register
+};
+
+//! \brief state shared by the deferred work rings: capacity, consumer task and refused posts
+class DeferredWorkRing {
+  public:
+    //! \brief get the number of posts refused because the ring was full
+    U32 getDropped() const;
+
+    //! \brief get the task consuming the ring, or nullptr until its first receive
+    Task* getConsumer() const;
+
+  protected:
+    //! \brief ring over a power of two number of entries
+    explicit DeferredWorkRing(FwSizeType capacity);
+
+    TaskWaker m_waker;              //!< binds the consumer on its first receive and wakes it on every post
+    const U32 m_mask;               //!< capacity - 1
+    std::atomic<U32> m_dropped{0};  //!< posts refused because the ring was full
+};
+
+//! \brief lock-free ring taking deferred work from one interrupt handler to one cooperative task
+//!
+//! The producer, a single interrupt handler or task, calls `post`. It never blocks and costs a few loads and stores.
+//! Each post wakes the consumer through `TaskRunner::wakeFromIsr`, so no critical section is needed around the ring or
+//! the runner. The consumer task calls `receive` or `runOne` from its units of work. Its first call binds it to the
+//! ring and switches it to waiting for wakeups, so it only runs when work was posted, once per post, and
+//! `TaskRunner::setDrain` lets it take several per slice.
+//!
+//! The ring itself needs no atomic read-modify-write, so it also builds on cores without exclusive access instructions
+//! (such as Cortex-M0), where `TASK_RUNNER_ISR_WAKEUPS` is not set. Posts do not wake the consumer there: it keeps
+//! running on every pass and takes the work it finds.
+//!
+//! ```c++
+//! static Os::Baremetal::SpscWorkRingStorage<16> uartWork;
+//! void UART_IRQHandler() { uartWork.post(Uart::onByte, &uart, UART->DATA); }
+//! void Uart::taskRoutine(void*) { uartWork.runOne(); }
+//! ```
+class SpscWorkRing : public DeferredWorkRing {
+  public:
+    //! \brief ring over caller-provided entries
+    //!
+    //! \param entries: storage of capacity entries
+    //! \param capacity: number of entries, a power of two
+    SpscWorkRing(DeferredWork* entries, FwSizeType capacity);
+
+    //! \brief hand work to the consumer, from the one producer
+    //!
+    //! \return false, counting a dropped post, if the ring is full
+    bool post(DeferredWork::Handler handler, void* context = nullptr, U32 argument = 0);
+
+    //! \brief take the oldest work, from the consumer task
+    //!
+    //! \return false if the ring is empty
+    bool receive(DeferredWork& work);
+
+    //! \brief take the oldest work and run its handler, from the consumer task
+    //!
+    //! \return false if the ring is empty
+    bool runOne();
+
+    //! \brief get the number of work items waiting
+    FwSizeType getCount() const;
+
+  private:
+    DeferredWork* m_entries;     //!< ring storage
+    std::atomic<U32> m_head{0};  //!< index of the next entry to take, written by the consumer
+    std::atomic<U32> m_tail{0};  //!< index of the next entry to post, written by the producer
+};
+
+//! \brief SpscWorkRing with its storage
+template <FwSizeType CAPACITY>
+class SpscWorkRingStorage : public SpscWorkRing {
+    static_assert((CAPACITY > 0) and ((CAPACITY & (CAPACITY - 1)) == 0), "Capacity must be a power of two");
+
+  public:
+    SpscWorkRingStorage() : SpscWorkRing(m_entryStorage, CAPACITY) {}
+
+  private:
+    DeferredWork m_entryStorage[CAPACITY];  //!< entry storage
+};
+
+#if TASK_RUNNER_ISR_WAKEUPS
+//! \brief lock-free ring taking deferred work from several interrupt handlers to one cooperative task
+//!
+//! Same as `SpscWorkRing`, for producers that may preempt one another, such as interrupts of different priorities
+//! posting to the same task. Producers claim an entry with a compare-and-swap and publish it with a per-entry sequence
+//! number, so a producer preempted halfway never blocks the others. On a single core the consumer never sees such an
+//! entry, since interrupts return before tasks run; with producers on other cores it stops there and tries again on
+//! its next slice. Needs lock-free atomic compare-and-swap, which cores without exclusive access instructions (such as
+//! Cortex-M0) do not have: it is not declared there, so give each interrupt its own `SpscWorkRing`.
+class MpscWorkRing : public DeferredWorkRing {
+  public:
+    //! \brief entry of the ring
+    struct Slot {
+        std::atomic<U32> sequence{0};  //!< turn of the ring the slot is in, see the implementation
+        DeferredWork work;             //!< posted work
+    };
+
+    //! \brief ring over caller-provided slots
+    //!
+    //! \param slots: storage of capacity slots
+    //! \param capacity: number of slots, a power of two of at least 2
+    MpscWorkRing(Slot* slots, FwSizeType capacity);
+
+    //! \brief hand work to the consumer, from any producer
+    //!
+    //! \return false, counting a dropped post, if the ring is full
+    bool post(DeferredWork::Handler handler, void* context = nullptr, U32 argument = 0);
+
+    //! \brief take the oldest published work, from the consumer task
+    //!
+    //! \return false if no published work is waiting
+    bool receive(DeferredWork& work);
+
+    //! \brief take the oldest published work and run its handler, from the consumer task
+    //!
+    //! \return false if no published work is waiting
+    bool runOne();
+
+    //! \brief get the number of work items claimed by producers and not yet taken
+    FwSizeType getCount() const;
+
+  private:
+    Slot* m_slots;               //!< ring storage
+    std::atomic<U32> m_tail{0};  //!< next position to claim, shared by the producers
+    U32 m_head = 0;              //!< next position to take, owned by the consumer
+};
+
+//! \brief MpscWorkRing with its storage
+template <FwSizeType CAPACITY>
+class MpscWorkRingStorage : public MpscWorkRing {
+    static_assert((CAPACITY > 1) and ((CAPACITY & (CAPACITY - 1)) == 0),
+                  "Capacity must be a power of two of at least 2");
+
+  public:
+    MpscWorkRingStorage() : MpscWorkRing(m_slotStorage, CAPACITY) {}
+
+  private:
+    Slot m_slotStorage[CAPACITY];  //!< slot storage
+};
+#endif
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_DEFERREDWORK_DEFERREDWORK_HPP_ */
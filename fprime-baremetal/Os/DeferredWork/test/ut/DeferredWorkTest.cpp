@@ -0,0 +1,178 @@
+// ----------------------------------------------------------------------
+// DeferredWorkTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/Task.hpp>
+#include <fprime-baremetal/Os/DeferredWork/DeferredWork.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<U32> handled;
+
+void record(void* context, U32 argument) {
+    handled.push_back((*static_cast<U32*>(context) * 100) + argument);
+}
+
+template <class Ring>
+void consume(void* argument) {
+    static_cast<Ring*>(argument)->runOne();
+}
+
+template <class Ring>
+void startConsumer(Os::Task& task, Ring& ring) {
+    Fw::String name("consumer");
+    Os::Task::Arguments arguments(name, consume<Ring>, &ring, 10);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+}
+
+void expectHandled(const std::vector<U32>& expected) {
+    EXPECT_EQ(expected, handled);
+    handled.clear();
+}
+
+}  // namespace
+
+TEST(DeferredWork, SpscWakesConsumer) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Baremetal::SpscWorkRingStorage<4> ring;
+    Os::Task task;
+    startConsumer(task, ring);
+    U32 source = 1;
+
+    // The first unit of work binds the consumer, which then only runs for posted work
+    runner.run();
+    EXPECT_EQ(&task, ring.getConsumer());
+    EXPECT_FALSE(runner.hasReadyTask());
+    ASSERT_TRUE(ring.post(record, &source, 1));
+    ASSERT_TRUE(ring.post(record, &source, 2));
+    EXPECT_EQ(2, ring.getCount());
+    EXPECT_TRUE(runner.hasReadyTask());
+    runner.runAll();
+    runner.runAll();
+    expectHandled({101, 102});
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    // A full ring refuses posts and counts them
+    for (U32 argument = 0; argument < 4; argument++) {
+        ASSERT_TRUE(ring.post(record, &source, argument));
+    }
+    EXPECT_FALSE(ring.post(record, &source, 4));
+    EXPECT_EQ(1, ring.getDropped());
+    // Draining takes every post in one slice
+    runner.setDrain(&task, 8);
+    runner.run();
+    expectHandled({100, 101, 102, 103});
+    EXPECT_EQ(0, ring.getCount());
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    runner.removeTask(&task);
+}
+
+TEST(DeferredWork, MpscOrdersProducers) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Baremetal::MpscWorkRingStorage<4> ring;
+    Os::Task task;
+    startConsumer(task, ring);
+    U32 sources[2] = {1, 2};
+
+    runner.run();
+    ASSERT_TRUE(ring.post(record, &sources[0], 1));
+    ASSERT_TRUE(ring.post(record, &sources[1], 1));
+    ASSERT_TRUE(ring.post(record, &sources[0], 2));
+    runner.runAll();
+    runner.runAll();
+    runner.runAll();
+    expectHandled({101, 201, 102});
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    // The ring is reused turn after turn
+    for (U32 turn = 0; turn < 3; turn++) {
+        for (U32 argument = 0; argument < 4; argument++) {
+            ASSERT_TRUE(ring.post(record, &sources[turn % 2], argument));
+        }
+        EXPECT_FALSE(ring.post(record, &sources[0], 0));
+        for (U32 argument = 0; argument < 4; argument++) {
+            EXPECT_TRUE(ring.runOne());
+        }
+        EXPECT_FALSE(ring.runOne());
+        const U32 base = sources[turn % 2] * 100;
+        expectHandled({base, base + 1, base + 2, base + 3});
+    }
+    EXPECT_EQ(3, ring.getDropped());
+
+    runner.removeTask(&task);
+}
+
+TEST(DeferredWork, SmallestRingsFill) {
+    Os::Baremetal::SpscWorkRingStorage<1> spsc;
+    Os::Baremetal::MpscWorkRingStorage<2> mpsc;
+    U32 source = 1;
+
+    // A full ring refuses the next post and gives its work back in order, turn after turn
+    for (U32 turn = 0; turn < 3; turn++) {
+        ASSERT_TRUE(spsc.post(record, &source, turn));
+        EXPECT_FALSE(spsc.post(record, &source, 9));
+        EXPECT_TRUE(spsc.runOne());
+        EXPECT_FALSE(spsc.runOne());
+        expectHandled({100 + turn});
+
+        ASSERT_TRUE(mpsc.post(record, &source, turn));
+        ASSERT_TRUE(mpsc.post(record, &source, turn + 1));
+        EXPECT_FALSE(mpsc.post(record, &source, 9));
+        EXPECT_EQ(2, mpsc.getCount());
+        EXPECT_TRUE(mpsc.runOne());
+        EXPECT_TRUE(mpsc.runOne());
+        EXPECT_FALSE(mpsc.runOne());
+        expectHandled({100 + turn, 101 + turn});
+    }
+    EXPECT_EQ(3, spsc.getDropped());
+    EXPECT_EQ(3, mpsc.getDropped());
+}
+
+namespace {
+
+std::atomic<U32> counted{0};
+
+void count(void*, U32 argument) {
+    counted.fetch_add(argument, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+TEST(DeferredWork, MpscConcurrentProducers) {
+    // Producers on other threads stand in for interrupts of different priorities
+    Os::Baremetal::MpscWorkRingStorage<64> ring;
+    constexpr U32 PRODUCERS = 4;
+    constexpr U32 POSTS = 2000;
+    std::vector<std::thread> producers;
+    for (U32 producer = 0; producer < PRODUCERS; producer++) {
+        producers.emplace_back([&ring]() {
+            for (U32 post = 0; post < POSTS; post++) {
+                while (not ring.post(count, nullptr, 1)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    U32 received = 0;
+    while (received < (PRODUCERS * POSTS)) {
+        if (ring.runOne()) {
+            received++;
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(PRODUCERS * POSTS, counted.load());
+    EXPECT_FALSE(ring.runOne());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,231 @@
+// ======================================================================
+// \title fprime-baremetal/Os/FileQueue/FileQueue.cpp
+// \brief FileQueue implementations
+// ======================================================================
+#include <fprime-baremetal/Os/FileQueue/FileQueue.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+FileQueue::FileQueue(Entry* entries, FwSizeType capacity, U8* chunk, FwSizeType chunkSize)
+    : m_entries(entries),
+      m_capacity(capacity),
+      m_chunk(chunk),
+      m_chunkSize(chunkSize),
+      m_head(0),
+      m_count(0),
+      m_nextTicket(0),
+      m_retired(0),
+      m_opened(false),
+      m_done(0) {
+    FW_ASSERT(entries != nullptr);
+    FW_ASSERT(chunk != nullptr);
+    FW_ASSERT(capacity > 0);
+    FW_ASSERT(chunkSize > 0);
+}
+
+Os::Task::Status FileQueue::start(const Fw::StringBase& name, FwTaskPriorityType priority) {
+    Os::Task::Arguments arguments(name, FileQueue::taskRoutine, this, priority);
+    return this->m_task.start(arguments);
+}
+
+FileQueue::Status FileQueue::submitWrite(const char* path,
+                                         const U8* data,
+                                         FwSizeType size,
+                                         Ticket& ticket,
+                                         Callback callback,
+                                         void* context) {
+    FW_ASSERT(path != nullptr);
+    FW_ASSERT((data != nullptr) or (size == 0));
+    Entry entry = {OPERATION_WRITE, path, nullptr, data, nullptr, 0, size, callback, context, 0};
+    return this->submit(entry, ticket);
+}
+
+FileQueue::Status FileQueue::submitAppend(const char* path,
+                                          const U8* data,
+                                          FwSizeType size,
+                                          Ticket& ticket,
+                                          Callback callback,
+                                          void* context) {
+    FW_ASSERT(path != nullptr);
+    FW_ASSERT((data != nullptr) or (size == 0));
+    Entry entry = {OPERATION_APPEND, path, nullptr, data, nullptr, 0, size, callback, context, 0};
+    return this->submit(entry, ticket);
+}
+
+FileQueue::Status FileQueue::submitRead(const char* path,
+                                        U8* buffer,
+                                        FwSizeType size,
+                                        Ticket& ticket,
+                                        Callback callback,
+                                        void* context) {
+    FW_ASSERT(path != nullptr);
+    FW_ASSERT((buffer != nullptr) or (size == 0));
+    Entry entry = {OPERATION_READ, path, nullptr, nullptr, buffer, 0, size, callback, context, 0};
+    return this->submit(entry, ticket);
+}
+
+FileQueue::Status FileQueue::submitCopy(const char* sourcePath,
+                                        const char* destPath,
+                                        Ticket& ticket,
+                                        Callback callback,
+                                        void* context) {
+    FW_ASSERT(sourcePath != nullptr);
+    FW_ASSERT(destPath != nullptr);
+    Entry entry = {OPERATION_COPY, destPath, sourcePath, nullptr, nullptr, 0, 0, callback, context, 0};
+    return this->submit(entry, ticket);
+}
+
+FileQueue::Status FileQueue::submitPreallocate(const char* path,
+                                               FwSizeType offset,
+                                               FwSizeType length,
+                                               Ticket& ticket,
+                                               Callback callback,
+                                               void* context) {
+    FW_ASSERT(path != nullptr);
+    Entry entry = {OPERATION_PREALLOCATE, path, nullptr, nullptr, nullptr, offset, length, callback, context, 0};
+    return this->submit(entry, ticket);
+}
+
+bool FileQueue::isComplete(Ticket ticket) const {
+    // pending tickets are the ones in [m_retired, m_nextTicket). Unsigned differences keep this right across wraps
+    return static_cast<Ticket>(ticket - this->m_retired) >= static_cast<Ticket>(this->m_nextTicket - this->m_retired);
+}
+
+FwSizeType FileQueue::getPending() const {
+    return this->m_count;
+}
+
+void FileQueue::runChunk() {
+    if (this->m_count == 0) {
+        return;
+    }
+    const Entry& entry = this->m_entries[this->m_head];
+
+    Os::File::Status status = Os::File::OP_OK;
+    bool finished = false;
+    if (not this->m_opened) {
+        this->m_done = 0;
+        status = this->openFiles(entry);
+        this->m_opened = true;
+    }
+    // opening counts as the work of this slice when it failed, otherwise the first chunk runs as well
+    if (status == Os::File::OP_OK) {
+        status = this->runStep(entry, finished);
+    }
+    if ((status != Os::File::OP_OK) or finished) {
+        this->complete(status);
+    }
+}
+
+void FileQueue::taskRoutine(void* queue) {
+    FW_ASSERT(queue != nullptr);
+    static_cast<FileQueue*>(queue)->runChunk();
+}
+
+FileQueue::Status FileQueue::submit(Entry& entry, Ticket& ticket) {
+    if (this->m_count == this->m_capacity) {
+        return QUEUE_FULL;
+    }
+    entry.ticket = this->m_nextTicket++;
+    this->m_entries[(this->m_head + this->m_count) % this->m_capacity] = entry;
+    this->m_count++;
+    ticket = entry.ticket;
+    return OP_OK;
+}
+
+Os::File::Status FileQueue::openFiles(const Entry& entry) {
+    switch (entry.operation) {
+        case OPERATION_WRITE:
+            return this->m_file.open(entry.path, Os::File::OPEN_CREATE, Os::File::OVERWRITE);
+        case OPERATION_APPEND:
+            return this->m_file.open(entry.path, Os::File::OPEN_APPEND);
+        case OPERATION_READ:
+            return this->m_file.open(entry.path, Os::File::OPEN_READ);
+        case OPERATION_COPY: {
+            const Os::File::Status status = this->m_file.open(entry.sourcePath, Os::File::OPEN_READ);
+            if (status != Os::File::OP_OK) {
+                return status;
+            }
+            return this->m_destination.open(entry.path, Os::File::OPEN_CREATE, Os::File::OVERWRITE);
+        }
+        case OPERATION_PREALLOCATE:
+            return this->m_file.open(entry.path, Os::File::OPEN_WRITE);
+        default:
+            FW_ASSERT(0, entry.operation);
+            return Os::File::OTHER_ERROR;
+    }
+}
+
+Os::File::Status FileQueue::runStep(const Entry& entry, bool& finished) {
+    Os::File::Status status = Os::File::OP_OK;
+    const FwSizeType remaining = entry.size - this->m_done;
+    const FwSizeType requested = (remaining < this->m_chunkSize) ? remaining : this->m_chunkSize;
+    FwSizeType size = requested;
+
+    switch (entry.operation) {
+        case OPERATION_WRITE:
+        case OPERATION_APPEND:
+            if (size > 0) {
+                status = this->m_file.write(&entry.writeData[this->m_done], size);
+            }
+            this->m_done += size;
+            // a short write means the file is full
+            finished = (this->m_done == entry.size) or (size < requested);
+            break;
+        case OPERATION_READ:
+            if (size > 0) {
+                status = this->m_file.read(&entry.readData[this->m_done], size);
+            }
+            this->m_done += size;
+            // a short read means the end of the file
+            finished = (this->m_done == entry.size) or (size < requested);
+            break;
+        case OPERATION_COPY: {
+            size = this->m_chunkSize;
+            status = this->m_file.read(this->m_chunk, size);
+            if ((status != Os::File::OP_OK) or (size == 0)) {
+                finished = true;
+                break;
+            }
+            FwSizeType written = size;
+            status = this->m_destination.write(this->m_chunk, written);
+            this->m_done += written;
+            finished = (written < size);
+            break;
+        }
+        case OPERATION_PREALLOCATE:
+            if (size > 0) {
+                status = this->m_file.preallocate(entry.offset + this->m_done, size);
+            }
+            this->m_done += size;
+            finished = (this->m_done == entry.size);
+            break;
+        default:
+            FW_ASSERT(0, entry.operation);
+            break;
+    }
+    return status;
+}
+
+void FileQueue::complete(Os::File::Status status) {
+    const Entry entry = this->m_entries[this->m_head];
+    if (this->m_file.isOpen()) {
+        this->m_file.close();
+    }
+    if (this->m_destination.isOpen()) {
+        this->m_destination.close();
+    }
+    this->m_opened = false;
+    this->m_head = (this->m_head + 1) % this->m_capacity;
+    this->m_count--;
+    this->m_retired++;
+
+    // called last, so the callback can submit the next operation
+    if (entry.callback != nullptr) {
+        entry.callback(entry.context, entry.ticket, status, this->m_done);
+    }
+}
+
+}  // End namespace Baremetal
+}  // End Namespace Os
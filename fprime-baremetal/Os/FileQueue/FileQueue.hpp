@@ -0,0 +1,184 @@
+// ======================================================================
+// \title fprime-baremetal/Os/FileQueue/FileQueue.hpp
+// \brief FileQueue definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_FILEQUEUE_FILEQUEUE_HPP_
+#define FPRIME_BAREMETAL_FILEQUEUE_FILEQUEUE_HPP_
+#include <Fw/Types/Assert.hpp>
+#include <Os/File.hpp>
+#include <Os/Task.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief a queue of file operations run in bounded chunks by a cooperative task
+//!
+//! In a cooperative system a large write, copy or preallocate runs to completion inside a single task slice and
+//! holds off every other task. Operations submitted to this queue are instead run by the queue's own cooperative task,
+//! at most one chunk of `chunkSize` bytes per slice, so the worst-case slice stays bounded while the operation makes
+//! progress in the background.
+//!
+//! Operations run one after the other in submission order. Each submission returns a ticket that can be polled with
+//! `isComplete`, and an optional callback is called from the queue task with the final status and byte count. Paths
+//! and data buffers are not copied and must stay valid until the operation completes.
+//!
+//! ```c++
+//! static Os::Baremetal::FileQueueStorage<8, 512> fileQueue;
+//! fileQueue.start(Fw::String("FileQueue"), 10);
+//!
+//! Os::Baremetal::FileQueue::Ticket ticket;
+//! fileQueue.submitCopy("/bin0/file0", "/bin1/file0", ticket, onCopyDone, this);
+//! ```
+class FileQueue {
+  public:
+    typedef U32 Ticket;  //!< identifies a submitted operation
+
+    enum Status {
+        OP_OK,       //!< operation queued
+        QUEUE_FULL,  //!< no room for another operation
+    };
+
+    //! \brief called from the queue task when an operation completes
+    //!
+    //! \param context: context given at submission
+    //! \param ticket: ticket of the operation
+    //! \param status: status of the first file call that failed, or OP_OK
+    //! \param size: bytes written, read, copied or preallocated
+    typedef void (*Callback)(void* context, Ticket ticket, Os::File::Status status, FwSizeType size);
+
+    enum Operation {
+        OPERATION_WRITE,        //!< write a buffer to a new or truncated file
+        OPERATION_APPEND,       //!< write a buffer to the end of a file
+        OPERATION_READ,         //!< read the start of a file into a buffer
+        OPERATION_COPY,         //!< copy a file to a new or truncated file
+        OPERATION_PREALLOCATE,  //!< preallocate a range of a file
+    };
+
+    struct Entry {
+        Operation operation;     //!< operation to run
+        const char* path;        //!< file operated on, or destination of a copy
+        const char* sourcePath;  //!< source of a copy
+        const U8* writeData;     //!< data to write
+        U8* readData;            //!< destination of a read
+        FwSizeType offset;       //!< start of a preallocation
+        FwSizeType size;         //!< bytes to write, read or preallocate
+        Callback callback;       //!< completion callback, or nullptr
+        void* context;           //!< completion callback context
+        Ticket ticket;           //!< ticket of the operation
+    };
+
+    //! \brief construct a queue over entry and chunk storage
+    //!
+    //! \param entries: storage for capacity entries
+    //! \param capacity: maximum number of queued operations
+    //! \param chunk: storage for chunkSize bytes, used to copy files
+    //! \param chunkSize: maximum number of bytes handled per task slice
+    FileQueue(Entry* entries, FwSizeType capacity, U8* chunk, FwSizeType chunkSize);
+
+    //! \brief start the cooperative task running the queue
+    //!
+    //! \param name: task name
+    //! \param priority: task priority
+    //! \return status of the task start
+    Os::Task::Status start(const Fw::StringBase& name, FwTaskPriorityType priority);
+
+    //! \brief queue a write of a buffer to a new or truncated file
+    Status submitWrite(const char* path,
+                       const U8* data,
+                       FwSizeType size,
+                       Ticket& ticket,
+                       Callback callback = nullptr,
+                       void* context = nullptr);
+
+    //! \brief queue a write of a buffer to the end of a file
+    Status submitAppend(const char* path,
+                        const U8* data,
+                        FwSizeType size,
+                        Ticket& ticket,
+                        Callback callback = nullptr,
+                        void* context = nullptr);
+
+    //! \brief queue a read of up to size bytes from the start of a file
+    Status submitRead(const char* path,
+                      U8* buffer,
+                      FwSizeType size,
+                      Ticket& ticket,
+                      Callback callback = nullptr,
+                      void* context = nullptr);
+
+    //! \brief queue a copy of a file to a new or truncated file
+    Status submitCopy(const char* sourcePath,
+                      const char* destPath,
+                      Ticket& ticket,
+                      Callback callback = nullptr,
+                      void* context = nullptr);
+
+    //! \brief queue a preallocation of a range of a file
+    Status submitPreallocate(const char* path,
+                             FwSizeType offset,
+                             FwSizeType length,
+                             Ticket& ticket,
+                             Callback callback = nullptr,
+                             void* context = nullptr);
+
+    //! \brief check whether an operation has completed
+    bool isComplete(Ticket ticket) const;
+
+    //! \brief number of operations queued or running
+    FwSizeType getPending() const;
+
+    //! \brief run one chunk of the operation at the head of the queue
+    //!
+    //! This is the unit of work of the queue task. It may also be called directly when no task is used.
+    void runChunk();
+
+  private:
+    //! \brief routine of the queue task
+    static void taskRoutine(void* queue);
+
+    //! \brief add an entry at the tail of the queue
+    Status submit(Entry& entry, Ticket& ticket);
+
+    //! \brief open the files of the head entry
+    Os::File::Status openFiles(const Entry& entry);
+
+    //! \brief run one chunk of the head entry
+    //!
+    //! \param entry: head entry
+    //! \param finished: set once the operation has no more chunks
+    Os::File::Status runStep(const Entry& entry, bool& finished);
+
+    //! \brief close the files, retire the head entry and call its callback
+    void complete(Os::File::Status status);
+
+    Entry* m_entries;        //!< entry storage
+    FwSizeType m_capacity;   //!< number of entries
+    U8* m_chunk;             //!< copy buffer
+    FwSizeType m_chunkSize;  //!< bytes handled per slice
+    FwSizeType m_head;       //!< index of the running entry
+    FwSizeType m_count;      //!< number of queued entries
+    Ticket m_nextTicket;     //!< ticket of the next submission
+    Ticket m_retired;        //!< number of completed operations
+    bool m_opened;           //!< files of the head entry are open
+    FwSizeType m_done;       //!< bytes handled for the head entry
+    Os::File m_file;         //!< file operated on, or source of a copy
+    Os::File m_destination;  //!< destination of a copy
+    Os::Task m_task;         //!< cooperative task running the queue
+};
+
+//! \brief file queue with its own storage for CAPACITY operations and chunks of CHUNK_SIZE bytes
+template <FwSizeType CAPACITY, FwSizeType CHUNK_SIZE>
+class FileQueueStorage : public FileQueue {
+    static_assert(CAPACITY > 0, "Queue needs at least one entry");
+    static_assert(CHUNK_SIZE > 0, "Chunks must not be empty");
+
+  public:
+    FileQueueStorage() : FileQueue(m_entryStorage, CAPACITY, m_chunkStorage, CHUNK_SIZE) {}
+
+  private:
+    Entry m_entryStorage[CAPACITY];  //!< entry storage
+    U8 m_chunkStorage[CHUNK_SIZE];   //!< copy buffer
+};
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_FILEQUEUE_FILEQUEUE_HPP_ */
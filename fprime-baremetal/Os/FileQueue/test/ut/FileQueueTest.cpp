@@ -0,0 +1,156 @@
+// ----------------------------------------------------------------------
+// FileQueueTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Test/UnitTest.hpp>
+#include <Fw/Types/MallocAllocator.hpp>
+#include <Os/File.hpp>
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFs.hpp>
+#include <fprime-baremetal/Os/FileQueue/FileQueue.hpp>
+
+#include <cstring>
+
+namespace {
+
+const FwSizeType CHUNK_SIZE = 64;
+const FwSizeType FILE_SIZE = 1000;
+
+struct Completion {
+    FwSizeType calls;
+    Os::Baremetal::FileQueue::Ticket ticket;
+    Os::File::Status status;
+    FwSizeType size;
+};
+
+void onComplete(void* context, Os::Baremetal::FileQueue::Ticket ticket, Os::File::Status status, FwSizeType size) {
+    Completion& completion = *static_cast<Completion*>(context);
+    completion.calls++;
+    completion.ticket = ticket;
+    completion.status = status;
+    completion.size = size;
+}
+
+//! run the queue until it is empty, returning the number of slices used
+FwSizeType drain(Os::Baremetal::FileQueue& queue) {
+    FwSizeType slices = 0;
+    while (queue.getPending() > 0) {
+        queue.runChunk();
+        slices++;
+    }
+    return slices;
+}
+
+//! size of a file, or 0 if it can't be opened
+FwSizeType fileSize(const char* path) {
+    Os::File file;
+    FwSizeType size = 0;
+    if (file.open(path, Os::File::OPEN_READ) == Os::File::OP_OK) {
+        (void)file.size(size);
+    }
+    return size;
+}
+
+class FileQueueTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        Os::Baremetal::MicroFs::MicroFsSetCfgBins(this->cfg, 1);
+        Os::Baremetal::MicroFs::MicroFsAddBin(this->cfg, 0, FILE_SIZE, 4);
+        Os::Baremetal::MicroFs::MicroFsInit(this->cfg, 0, this->alloc);
+    }
+
+    void TearDown() override { Os::Baremetal::MicroFs::MicroFsCleanup(0, this->alloc); }
+
+    Fw::MallocAllocator alloc;
+    Os::Baremetal::MicroFs::MicroFsConfig cfg;
+};
+
+}  // namespace
+
+TEST_F(FileQueueTest, ChunkedWriteCopyRead) {
+    COMMENT("Large operations are split into chunks, one per slice, and complete in order.");
+
+    Os::Baremetal::FileQueueStorage<4, CHUNK_SIZE> queue;
+    U8 data[FILE_SIZE];
+    for (FwSizeType i = 0; i < FILE_SIZE; i++) {
+        data[i] = static_cast<U8>(i * 3);
+    }
+
+    Completion writeDone = {};
+    Completion copyDone = {};
+    Os::Baremetal::FileQueue::Ticket writeTicket = 0;
+    Os::Baremetal::FileQueue::Ticket copyTicket = 0;
+    ASSERT_EQ(Os::Baremetal::FileQueue::OP_OK,
+              queue.submitWrite("/bin0/file0", data, FILE_SIZE, writeTicket, onComplete, &writeDone));
+    ASSERT_EQ(Os::Baremetal::FileQueue::OP_OK,
+              queue.submitCopy("/bin0/file0", "/bin0/file1", copyTicket, onComplete, &copyDone));
+    ASSERT_EQ(2, queue.getPending());
+    ASSERT_FALSE(queue.isComplete(writeTicket));
+    ASSERT_FALSE(queue.isComplete(copyTicket));
+
+    // The first slice only writes one chunk
+    queue.runChunk();
+    ASSERT_EQ(CHUNK_SIZE, fileSize("/bin0/file0"));
+    ASSERT_EQ(0, writeDone.calls);
+
+    // The write needs ceil(1000 / 64) = 16 slices, the copy 16 more plus one to find the end of the source
+    ASSERT_EQ(15 + 17, drain(queue));
+    ASSERT_TRUE(queue.isComplete(writeTicket));
+    ASSERT_TRUE(queue.isComplete(copyTicket));
+    ASSERT_EQ(1, writeDone.calls);
+    ASSERT_EQ(writeTicket, writeDone.ticket);
+    ASSERT_EQ(Os::File::OP_OK, writeDone.status);
+    ASSERT_EQ(FILE_SIZE, writeDone.size);
+    ASSERT_EQ(1, copyDone.calls);
+    ASSERT_EQ(Os::File::OP_OK, copyDone.status);
+    ASSERT_EQ(FILE_SIZE, copyDone.size);
+
+    // Read the copy back through the queue
+    U8 readBack[FILE_SIZE + 10];
+    Completion readDone = {};
+    Os::Baremetal::FileQueue::Ticket readTicket = 0;
+    ASSERT_EQ(Os::Baremetal::FileQueue::OP_OK,
+              queue.submitRead("/bin0/file1", readBack, sizeof(readBack), readTicket, onComplete, &readDone));
+    ASSERT_EQ(16, drain(queue));
+    ASSERT_EQ(Os::File::OP_OK, readDone.status);
+    ASSERT_EQ(FILE_SIZE, readDone.size);
+    ASSERT_EQ(0, memcmp(data, readBack, FILE_SIZE));
+}
+
+TEST_F(FileQueueTest, FullQueueAndErrors) {
+    COMMENT("A full queue rejects submissions and failures are reported to the callback.");
+
+    Os::Baremetal::FileQueueStorage<2, CHUNK_SIZE> queue;
+    U8 buffer[CHUNK_SIZE];
+    Completion readDone = {};
+    Completion allocDone = {};
+    Os::Baremetal::FileQueue::Ticket ticket = 0;
+    ASSERT_EQ(Os::Baremetal::FileQueue::OP_OK,
+              queue.submitRead("/bin0/file3", buffer, sizeof(buffer), ticket, onComplete, &readDone));
+    ASSERT_EQ(Os::Baremetal::FileQueue::OP_OK,
+              queue.submitPreallocate("/bin0/file2", 0, FILE_SIZE / 2, ticket, onComplete, &allocDone));
+    ASSERT_EQ(Os::Baremetal::FileQueue::QUEUE_FULL, queue.submitRead("/bin0/file3", buffer, sizeof(buffer), ticket));
+
+    // Reading a file that doesn't exist fails in the first slice
+    queue.runChunk();
+    ASSERT_EQ(1, readDone.calls);
+    ASSERT_EQ(Os::File::DOESNT_EXIST, readDone.status);
+    ASSERT_EQ(0, readDone.size);
+    ASSERT_EQ(1, queue.getPending());
+
+    // Preallocation is chunked as well: ceil(500 / 64) = 8 slices
+    ASSERT_EQ(8, drain(queue));
+    ASSERT_EQ(Os::File::OP_OK, allocDone.status);
+    ASSERT_EQ(FILE_SIZE / 2, allocDone.size);
+    ASSERT_EQ(FILE_SIZE / 2, fileSize("/bin0/file2"));
+
+    // Running an empty queue does nothing
+    queue.runChunk();
+    ASSERT_EQ(0, queue.getPending());
+    ASSERT_TRUE(queue.isComplete(ticket));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+// ======================================================================
+// \title fprime-baremetal/Os/HeapStats/HeapStats.cpp
+// \brief HeapStats implementations
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/HeapStats/HeapStats.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+HeapUsage HeapStats::s_usage;
+FwSizeType HeapStats::s_capacity = 0;
+
+void HeapStats::setCapacity(FwSizeType bytes) {
+    s_capacity = bytes;
+}
+
+void HeapStats::setCapacity(const void* start, const void* end) {
+    const PlatformPointerCastType first = reinterpret_cast<PlatformPointerCastType>(start);
+    const PlatformPointerCastType last = reinterpret_cast<PlatformPointerCastType>(end);
+    FW_ASSERT(last >= first);
+    s_capacity = static_cast<FwSizeType>(last - first);
+}
+
+FwSizeType HeapStats::getCapacity() {
+    return s_capacity;
+}
+
+void HeapStats::getUsage(HeapUsage& usage) {
+    usage = s_usage;
+}
+
+void HeapStats::onAllocate(FwSizeType size) {
+    s_usage.currentBytes += size;
+    s_usage.liveAllocations++;
+    s_usage.allocations++;
+    if (s_usage.currentBytes > s_usage.peakBytes) {
+        s_usage.peakBytes = s_usage.currentBytes;
+    }
+    if (size > s_usage.largestAllocation) {
+        s_usage.largestAllocation = size;
+    }
+}
+
+void HeapStats::onDeallocate(FwSizeType size) {
+    FW_ASSERT(s_usage.liveAllocations > 0);
+    FW_ASSERT(s_usage.currentBytes >= size, static_cast<FwAssertArgType>(size));
+    s_usage.currentBytes -= size;
+    s_usage.liveAllocations--;
+}
+
+void HeapStats::onFailure(FwSizeType size) {
+    s_usage.failures++;
+    if ((s_capacity > s_usage.currentBytes) and ((s_capacity - s_usage.currentBytes) >= size)) {
+        s_usage.fragmentedFailures++;
+    }
+}
+
+void HeapStats::reset() {
+    s_usage = HeapUsage();
+}
+
+AccountingAllocator::AccountingAllocator(Fw::MemAllocator& allocator) : m_allocator(allocator) {}
+
+void* AccountingAllocator::allocate(const FwEnumStoreType identifier,
+                                    FwSizeType& size,
+                                    bool& recoverable,
+                                    FwSizeType alignment) {
+    FW_ASSERT((alignment != 0) and ((alignment & (alignment - 1)) == 0), static_cast<FwAssertArgType>(alignment));
+    // The header goes in front of the memory, padded so the memory keeps the requested alignment
+    if (alignment < alignof(Header)) {
+        alignment = alignof(Header);
+    }
+    const FwSizeType offset = ((sizeof(Header) + alignment - 1) / alignment) * alignment;
+    const FwSizeType requested = size;
+    FwSizeType total = requested + offset;
+    U8* base = static_cast<U8*>(this->m_allocator.allocate(identifier, total, recoverable, alignment));
+    if ((base == nullptr) or (total < (requested + offset))) {
+        if (base != nullptr) {
+            this->m_allocator.deallocate(identifier, base);
+        }
+        HeapStats::onFailure(requested);
+        size = 0;
+        return nullptr;
+    }
+    U8* memory = base + offset;
+    Header* header = reinterpret_cast<Header*>(memory - sizeof(Header));
+    header->size = requested;
+    header->offset = offset;
+    HeapStats::onAllocate(requested);
+    return memory;
+}
+
+void AccountingAllocator::deallocate(const FwEnumStoreType identifier, void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    U8* memory = static_cast<U8*>(ptr);
+    const Header* header = reinterpret_cast<const Header*>(memory - sizeof(Header));
+    HeapStats::onDeallocate(header->size);
+    this->m_allocator.deallocate(identifier, memory - header->offset);
+}
+
+}  // namespace Baremetal
+}  // namespace Os
@@ -0,0 +1,96 @@
+// ======================================================================
+// \title fprime-baremetal/Os/HeapStats/HeapStats.hpp
+// \brief HeapStats definitions
+// ======================================================================
+#ifndef OS_Baremetal_HeapStats_HPP
+#define OS_Baremetal_HeapStats_HPP
+
+#include <Fw/Types/MemAllocator.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief heap usage counted by `HeapStats`
+struct HeapUsage {
+    FwSizeType currentBytes = 0;        //!< bytes allocated and not yet freed
+    FwSizeType peakBytes = 0;           //!< highest value of currentBytes
+    FwSizeType liveAllocations = 0;     //!< allocations not yet freed
+    FwSizeType allocations = 0;         //!< allocations made
+    FwSizeType largestAllocation = 0;   //!< largest single allocation
+    FwSizeType failures = 0;            //!< allocations that failed
+    FwSizeType fragmentedFailures = 0;  //!< failed allocations that fit in the free part of the heap capacity
+};
+
+//! \brief live accounting of the heap allocations made through `AccountingAllocator`
+//!
+//! The counts cover the allocations made by the overridden `operator new`/`delete` of OverrideNewDelete and by any
+//! component given `OverrideNewDelete::getMemAllocator`. A failed allocation while the heap capacity has room for it
+//! means the free memory is split into pieces that are too small, so `fragmentedFailures` flags fragmentation before
+//! the heap is actually full.
+class HeapStats {
+  public:
+    //! \brief set the size of the heap, for example from linker symbols
+    //!
+    //! \param bytes: heap size, 0 when unknown
+    static void setCapacity(FwSizeType bytes);
+
+    //! \brief set the size of the heap from its bounds, such as the heap symbols of a linker script
+    //!
+    //! \param start: first byte of the heap
+    //! \param end: byte past the end of the heap, not before start
+    static void setCapacity(const void* start, const void* end);
+
+    //! \brief get the size of the heap, 0 when unknown
+    static FwSizeType getCapacity();
+
+    //! \brief copy the current counts
+    static void getUsage(HeapUsage& usage);
+
+    //! \brief count an allocation
+    static void onAllocate(FwSizeType size);
+
+    //! \brief count the release of an allocation
+    static void onDeallocate(FwSizeType size);
+
+    //! \brief count a failed allocation
+    static void onFailure(FwSizeType size);
+
+    //! \brief reset all counts, leaving the capacity
+    static void reset();
+
+  private:
+    static HeapUsage s_usage;      //!< counts since startup
+    static FwSizeType s_capacity;  //!< heap size
+};
+
+//! \brief memory allocator counting the allocations of another allocator in `HeapStats`
+//!
+//! Each allocation carries a small header holding its size, so it can be counted when freed. Memory must be freed
+//! through the same `AccountingAllocator` that allocated it.
+class AccountingAllocator : public Fw::MemAllocator {
+  public:
+    //! \brief wrap an allocator
+    explicit AccountingAllocator(Fw::MemAllocator& allocator);
+
+    //! \brief allocate memory through the wrapped allocator and count it
+    void* allocate(const FwEnumStoreType identifier,
+                   FwSizeType& size,
+                   bool& recoverable,
+                   FwSizeType alignment = alignof(std::max_align_t)) override;
+
+    //! \brief count and free memory allocated by this allocator
+    void deallocate(const FwEnumStoreType identifier, void* ptr) override;
+
+  private:
+    //! \brief header placed right before each allocation
+    struct Header {
+        FwSizeType size;    //!< bytes given to the caller
+        FwSizeType offset;  //!< distance from the start of the wrapped allocation
+    };
+
+    Fw::MemAllocator& m_allocator;  //!< wrapped allocator
+};
+
+}  // namespace Baremetal
+}  // namespace Os
+#endif  // OS_Baremetal_HeapStats_HPP
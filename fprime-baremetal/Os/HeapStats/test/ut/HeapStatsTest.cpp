@@ -0,0 +1,93 @@
+// ----------------------------------------------------------------------
+// HeapStatsTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/MallocAllocator.hpp>
+#include <fprime-baremetal/Os/HeapStats/HeapStats.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+//! allocator refusing every allocation, as a fragmented heap would
+class FullAllocator : public Fw::MemAllocator {
+  public:
+    void* allocate(const FwEnumStoreType identifier,
+                   FwSizeType& size,
+                   bool& recoverable,
+                   FwSizeType alignment) override {
+        size = 0;
+        recoverable = true;
+        return nullptr;
+    }
+    void deallocate(const FwEnumStoreType identifier, void* ptr) override {}
+};
+
+}  // namespace
+
+TEST(HeapStats, CountsLiveAllocations) {
+    Os::Baremetal::HeapStats::reset();
+    Fw::MallocAllocator malloc;
+    Os::Baremetal::AccountingAllocator allocator(malloc);
+    bool recoverable = false;
+
+    FwSizeType size = 100;
+    void* first = allocator.allocate(0, size, recoverable);
+    ASSERT_NE(nullptr, first);
+    ASSERT_EQ(100, size);
+    size = 40;
+    void* second = allocator.allocate(0, size, recoverable);
+    ASSERT_NE(nullptr, second);
+    // The size header keeps the alignment of the wrapped allocator
+    ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(second) % alignof(std::max_align_t));
+
+    Os::Baremetal::HeapUsage usage;
+    Os::Baremetal::HeapStats::getUsage(usage);
+    EXPECT_EQ(140, usage.currentBytes);
+    EXPECT_EQ(140, usage.peakBytes);
+    EXPECT_EQ(2, usage.liveAllocations);
+    EXPECT_EQ(100, usage.largestAllocation);
+
+    // Freeing lowers the current bytes and leaves the peak
+    allocator.deallocate(0, first);
+    allocator.deallocate(0, nullptr);
+    Os::Baremetal::HeapStats::getUsage(usage);
+    EXPECT_EQ(40, usage.currentBytes);
+    EXPECT_EQ(140, usage.peakBytes);
+    EXPECT_EQ(1, usage.liveAllocations);
+    EXPECT_EQ(2, usage.allocations);
+
+    allocator.deallocate(0, second);
+    Os::Baremetal::HeapStats::getUsage(usage);
+    EXPECT_EQ(0, usage.currentBytes);
+    EXPECT_EQ(0, usage.liveAllocations);
+}
+
+TEST(HeapStats, FlagsFragmentedFailures) {
+    Os::Baremetal::HeapStats::reset();
+    Os::Baremetal::HeapStats::setCapacity(1000);
+    FullAllocator full;
+    Os::Baremetal::AccountingAllocator allocator(full);
+    bool recoverable = false;
+
+    // The heap has room for both, so the failures come from fragmentation
+    FwSizeType size = 10;
+    ASSERT_EQ(nullptr, allocator.allocate(0, size, recoverable));
+    ASSERT_EQ(0, size);
+    size = 2000;
+    ASSERT_EQ(nullptr, allocator.allocate(0, size, recoverable));
+
+    Os::Baremetal::HeapUsage usage;
+    Os::Baremetal::HeapStats::getUsage(usage);
+    EXPECT_EQ(2, usage.failures);
+    EXPECT_EQ(1, usage.fragmentedFailures);
+    EXPECT_EQ(0, usage.allocations);
+    Os::Baremetal::HeapStats::setCapacity(0);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,264 @@
+// ======================================================================
+// \title fprime-baremetal/Os/MultiTaskRunner/MultiTaskRunner.cpp
+// \brief MultiTaskRunner implementations
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/Task.hpp>
+#include <fprime-baremetal/Os/MultiTaskRunner/MultiTaskRunner.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+
+#include <chrono>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief task whose unit of work the calling worker thread is running
+static thread_local Task* s_currentTask = nullptr;
+
+MultiTaskRunner::MultiTaskRunner() : m_sleeping(0), m_running(false), m_workerCount(0) {
+    for (FwSizeType i = 0; i < TASK_RUNNER_CAPACITY; i++) {
+        this->m_slots[i].task.store(nullptr, std::memory_order_relaxed);
+        this->m_slots[i].state.store(FREE, std::memory_order_relaxed);
+        this->m_slots[i].running.store(false, std::memory_order_relaxed);
+    }
+    for (FwSizeType i = 0; i < MULTI_TASK_RUNNER_MAX_WORKERS; i++) {
+        this->m_workers[i].unitsRun.store(0, std::memory_order_relaxed);
+    }
+    // The singleton registers itself when first used, which must not replace this runner later on
+    TaskRunner& runner = TaskRunner::getSingleton();
+    // Its default clock reads an epoch set on first use, which must happen here and not on several workers at once
+    (void)runner.getTimeUs();
+    runner.setDelayHook(MultiTaskRunner::sleepWorker, this);
+    Task::registerTaskRegistry(this);
+}
+
+MultiTaskRunner::~MultiTaskRunner() {
+    this->stop();
+    TaskRunner::getSingleton().setDelayHook(nullptr);
+    Task::registerTaskRegistry(nullptr);
+}
+
+void MultiTaskRunner::addTask(Task* task) {
+    FW_ASSERT(task != nullptr);
+    FW_ASSERT(task->isCooperative());  // Cannot register uncooperative tasks
+    std::unique_lock<std::mutex> lock(this->m_registryMutex);
+    // A removed task whose slot was not taken back by a worker yet, for example while stopped, is still queued
+    for (FwSizeType i = 0; i < TASK_RUNNER_CAPACITY; i++) {
+        Slot& slot = this->m_slots[i];
+        if (slot.task.load(std::memory_order_relaxed) == task) {
+            FW_ASSERT(slot.state.load() != ACTIVE, static_cast<FwAssertArgType>(i));  // Cannot register a task twice
+            U8 state = REMOVING;
+            if (slot.state.compare_exchange_strong(state, ACTIVE)) {
+                return;
+            }
+        }
+    }
+    for (FwSizeType i = 0; i < TASK_RUNNER_CAPACITY; i++) {
+        Slot& slot = this->m_slots[i];
+        U8 state = FREE;
+        if (slot.state.compare_exchange_strong(state, ACTIVE)) {
+            slot.task.store(task, std::memory_order_relaxed);
+            // The release of the inbox publishes the task to the worker that takes the slot
+            this->m_inbox.push(i);
+            lock.unlock();
+            this->wakeWorker();
+            return;
+        }
+    }
+    FW_ASSERT(0, static_cast<FwAssertArgType>(TASK_RUNNER_CAPACITY));  // No free slot
+}
+
+void MultiTaskRunner::removeTask(Task* task) {
+    FW_ASSERT(task != nullptr);
+    Slot* removed = nullptr;
+    {
+        // Adders wait here, so the slot cannot be freed and taken by another task while it is looked up
+        std::lock_guard<std::mutex> lock(this->m_registryMutex);
+        for (FwSizeType i = 0; (i < TASK_RUNNER_CAPACITY) and (removed == nullptr); i++) {
+            Slot& slot = this->m_slots[i];
+            U8 state = ACTIVE;
+            if ((slot.task.load(std::memory_order_relaxed) == task) and
+                slot.state.compare_exchange_strong(state, REMOVING)) {
+                removed = &slot;
+            }
+        }
+    }
+    // Tasks that were never added, or already exited, are ignored. A task removing itself cannot wait for itself
+    if ((removed == nullptr) or (s_currentTask == task)) {
+        return;
+    }
+    // Workers set running before checking the state, so once running is seen clear the task does not run again
+    while (removed->running.load() and (removed->task.load(std::memory_order_relaxed) == task)) {
+        std::this_thread::yield();
+    }
+}
+
+void MultiTaskRunner::start(FwSizeType workers, bool pinWorkers) {
+    FW_ASSERT((workers > 0) and (workers <= MULTI_TASK_RUNNER_MAX_WORKERS), static_cast<FwAssertArgType>(workers));
+    FW_ASSERT(this->m_workerCount == 0, static_cast<FwAssertArgType>(this->m_workerCount));  // Already started
+    this->m_running.store(true);
+    this->m_workerCount = workers;
+    for (FwSizeType i = 0; i < workers; i++) {
+        this->m_workers[i].unitsRun.store(0, std::memory_order_relaxed);
+        this->m_workers[i].thread = std::thread(&MultiTaskRunner::work, this, i);
+        if (pinWorkers) {
+            pin(this->m_workers[i].thread, i);
+        }
+    }
+}
+
+void MultiTaskRunner::stop() {
+    this->m_running.store(false);
+    {
+        // Workers check m_running with the mutex held before sleeping, so none of them misses this
+        std::lock_guard<std::mutex> lock(this->m_idleMutex);
+        this->m_idleCondition.notify_all();
+    }
+    for (FwSizeType i = 0; i < this->m_workerCount; i++) {
+        this->m_workers[i].thread.join();
+    }
+    // Tasks left in the deques of the workers are handed back to the inbox for the next start
+    for (FwSizeType i = 0; i < this->m_workerCount; i++) {
+        FwSizeType slot = 0;
+        while (this->m_workers[i].deque.steal(slot)) {
+            std::lock_guard<std::mutex> lock(this->m_registryMutex);
+            this->m_inbox.push(slot);
+        }
+    }
+    this->m_workerCount = 0;
+}
+
+FwSizeType MultiTaskRunner::getWorkerCount() const {
+    return this->m_workerCount;
+}
+
+U64 MultiTaskRunner::getUnitsRun(FwSizeType worker) const {
+    FW_ASSERT(worker < MULTI_TASK_RUNNER_MAX_WORKERS, static_cast<FwAssertArgType>(worker));
+    return this->m_workers[worker].unitsRun.load(std::memory_order_relaxed);
+}
+
+void MultiTaskRunner::work(FwSizeType worker) {
+    Worker& self = this->m_workers[worker];
+    while (this->m_running.load(std::memory_order_relaxed)) {
+        FwSizeType slot = 0;
+        if (not this->take(worker, slot)) {
+            this->waitForWork();
+            continue;
+        }
+        if (this->runSlot(slot)) {
+            // A task queued behind others can be stolen by a sleeping worker
+            const bool shared = not self.deque.isEmpty();
+            self.deque.push(slot);
+            if (shared) {
+                this->wakeWorker();
+            }
+        }
+        self.unitsRun.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool MultiTaskRunner::take(FwSizeType worker, FwSizeType& slot) {
+    // Added tasks first, as busy workers would never get to them otherwise, then own tasks, then other tasks
+    return this->m_inbox.steal(slot) or this->m_workers[worker].deque.steal(slot) or
+           this->stealFromOthers(worker, slot);
+}
+
+bool MultiTaskRunner::stealFromOthers(FwSizeType worker, FwSizeType& slot) {
+    // Start with the next worker so thieves do not all pick on the first one
+    for (FwSizeType offset = 1; offset < this->m_workerCount; offset++) {
+        if (this->m_workers[(worker + offset) % this->m_workerCount].deque.steal(slot)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MultiTaskRunner::hasWork() const {
+    if (not this->m_inbox.isEmpty()) {
+        return true;
+    }
+    for (FwSizeType i = 0; i < this->m_workerCount; i++) {
+        if (not this->m_workers[i].deque.isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MultiTaskRunner::waitForWork() {
+    std::unique_lock<std::mutex> lock(this->m_idleMutex);
+    this->m_sleeping.fetch_add(1);
+    // Pairs with the fence of wakeWorker: either the waker sees this worker sleeping, or this worker sees the task
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (this->m_running.load() and not this->hasWork()) {
+        this->m_idleCondition.wait(lock);
+    }
+    this->m_sleeping.fetch_sub(1);
+}
+
+void MultiTaskRunner::wakeWorker() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->m_sleeping.load(std::memory_order_relaxed) > 0) {
+        // Taking the mutex waits for a worker about to sleep to be waiting
+        std::lock_guard<std::mutex> lock(this->m_idleMutex);
+        this->m_idleCondition.notify_one();
+    }
+}
+
+bool MultiTaskRunner::runSlot(FwSizeType index) {
+    Slot& slot = this->m_slots[index];
+    Task* task = slot.task.load(std::memory_order_relaxed);
+    // Pairs with the state change of removeTask: either the remover sees running, or the worker sees REMOVING
+    slot.running.store(true);
+    U8 state = slot.state.load();
+    // The slot of a removed task is freed, unless the task was added again meanwhile
+    if ((state == REMOVING) and slot.state.compare_exchange_strong(state, FREE)) {
+        slot.running.store(false);
+        return false;
+    }
+    BaremetalTaskHandle& handle = *static_cast<BaremetalTaskHandle*>(task->getHandle());
+    if (handle.m_enabled and (task->getState() != Os::Task::State::EXITED)) {
+        s_currentTask = task;
+        handle.m_routine(handle.m_argument);
+        s_currentTask = nullptr;
+    }
+    slot.running.store(false);
+    // Exited tasks are dropped here, the slot was only in the deque of this worker
+    if (task->getState() == Os::Task::State::EXITED) {
+        slot.state.store(FREE);
+        return false;
+    }
+    return true;
+}
+
+bool MultiTaskRunner::sleepWorker(void* runner, U64 delayUs) {
+    (void)runner;
+    // Only units of work run by the workers sleep, other callers wait in place as without this runner
+    if (s_currentTask == nullptr) {
+        return false;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+    return true;
+}
+
+void MultiTaskRunner::pin(std::thread& thread, FwSizeType processor) {
+#if defined(__linux__)
+    const FwSizeType processors = static_cast<FwSizeType>(std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<int>(processor % ((processors == 0) ? 1 : processors)), &set);
+    // Pinning is a hint, a worker left unpinned still runs its tasks
+    (void)pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    (void)thread;
+    (void)processor;
+#endif
+}
+
+}  // End namespace Baremetal
+}  // End Namespace Os
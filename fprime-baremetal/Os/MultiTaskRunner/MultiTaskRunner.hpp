@@ -0,0 +1,139 @@
+// ======================================================================
+// \title fprime-baremetal/Os/MultiTaskRunner/MultiTaskRunner.hpp
+// \brief MultiTaskRunner definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_MULTITASKRUNNER_MULTITASKRUNNER_HPP_
+#define FPRIME_BAREMETAL_MULTITASKRUNNER_MULTITASKRUNNER_HPP_
+#include <Os/Task.hpp>
+#include <fprime-baremetal/Os/MultiTaskRunner/WorkDeque.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "config/TaskRunnerCfg.hpp"
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief a task runner invoking cooperative tasks from several worker threads
+//!
+//! For hosts and multi-core targets with `std::thread`, such as software-in-the-loop runs on Linux. Each worker
+//! thread runs units of work of the tasks in its `WorkDeque` in turn, putting each task back into its own deque once
+//! its unit of work returns. A worker that runs out of tasks steals one from another worker, so the load spreads over
+//! the workers. A task is in at most one deque or running on one worker at any time, so a task never runs on two
+//! workers at once, and its units of work need no more locking than with the single threaded `TaskRunner`. State
+//! shared between tasks, such as queues, must however be safe to use from several threads. The `Os_Mutex_Baremetal`
+//! and `Os_Queue_Baremetal` implementations lock nothing, so units of work of different tasks would race on them:
+//! choose the implementations of the host, such as the Posix ones, with this runner.
+//!
+//! A worker finding no task to run or steal sleeps on a condition variable until a task is added, or until another
+//! worker has more than one task in its deque.
+//!
+//! Task priorities are not used: every task gets its turn. `Os::Task::delay` called from a unit of work puts its
+//! worker to sleep for the delay, through the delay hook of the `TaskRunner` singleton, and the other workers keep
+//! running the other tasks.
+//!
+//! Constructing a `MultiTaskRunner` makes it the registry of tasks started afterwards, in place of the `TaskRunner`
+//! singleton.
+class MultiTaskRunner : TaskRegistry {
+  public:
+    //! Register with Os::Task, with no worker running
+    MultiTaskRunner();
+
+    //! Stop the workers and unregister from Os::Task, tasks started afterwards are not run
+    ~MultiTaskRunner();
+
+    //! \brief add a task to this runner, from any thread
+    //!
+    //! A removed task may be added again, whether or not the workers are running.
+    //!
+    //! \param task: pointer task to add to this runner
+    void addTask(Task* task) override;
+
+    //! \brief remove a task from this runner, from any thread
+    //!
+    //! Once this returns, no worker runs the task anymore, unless it is the task calling this from its own unit of
+    //! work. Exited tasks are removed by the workers themselves.
+    //!
+    //! \param task: pointer task to remove from this runner
+    void removeTask(Task* task) override;
+
+    //! \brief start the worker threads
+    //!
+    //! \param workers: number of worker threads, at most `MULTI_TASK_RUNNER_MAX_WORKERS`
+    //! \param pinWorkers: pin worker n to processor n, modulo the number of processors, where supported
+    void start(FwSizeType workers, bool pinWorkers = false);
+
+    //! \brief stop the worker threads, waiting for their units of work to return
+    void stop();
+
+    //! \brief get the number of running workers
+    FwSizeType getWorkerCount() const;
+
+    //! \brief get the number of units of work a worker ran since started
+    U64 getUnitsRun(FwSizeType worker) const;
+
+  private:
+    //! \brief state of a task slot
+    enum SlotState : U8 {
+        FREE,      //!< no task
+        ACTIVE,    //!< task in a deque or running
+        REMOVING,  //!< removed task still in a deque, freed by the worker that takes it
+    };
+
+    //! \brief registered task
+    struct Slot {
+        std::atomic<Task*> task;    //!< task of the slot
+        std::atomic<U8> state;      //!< SlotState of the slot
+        std::atomic<bool> running;  //!< a worker is running a unit of work of the task
+    };
+
+    //! \brief worker thread and its deque
+    struct Worker {
+        std::thread thread;         //!< thread running the worker
+        WorkDeque deque;            //!< tasks of this worker
+        std::atomic<U64> unitsRun;  //!< units of work run
+    };
+
+    //! \brief body of a worker thread
+    void work(FwSizeType worker);
+
+    //! \brief take a task from the inbox, the deque of a worker, or another worker
+    bool take(FwSizeType worker, FwSizeType& slot);
+
+    //! \brief take a task from another worker
+    bool stealFromOthers(FwSizeType worker, FwSizeType& slot);
+
+    //! \brief check whether a task looks ready to be taken
+    bool hasWork() const;
+
+    //! \brief sleep until there may be a task to take or the workers stop
+    void waitForWork();
+
+    //! \brief wake one sleeping worker, if any, after a task was queued
+    void wakeWorker();
+
+    //! \brief run one unit of work of the task of a slot, freeing the slot of a removed or exited task
+    //!
+    //! \return true if the task goes back into a deque
+    bool runSlot(FwSizeType index);
+
+    //! \brief pin a thread to a processor, where supported
+    static void pin(std::thread& thread, FwSizeType processor);
+
+    //! \brief `TaskRunner` delay hook putting the worker running the unit of work to sleep
+    static bool sleepWorker(void* runner, U64 delayUs);
+
+    Slot m_slots[TASK_RUNNER_CAPACITY];               //!< registered tasks
+    Worker m_workers[MULTI_TASK_RUNNER_MAX_WORKERS];  //!< worker threads
+    WorkDeque m_inbox;                                //!< added tasks not yet taken by a worker
+    std::mutex m_registryMutex;                       //!< serializes adders and removers, m_inbox producers
+    std::mutex m_idleMutex;                           //!< protects the sleep of idle workers
+    std::condition_variable m_idleCondition;          //!< signaled when a task is queued or the workers stop
+    std::atomic<FwSizeType> m_sleeping;               //!< workers sleeping or about to sleep
+    std::atomic<bool> m_running;                      //!< workers keep running
+    FwSizeType m_workerCount;                         //!< number of started workers
+};
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_MULTITASKRUNNER_MULTITASKRUNNER_HPP_ */
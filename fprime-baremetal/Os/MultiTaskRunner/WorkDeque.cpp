@@ -0,0 +1,45 @@
+// ======================================================================
+// \title fprime-baremetal/Os/MultiTaskRunner/WorkDeque.cpp
+// \brief WorkDeque implementations
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/MultiTaskRunner/WorkDeque.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+// out-of-line definitions for constants that are odr-used (required before C++17)
+constexpr FwSizeType WorkDeque::CAPACITY;
+
+WorkDeque::WorkDeque() : m_top(0), m_bottom(0) {
+    for (FwSizeType i = 0; i < CAPACITY; i++) {
+        this->m_entries[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void WorkDeque::push(FwSizeType entry) {
+    const FwSizeType bottom = this->m_bottom.load(std::memory_order_relaxed);
+    const FwSizeType top = this->m_top.load(std::memory_order_acquire);
+    FW_ASSERT((bottom - top) < CAPACITY, static_cast<FwAssertArgType>(bottom - top));
+    this->m_entries[bottom & (CAPACITY - 1)].store(entry, std::memory_order_relaxed);
+    // Publish the entry before the new bottom that makes it visible to thieves
+    this->m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+bool WorkDeque::steal(FwSizeType& entry) {
+    FwSizeType top = this->m_top.load(std::memory_order_acquire);
+    const FwSizeType bottom = this->m_bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return false;
+    }
+    // Read before claiming, the slot may be reused by a push once the top moves
+    entry = this->m_entries[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    return this->m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+bool WorkDeque::isEmpty() const {
+    return this->m_top.load(std::memory_order_relaxed) >= this->m_bottom.load(std::memory_order_relaxed);
+}
+
+}  // End namespace Baremetal
+}  // End Namespace Os
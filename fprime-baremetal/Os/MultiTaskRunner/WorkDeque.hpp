@@ -0,0 +1,49 @@
+// ======================================================================
+// \title fprime-baremetal/Os/MultiTaskRunner/WorkDeque.hpp
+// \brief WorkDeque definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_MULTITASKRUNNER_WORKDEQUE_HPP_
+#define FPRIME_BAREMETAL_MULTITASKRUNNER_WORKDEQUE_HPP_
+#include <Fw/Types/BasicTypes.hpp>
+#include <atomic>
+#include "config/TaskRunnerCfg.hpp"
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief lock-free work-stealing deque of task slot indices, in the manner of Chase and Lev
+//!
+//! One owner thread pushes at the bottom, and any thread, the owner included, takes from the top with a
+//! compare-and-swap. Taking from the top on the owner side too keeps tasks in first-in first-out order, so the tasks
+//! of a worker run in turn. The capacity holds every task of a runner, and a task is in at most one deque at a time,
+//! so pushing never fails.
+class WorkDeque {
+  public:
+    static constexpr FwSizeType CAPACITY = 128;  //!< power of two holding every task of a runner
+
+    static_assert(CAPACITY >= TASK_RUNNER_CAPACITY, "Work deques must hold every task");
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Work deque capacity must be a power of two");
+
+    //! Empty deque
+    WorkDeque();
+
+    //! \brief add an entry at the bottom, from the owner thread only
+    void push(FwSizeType entry);
+
+    //! \brief take the entry at the top, from any thread
+    //!
+    //! \param entry: filled with the entry taken
+    //! \return false if the deque was empty or another thread took the entry first
+    bool steal(FwSizeType& entry);
+
+    //! \brief check whether the deque looks empty, which may be outdated as soon as it returns
+    bool isEmpty() const;
+
+  private:
+    std::atomic<FwSizeType> m_top;                //!< index of the next entry to take
+    std::atomic<FwSizeType> m_bottom;             //!< index of the next entry to push
+    std::atomic<FwSizeType> m_entries[CAPACITY];  //!< circular buffer of entries
+};
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_MULTITASKRUNNER_WORKDEQUE_HPP_ */
@@ -0,0 +1,81 @@
+// ----------------------------------------------------------------------
+// MultiTaskRunnerBenchmark.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/Task.hpp>
+#include <fprime-baremetal/Os/MultiTaskRunner/MultiTaskRunner.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+const FwSizeType TASKS = 16;        //!< tasks sharing the workers
+const U32 ROUNDS_PER_UNIT = 20000;  //!< processor bound rounds of one unit of work
+
+struct Worker {
+    bool armed;  //!< set once the task is registered, so start does no work
+    U32 state;   //!< state of the work, kept so the rounds are not optimized out
+};
+
+void work(void* argument) {
+    Worker& worker = *static_cast<Worker*>(argument);
+    if (not worker.armed) {
+        return;
+    }
+    U32 state = worker.state;
+    for (U32 round = 0; round < ROUNDS_PER_UNIT; round++) {
+        state = (state * 1664525U) + 1013904223U;
+    }
+    worker.state = state;
+}
+
+//! run the tasks on a number of workers for a while and return units of work per second
+F64 measure(Os::Baremetal::MultiTaskRunner& runner, FwSizeType workers, bool pinWorkers) {
+    const auto duration = std::chrono::milliseconds(300);
+    runner.start(workers, pinWorkers);
+    const auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(duration);
+    runner.stop();
+    const F64 seconds = std::chrono::duration<F64>(std::chrono::steady_clock::now() - start).count();
+    U64 units = 0;
+    for (FwSizeType i = 0; i < workers; i++) {
+        units += runner.getUnitsRun(i);
+    }
+    return static_cast<F64>(units) / seconds;
+}
+
+}  // namespace
+
+TEST(MultiTaskRunner, Throughput) {
+    Os::Baremetal::MultiTaskRunner runner;
+    Os::Task tasks[TASKS];
+    Worker workers[TASKS];
+    for (FwSizeType i = 0; i < TASKS; i++) {
+        workers[i] = {false, static_cast<U32>(i)};
+        Fw::String name("bench");
+        Os::Task::Arguments arguments(name, work, &workers[i]);
+        ASSERT_EQ(Os::Task::Status::OP_OK, tasks[i].start(arguments));
+        workers[i].armed = true;
+    }
+
+    // Speedups are only meaningful with as many free processors as workers
+    const FwSizeType counts[] = {1, 2, 4};
+    const F64 baseline = measure(runner, 1, false);
+    ASSERT_GT(baseline, 0.0);
+    for (const FwSizeType count : counts) {
+        for (const bool pinned : {false, true}) {
+            const F64 rate = measure(runner, count, pinned);
+            std::printf("%2u workers%s: %10.0f units/s, speedup %.2f\n", static_cast<unsigned int>(count),
+                        pinned ? " pinned" : "       ", rate, rate / baseline);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
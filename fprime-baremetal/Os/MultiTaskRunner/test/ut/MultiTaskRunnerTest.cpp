@@ -0,0 +1,261 @@
+// ----------------------------------------------------------------------
+// MultiTaskRunnerTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/Task.hpp>
+#include <fprime-baremetal/Os/MultiTaskRunner/MultiTaskRunner.hpp>
+#include <fprime-baremetal/Os/MultiTaskRunner/WorkDeque.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+struct Worker {
+    std::atomic<bool> inside;   //!< a unit of work of the task is running
+    std::atomic<U32> overlaps;  //!< units of work that found another one of the same task running
+    std::atomic<U32> units;     //!< units of work run
+    std::atomic<bool> armed;    //!< set once the task is registered, so start is not counted
+};
+
+void work(void* argument) {
+    Worker& worker = *static_cast<Worker*>(argument);
+    if (not worker.armed.load()) {
+        return;
+    }
+    if (worker.inside.exchange(true)) {
+        worker.overlaps++;
+    }
+    // Long enough for other workers to try running the task meanwhile
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    worker.units++;
+    worker.inside.store(false);
+}
+
+void startWorker(Os::Task& task, Worker& worker) {
+    worker.inside.store(false);
+    worker.overlaps.store(0);
+    worker.units.store(0);
+    worker.armed.store(false);
+    Fw::String name("worker");
+    Os::Task::Arguments arguments(name, work, &worker);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+    worker.armed.store(true);
+}
+
+//! wait for every task to run a number of units of work, or for a second
+bool waitForUnits(const Worker* workers, FwSizeType count, U32 units) {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (std::chrono::steady_clock::now() < end) {
+        bool done = true;
+        for (FwSizeType i = 0; i < count; i++) {
+            done = done and (workers[i].units.load() >= units);
+        }
+        if (done) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST(WorkDeque, FirstInFirstOut) {
+    Os::Baremetal::WorkDeque deque;
+    FwSizeType entry = 0;
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_FALSE(deque.steal(entry));
+    // Wrap around the capacity a few times
+    for (FwSizeType i = 0; i < (3 * Os::Baremetal::WorkDeque::CAPACITY); i++) {
+        deque.push(i);
+        deque.push(i + 1);
+        ASSERT_TRUE(deque.steal(entry));
+        EXPECT_EQ(i, entry);
+        ASSERT_TRUE(deque.steal(entry));
+        EXPECT_EQ(i + 1, entry);
+    }
+    EXPECT_TRUE(deque.isEmpty());
+}
+
+TEST(MultiTaskRunner, TasksNeverOverlap) {
+    Os::Baremetal::MultiTaskRunner runner;
+    Os::Task tasks[6];
+    Worker workers[6];
+    for (FwSizeType i = 0; i < 6; i++) {
+        startWorker(tasks[i], workers[i]);
+    }
+    runner.start(4);
+    EXPECT_EQ(4U, runner.getWorkerCount());
+
+    // Every task progresses, and a task is never run by two workers at once
+    EXPECT_TRUE(waitForUnits(workers, 6, 20));
+    runner.stop();
+    U64 unitsRun = 0;
+    for (FwSizeType i = 0; i < 4; i++) {
+        unitsRun += runner.getUnitsRun(i);
+    }
+    U64 units = 0;
+    for (FwSizeType i = 0; i < 6; i++) {
+        EXPECT_EQ(0U, workers[i].overlaps.load());
+        units += workers[i].units.load();
+    }
+    EXPECT_EQ(units, unitsRun);
+}
+
+TEST(MultiTaskRunner, LoadSpreadsOverWorkers) {
+    Os::Baremetal::MultiTaskRunner runner;
+    Os::Task tasks[16];
+    Worker workers[16];
+    for (FwSizeType i = 0; i < 16; i++) {
+        startWorker(tasks[i], workers[i]);
+    }
+
+    // Every worker takes a share of the tasks, pinned or not, and every unit of work is counted once
+    U32 fewest = 0;
+    U64 counted = 0;
+    for (const FwSizeType count : {1, 2, 4}) {
+        for (const bool pinned : {false, true}) {
+            runner.start(count, pinned);
+            EXPECT_TRUE(waitForUnits(workers, 16, fewest + 5));
+            runner.stop();
+            U64 unitsRun = 0;
+            for (FwSizeType i = 0; i < count; i++) {
+                EXPECT_GT(runner.getUnitsRun(i), 0U);
+                unitsRun += runner.getUnitsRun(i);
+            }
+            U64 units = 0;
+            fewest = workers[0].units.load();
+            for (FwSizeType i = 0; i < 16; i++) {
+                units += workers[i].units.load();
+                fewest = (workers[i].units.load() < fewest) ? workers[i].units.load() : fewest;
+            }
+            EXPECT_EQ(units - counted, unitsRun);
+            counted = units;
+        }
+    }
+    for (FwSizeType i = 0; i < 16; i++) {
+        EXPECT_EQ(0U, workers[i].overlaps.load());
+    }
+}
+
+TEST(MultiTaskRunner, RemoveAndRestart) {
+    Os::Baremetal::MultiTaskRunner runner;
+    Os::Task tasks[2];
+    Worker workers[2];
+    for (FwSizeType i = 0; i < 2; i++) {
+        startWorker(tasks[i], workers[i]);
+    }
+    runner.start(2);
+    ASSERT_TRUE(waitForUnits(workers, 2, 5));
+
+    // A removed task does not run once removeTask returns
+    runner.removeTask(&tasks[0]);
+    const U32 removedUnits = workers[0].units.load();
+    EXPECT_FALSE(workers[0].inside.load());
+    const U32 remaining = workers[1].units.load();
+    EXPECT_TRUE(waitForUnits(&workers[1], 1, remaining + 20));
+    EXPECT_EQ(removedUnits, workers[0].units.load());
+
+    // Stopped runners keep their tasks for the next start
+    runner.stop();
+    const U32 stopped = workers[1].units.load();
+    runner.start(1);
+    EXPECT_TRUE(waitForUnits(&workers[1], 1, stopped + 5));
+    runner.stop();
+}
+
+TEST(MultiTaskRunner, ReAddRemovedTask) {
+    Os::Baremetal::MultiTaskRunner runner;
+    Os::Task task;
+    Worker worker;
+    startWorker(task, worker);
+
+    // Removed and added again before any worker took it, then removed and added again while running
+    runner.removeTask(&task);
+    runner.addTask(&task);
+    runner.start(2);
+    ASSERT_TRUE(waitForUnits(&worker, 1, 5));
+    runner.removeTask(&task);
+    const U32 removedUnits = worker.units.load();
+    runner.addTask(&task);
+    EXPECT_TRUE(waitForUnits(&worker, 1, removedUnits + 5));
+
+    // Removed while stopped, and added again for the next start
+    runner.stop();
+    runner.removeTask(&task);
+    runner.addTask(&task);
+    const U32 stopped = worker.units.load();
+    runner.start(1);
+    EXPECT_TRUE(waitForUnits(&worker, 1, stopped + 5));
+    runner.stop();
+    EXPECT_EQ(0U, worker.overlaps.load());
+}
+
+TEST(MultiTaskRunner, IdleWorkersWakeForNewTasks) {
+    Os::Baremetal::MultiTaskRunner runner;
+    runner.start(2);
+    // Give the workers time to find nothing to do and sleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(0U, runner.getUnitsRun(0) + runner.getUnitsRun(1));
+
+    Os::Task tasks[2];
+    Worker workers[2];
+    for (FwSizeType i = 0; i < 2; i++) {
+        startWorker(tasks[i], workers[i]);
+    }
+    EXPECT_TRUE(waitForUnits(workers, 2, 20));
+    runner.stop();
+}
+
+namespace {
+
+struct Sleeper {
+    std::atomic<bool> armed{false};  //!< set once the task is registered, so start does not sleep
+    std::atomic<U32> units{0};       //!< units of work run
+};
+
+void sleepBriefly(void* argument) {
+    Sleeper& sleeper = *static_cast<Sleeper*>(argument);
+    if (sleeper.armed.load()) {
+        Os::Task::delay(Fw::TimeInterval(0, 20000));
+        sleeper.units++;
+    }
+}
+
+}  // namespace
+
+TEST(MultiTaskRunner, DelaySleepsItsWorker) {
+    Os::Baremetal::MultiTaskRunner runner;
+    Os::Task sleeperTask;
+    Sleeper sleeper;
+    Fw::String name("sleeper");
+    Os::Task::Arguments arguments(name, sleepBriefly, &sleeper);
+    ASSERT_EQ(Os::Task::Status::OP_OK, sleeperTask.start(arguments));
+    sleeper.armed.store(true);
+    Os::Task task;
+    Worker worker;
+    startWorker(task, worker);
+
+    // The other task keeps running on the other worker while the sleeper holds its own
+    const auto start = std::chrono::steady_clock::now();
+    runner.start(2);
+    const auto end = start + std::chrono::seconds(1);
+    while ((sleeper.units.load() < 2) and (std::chrono::steady_clock::now() < end)) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(waitForUnits(&worker, 1, 20));
+    runner.stop();
+    // Each unit of work of the sleeper lasted its delay
+    const U32 units = sleeper.units.load();
+    EXPECT_GE(units, 2U);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, units * std::chrono::milliseconds(20));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <Fw/Types/Assert.hpp>
 #include <atomic>
+#include <fprime-baremetal/Os/HeapStats/HeapStats.hpp>
 #include <fprime-baremetal/Os/MemoryIdScope/MemoryIdScope.hpp>
 #include <new>        // included to get std::nothrow_t
 #include <stdexcept>  // For standard exception types
@@ -28,12 +29,18 @@ static void* allocateMemory(const FwEnumStoreType identifier, const FwSizeType s
 FwSizeType registerMemAllocator(Fw::MemAllocator* allocator) {
     FW_ASSERT(pAllocator == nullptr);
     FW_ASSERT(allocator != nullptr);
-    pAllocator = allocator;
+    // Every later allocation is counted in HeapStats
+    static AccountingAllocator accounting(*allocator);
+    pAllocator = &accounting;
     // Get & return number of bytes already allocated
     struct mallinfo mi = mallinfo();
     return mi.uordblks;
 }
 
+Fw::MemAllocator* getMemAllocator() {
+    return pAllocator;
+}
+
 static void deallocateMemoryWithoutId(void* ptr) {
     deallocateMemory(Os::Baremetal::defaultMemoryId, ptr);
 }
@@ -23,10 +23,18 @@ namespace OverrideNewDelete {
 
 //! \brief Register a memory allocator for all future new operator calls
 //!
+//! The allocator is wrapped in an AccountingAllocator, so that all future new/delete calls are counted in HeapStats.
+//! Memory allocated by new before the registration (only possible in unit tests) must not be deleted after it.
+//!
 //! \param allocator MemAllocator to use for all future new/delete calls
 //! \return Returns number of bytes allocated before
 FwSizeType registerMemAllocator(Fw::MemAllocator* allocator);
 
+//! \brief Get the allocator used by new/delete, so components allocating directly are counted in HeapStats too
+//!
+//! \return the registered allocator wrapped in an AccountingAllocator, or nullptr before registration
+Fw::MemAllocator* getMemAllocator();
+
 }  // namespace OverrideNewDelete
 }  // namespace Baremetal
 }  // namespace Os
@@ -0,0 +1,222 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Simulation/TaskSimulator.cpp
+// \brief TaskSimulator implementations
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/Baremetal/RawTime.hpp>
+#include <fprime-baremetal/Os/Simulation/TaskSimulator.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+static const U64 MICROSECONDS_PER_SECOND = 1000000;
+
+TaskSimulator::TaskSimulator(TaskRunner& runner, U32 frequencyHz, U32 seed)
+    : m_runner(runner), m_frequencyHz(frequencyHz), m_random((seed == 0) ? 1 : seed) {
+    FW_ASSERT(frequencyHz > 0);
+}
+
+TaskSimulator::~TaskSimulator() {
+    this->detach();
+}
+
+void TaskSimulator::attach() {
+    FW_ASSERT(not this->m_attached);
+    this->m_runner.setClock(TaskSimulator::readTimeUs, this);
+    this->m_runner.setWorkHook(TaskSimulator::onWork, this);
+    this->m_runner.setDelayHook(TaskSimulator::onDelay, this);
+    BaremetalRawTime::setCounter(TaskSimulator::readCycles, this->m_frequencyHz, 64, this);
+    this->m_attached = true;
+}
+
+void TaskSimulator::detach() {
+    if (this->m_attached) {
+        this->m_runner.setClock(nullptr);
+        this->m_runner.setWorkHook(nullptr);
+        this->m_runner.setDelayHook(nullptr);
+        BaremetalRawTime::setCounter(nullptr, 0);
+        this->m_attached = false;
+    }
+}
+
+void TaskSimulator::addTick(U32 periodUs, Tick tick, void* context, U32 costCycles, U32 phaseUs) {
+    FW_ASSERT(tick != nullptr);
+    FW_ASSERT(periodUs > 0);
+    FW_ASSERT(this->m_tickCount < TASK_SIMULATOR_TICKS, static_cast<FwAssertArgType>(this->m_tickCount));
+    TickEntry& entry = this->m_tickEntries[this->m_tickCount];
+    entry.tick = tick;
+    entry.context = context;
+    entry.nextUs = this->getTimeUs() + phaseUs;
+    entry.periodUs = periodUs;
+    entry.costCycles = costCycles;
+    this->m_tickCount++;
+}
+
+void TaskSimulator::setCost(Task* task, U32 cycles, U32 jitterCycles) {
+    CostEntry& entry = this->getCostEntry(task);
+    entry.model = nullptr;
+    entry.context = nullptr;
+    entry.cycles = cycles;
+    entry.jitterCycles = jitterCycles;
+}
+
+void TaskSimulator::setCostModel(Task* task, CostModel model, void* context) {
+    FW_ASSERT(model != nullptr);
+    CostEntry& entry = this->getCostEntry(task);
+    entry.model = model;
+    entry.context = context;
+    entry.cycles = 0;
+    entry.jitterCycles = 0;
+}
+
+void TaskSimulator::setDefaultCost(U32 cycles) {
+    this->m_defaultCycles = cycles;
+}
+
+void TaskSimulator::consume(U64 cycles) {
+    this->m_cycles += cycles;
+}
+
+void TaskSimulator::runUntil(U64 timeUs) {
+    FW_ASSERT(this->m_attached);
+    // Ticks due at the end are left to the next run
+    while (this->getTimeUs() < timeUs) {
+        this->fireTicks();
+        // A call of run that ran no unit of work found nothing ready, so nothing happens until the next event
+        const U64 units = this->m_units;
+        this->m_runner.run();
+        if (this->m_units == units) {
+            this->skipIdle(timeUs);
+        }
+    }
+}
+
+void TaskSimulator::runFor(U64 durationUs) {
+    this->runUntil(this->getTimeUs() + durationUs);
+}
+
+U32 TaskSimulator::getRandom() {
+    // xorshift32: cheap, and the same sequence for a seed on every host
+    U32 x = this->m_random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    this->m_random = x;
+    return x;
+}
+
+U64 TaskSimulator::getCycles() const {
+    return this->m_cycles;
+}
+
+U64 TaskSimulator::getTimeUs() const {
+    return this->toUs(this->m_cycles);
+}
+
+U32 TaskSimulator::getFrequency() const {
+    return this->m_frequencyHz;
+}
+
+U64 TaskSimulator::getUnits() const {
+    return this->m_units;
+}
+
+U64 TaskSimulator::getTicks() const {
+    return this->m_ticks;
+}
+
+TaskSimulator::CostEntry& TaskSimulator::getCostEntry(Task* task) {
+    FW_ASSERT(task != nullptr);
+    for (FwSizeType i = 0; i < this->m_costCount; i++) {
+        if (this->m_costs[i].task == task) {
+            return this->m_costs[i];
+        }
+    }
+    FW_ASSERT(this->m_costCount < TASK_SIMULATOR_COSTS, static_cast<FwAssertArgType>(this->m_costCount));
+    CostEntry& entry = this->m_costs[this->m_costCount];
+    entry.task = task;
+    this->m_costCount++;
+    return entry;
+}
+
+void TaskSimulator::fireTicks() {
+    // Each due tick fires once per call, so ticks costing more than their period still let the tasks run. Ticks that
+    // fell behind catch up one per unit of work, or per call of run when nothing runs
+    for (FwSizeType i = 0; i < this->m_tickCount; i++) {
+        TickEntry& entry = this->m_tickEntries[i];
+        if (entry.nextUs <= this->getTimeUs()) {
+            entry.nextUs += entry.periodUs;
+            this->m_ticks++;
+            entry.tick(entry.context);
+            this->consume(entry.costCycles);
+        }
+    }
+}
+
+void TaskSimulator::skipIdle(U64 endUs) {
+    const U64 nowUs = this->getTimeUs();
+    U64 nextUs = endUs;
+    for (FwSizeType i = 0; i < this->m_tickCount; i++) {
+        if (this->m_tickEntries[i].nextUs < nextUs) {
+            nextUs = this->m_tickEntries[i].nextUs;
+        }
+    }
+    U64 delayEndUs = 0;
+    if (this->m_runner.getDelayEndUs(delayEndUs) and (delayEndUs > nowUs) and (delayEndUs < nextUs)) {
+        nextUs = delayEndUs;
+    }
+    // Rounding up the cycles makes the clock read at least the time of the event
+    if (nextUs > nowUs) {
+        this->m_cycles = this->toCycles(nextUs);
+    }
+}
+
+U64 TaskSimulator::toUs(U64 cycles) const {
+    // Whole seconds and the remainder apart, so the products cannot overflow
+    const U64 frequency = this->m_frequencyHz;
+    return ((cycles / frequency) * MICROSECONDS_PER_SECOND) +
+           (((cycles % frequency) * MICROSECONDS_PER_SECOND) / frequency);
+}
+
+U64 TaskSimulator::toCycles(U64 timeUs) const {
+    const U64 frequency = this->m_frequencyHz;
+    return ((timeUs / MICROSECONDS_PER_SECOND) * frequency) +
+           ((((timeUs % MICROSECONDS_PER_SECOND) * frequency) + MICROSECONDS_PER_SECOND - 1) / MICROSECONDS_PER_SECOND);
+}
+
+U64 TaskSimulator::readTimeUs(void* simulator) {
+    return static_cast<TaskSimulator*>(simulator)->getTimeUs();
+}
+
+U64 TaskSimulator::readCycles(void* simulator) {
+    return static_cast<TaskSimulator*>(simulator)->m_cycles;
+}
+
+void TaskSimulator::onWork(void* simulator, Task& task) {
+    TaskSimulator& self = *static_cast<TaskSimulator*>(simulator);
+    self.m_units++;
+    U64 cycles = self.m_defaultCycles;
+    for (FwSizeType i = 0; i < self.m_costCount; i++) {
+        const CostEntry& entry = self.m_costs[i];
+        if (entry.task == &task) {
+            cycles = (entry.model != nullptr) ? entry.model(entry.context, self, task) : entry.cycles;
+            if (entry.jitterCycles != 0) {
+                cycles += self.getRandom() % (static_cast<U64>(entry.jitterCycles) + 1);
+            }
+            break;
+        }
+    }
+    self.consume(cycles);
+    // Ticks reached during the unit interrupt it, even within a slice that goes on with more units
+    self.fireTicks();
+}
+
+bool TaskSimulator::onDelay(void* simulator, U64 delayUs) {
+    (void)simulator;
+    // Time only moves with units of work, so waiting outside of them would never end
+    FW_ASSERT(0, static_cast<FwAssertArgType>(delayUs));
+    return false;
+}
+
+}  // End namespace Baremetal
+}  // End Namespace Os
@@ -0,0 +1,181 @@
+// ======================================================================
+// \title fprime-baremetal/Os/Simulation/TaskSimulator.hpp
+// \brief TaskSimulator definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_SIMULATION_TASKSIMULATOR_HPP_
+#define FPRIME_BAREMETAL_SIMULATION_TASKSIMULATOR_HPP_
+#include <Fw/Types/BasicTypes.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+#include "config/TaskRunnerCfg.hpp"
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief discrete-event simulation of a single-core deployment driven by a `TaskRunner`, on virtual time
+//!
+//! Time is a count of cycles of a virtual processor running at a given frequency. It only moves forward when something
+//! costs cycles, never with the host clock:
+//!
+//! - each unit of work of a task costs the cycles of its cost model, charged from the runner work hook before the
+//!   runner reads its clock at the end of the unit, so profiling, tracing and budgets see the modelled durations.
+//!   Tasks without a model of their own cost the default cost, and a routine can charge more with `consume`
+//! - periodic ticks, standing in for timer interrupts such as the one driving the rate groups, fire after the unit of
+//!   work during which their time is reached, even within a slice draining several units, and before the runner reads
+//!   its clock, so they may cost cycles charged to that unit as an interrupt would be
+//! - when no task is ready, time jumps to the next tick, the end of the earliest task delay or the end of the run,
+//!   without walking the time in between
+//!
+//! `attach` gives the virtual time to the runner as its clock and to `BaremetalRawTime` as its counter, so
+//! `Os::RawTime` and the instrumentation built on it read virtual time as well. A run depends only on the tasks, the
+//! models and the seed of the random numbers of the models, so it is the same on every host and at every host load,
+//! and days of operation take as long as the units of work they run, not days.
+//!
+//! A task that never waits for wakeups is always ready, so it must cost cycles for time to move at all. Time stands
+//! still outside of `runUntil`, so `Os::Task::delay` called outside of a unit of work, for example from the first run
+//! of a routine by `Os::Task::start`, would wait on the clock forever: it asserts instead while the simulator is
+//! attached.
+class TaskSimulator {
+  public:
+    //! \brief function called when a tick fires, as an interrupt handler would be
+    typedef void (*Tick)(void* context);
+
+    //! \brief function giving the cycles of a unit of work of a task that just ran
+    typedef U64 (*CostModel)(void* context, TaskSimulator& simulator, Task& task);
+
+    //! \brief simulator at cycle 0
+    //!
+    //! \param runner: runner of the simulated tasks
+    //! \param frequencyHz: cycles per second of the virtual processor
+    //! \param seed: seed of the random numbers given to cost models, 0 is replaced by 1
+    TaskSimulator(TaskRunner& runner, U32 frequencyHz, U32 seed = 1);
+
+    //! \brief detach the simulator if attached
+    ~TaskSimulator();
+
+    //! \brief make the runner and `Os::RawTime` read virtual time and charge the cost of each unit of work
+    //!
+    //! No task may be delayed, since delays are counted on the clock of the runner. Takes the delay hook of the runner.
+    void attach();
+
+    //! \brief give the runner and `Os::RawTime` their default clocks back, and clear the delay hook of the runner
+    void detach();
+
+    //! \brief add a periodic tick
+    //!
+    //! \param periodUs: period of the tick in microseconds, not 0
+    //! \param tick: function to call at each tick
+    //! \param context: argument passed to the tick function
+    //! \param costCycles: cycles charged each time the tick fires
+    //! \param phaseUs: time of the first tick, counted from the current time
+    void addTick(U32 periodUs, Tick tick, void* context, U32 costCycles = 0, U32 phaseUs = 0);
+
+    //! \brief charge each unit of work of a task a constant cost, plus a random jitter
+    //!
+    //! \param task: task run by the runner
+    //! \param cycles: cycles of each unit of work
+    //! \param jitterCycles: largest number of cycles added at random to each unit of work
+    void setCost(Task* task, U32 cycles, U32 jitterCycles = 0);
+
+    //! \brief charge each unit of work of a task the cycles given by a model
+    //!
+    //! \param task: task run by the runner
+    //! \param model: function giving the cycles of each unit of work
+    //! \param context: argument passed to the model
+    void setCostModel(Task* task, CostModel model, void* context = nullptr);
+
+    //! \brief set the cycles charged for each unit of work of tasks without a cost of their own, 1 by default
+    void setDefaultCost(U32 cycles);
+
+    //! \brief charge cycles to the running task or tick, advancing time
+    void consume(U64 cycles);
+
+    //! \brief run the tasks and ticks until a time
+    //!
+    //! \param timeUs: virtual time in microseconds at which to stop
+    void runUntil(U64 timeUs);
+
+    //! \brief run the tasks and ticks for a duration
+    //!
+    //! \param durationUs: virtual time in microseconds to run for
+    void runFor(U64 durationUs);
+
+    //! \brief get a pseudo-random number from the seeded sequence of the simulator, for cost models
+    U32 getRandom();
+
+    //! \brief get the cycles elapsed since the start of the simulation
+    U64 getCycles() const;
+
+    //! \brief get the virtual time since the start of the simulation, in microseconds
+    U64 getTimeUs() const;
+
+    //! \brief get the cycles per second of the virtual processor
+    U32 getFrequency() const;
+
+    //! \brief get the number of units of work run so far
+    U64 getUnits() const;
+
+    //! \brief get the number of ticks fired so far
+    U64 getTicks() const;
+
+  private:
+    //! \brief periodic tick
+    struct TickEntry {
+        Tick tick;       //!< function called at each tick
+        void* context;   //!< argument of the function
+        U64 nextUs;      //!< time of the next tick
+        U32 periodUs;    //!< period of the tick
+        U32 costCycles;  //!< cycles charged by each tick
+    };
+
+    //! \brief cost of the units of work of one task
+    struct CostEntry {
+        Task* task;        //!< task charged
+        CostModel model;   //!< model of the task, or nullptr for a constant cost
+        void* context;     //!< argument of the model
+        U32 cycles;        //!< constant cost
+        U32 jitterCycles;  //!< largest random addition to the constant cost
+    };
+
+    //! \brief find the cost entry of a task, or add one
+    CostEntry& getCostEntry(Task* task);
+
+    //! \brief fire each tick whose time has come, once
+    void fireTicks();
+
+    //! \brief move time to the next tick, delay end or end of the run, whichever comes first
+    void skipIdle(U64 endUs);
+
+    //! \brief convert cycles to microseconds, rounding down
+    U64 toUs(U64 cycles) const;
+
+    //! \brief convert microseconds to cycles, rounding up
+    U64 toCycles(U64 timeUs) const;
+
+    //! \brief runner clock reading virtual time
+    static U64 readTimeUs(void* simulator);
+
+    //! \brief `BaremetalRawTime` counter reading virtual cycles
+    static U64 readCycles(void* simulator);
+
+    //! \brief runner work hook charging the cost of a unit of work and firing the ticks it reached
+    static void onWork(void* simulator, Task& task);
+
+    //! \brief runner delay hook for delays outside of units of work, which would never end on virtual time
+    static bool onDelay(void* simulator, U64 delayUs);
+
+    TaskRunner& m_runner;                           //!< runner of the simulated tasks
+    U64 m_cycles = 0;                               //!< virtual time
+    U64 m_units = 0;                                //!< units of work run
+    U64 m_ticks = 0;                                //!< ticks fired
+    U32 m_frequencyHz;                              //!< cycles per second
+    U32 m_random;                                   //!< state of the xorshift random numbers
+    U32 m_defaultCycles = 1;                        //!< cost of tasks without an entry
+    bool m_attached = false;                        //!< the runner reads virtual time
+    TickEntry m_tickEntries[TASK_SIMULATOR_TICKS];  //!< periodic ticks
+    FwSizeType m_tickCount = 0;                     //!< ticks in use
+    CostEntry m_costs[TASK_SIMULATOR_COSTS];        //!< tasks with a cost of their own
+    FwSizeType m_costCount = 0;                     //!< cost entries in use
+};
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_SIMULATION_TASKSIMULATOR_HPP_ */
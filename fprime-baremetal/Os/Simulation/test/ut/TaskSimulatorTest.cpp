@@ -0,0 +1,201 @@
+// ----------------------------------------------------------------------
+// TaskSimulatorTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/RawTime.hpp>
+#include <Os/Task.hpp>
+#include <fprime-baremetal/Os/Simulation/TaskSimulator.hpp>
+
+namespace {
+
+const U32 FREQUENCY_HZ = 100000000;  //!< 100 MHz virtual processor
+const U64 SECOND_US = 1000000;
+
+struct RateGroup {
+    Os::Task task;
+    U32 cycles = 0;  //!< units of work run
+};
+
+void cycle(void* argument) {
+    static_cast<RateGroup*>(argument)->cycles++;
+}
+
+void tick(void* argument) {
+    RateGroup& group = *static_cast<RateGroup*>(argument);
+    Os::Baremetal::TaskRunner::getSingleton().wakeFromIsr(&group.task);
+}
+
+void sleep(void* argument) {
+    // The first run, from Os::Task::start, is outside of any unit of work and only sets up
+    if (Os::Baremetal::TaskRunner::getSingleton().getCurrentTask() != nullptr) {
+        (*static_cast<U32*>(argument))++;
+        Os::Task::delay(Fw::TimeInterval(1, 0));
+    }
+}
+
+void drained(void* argument) {
+    (*static_cast<U32*>(argument))++;
+}
+
+//! \brief tick measuring how late it fires after its time
+struct LateTick {
+    Os::Baremetal::TaskSimulator* simulator = nullptr;
+    U64 nextUs = 0;     //!< time of the next tick
+    U64 maxLateUs = 0;  //!< longest delay between the time of a tick and its firing
+};
+
+void lateTick(void* argument) {
+    LateTick& late = *static_cast<LateTick*>(argument);
+    const U64 lateUs = late.simulator->getTimeUs() - late.nextUs;
+    late.maxLateUs = (lateUs > late.maxLateUs) ? lateUs : late.maxLateUs;
+    late.nextUs += 1000;
+}
+
+void startTask(Os::Task& task, Os::Task::taskRoutine routine, void* argument) {
+    Fw::String name("simulated");
+    Os::Task::Arguments arguments(name, routine, argument, 100);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+}
+
+//! \brief start a rate group driven at 1 kHz, costing 20 us and up to 10 us more per cycle
+void startRateGroup(Os::Baremetal::TaskSimulator& simulator, RateGroup& group) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    startTask(group.task, cycle, &group);
+    group.cycles = 0;
+    runner.setWaitForWake(&group.task, true);
+    simulator.setCost(&group.task, 2000, 1000);
+    simulator.addTick(1000, tick, &group, 100);
+}
+
+//! \brief run a minute of a jittery rate group and return the processor time it used
+U64 runJitteryMinute(U32 seed, U32& maxUs) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Baremetal::TaskSimulator simulator(runner, FREQUENCY_HZ, seed);
+    simulator.attach();
+    RateGroup group;
+    startRateGroup(simulator, group);
+    U64 usedBeforeUs = 0;
+    U64 usedAfterUs = 0;
+    U64 totalUs = 0;
+    runner.getCpuTime(usedBeforeUs, totalUs);
+    simulator.runFor(60 * SECOND_US);
+    runner.getCpuTime(usedAfterUs, totalUs);
+    maxUs = 0;
+#if TASK_RUNNER_PROFILING
+    Os::Baremetal::TaskProfile profile;
+    EXPECT_TRUE(runner.getProfile(&group.task, profile));
+    maxUs = profile.maxUs;
+#endif
+    runner.removeTask(&group.task);
+    return usedAfterUs - usedBeforeUs;
+}
+
+}  // namespace
+
+TEST(TaskSimulator, RateGroupOnVirtualTime) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Baremetal::TaskSimulator simulator(runner, FREQUENCY_HZ);
+    simulator.attach();
+    RateGroup group;
+    startRateGroup(simulator, group);
+
+    // Ten virtual minutes: one cycle per tick, each costing 20 to 30 us plus 1 us for the tick
+    Os::RawTime start;
+    ASSERT_EQ(Os::RawTime::Status::OP_OK, start.now());
+    simulator.runFor(600 * SECOND_US);
+    EXPECT_EQ(600 * SECOND_US, simulator.getTimeUs());
+    EXPECT_EQ(600000, simulator.getTicks());
+    EXPECT_EQ(600000, group.cycles);
+    // Ticks interrupt idle time, so the load is that of the cycles alone, about 2.5 %
+    U64 usedUs = 0;
+    U64 totalUs = 0;
+    runner.getCpuTime(usedUs, totalUs);
+    EXPECT_GE(usedUs * 50, totalUs);
+    EXPECT_LE(usedUs * 100, totalUs * 3);
+
+    // Os::RawTime reads the virtual counter
+    Os::RawTime end;
+    ASSERT_EQ(Os::RawTime::Status::OP_OK, end.now());
+    Fw::TimeInterval interval;
+    ASSERT_EQ(Os::RawTime::Status::OP_OK, end.getTimeInterval(start, interval));
+    EXPECT_EQ(600, interval.getSeconds());
+
+#if TASK_RUNNER_PROFILING
+    // Units of work are timed on virtual time too
+    Os::Baremetal::TaskProfile profile;
+    ASSERT_TRUE(runner.getProfile(&group.task, profile));
+    EXPECT_GE(profile.maxUs, 20);
+    EXPECT_LE(profile.maxUs, 31);
+#endif
+    runner.removeTask(&group.task);
+}
+
+TEST(TaskSimulator, IdleTimeIsSkipped) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Baremetal::TaskSimulator simulator(runner, FREQUENCY_HZ);
+    simulator.attach();
+    Os::Task task;
+    U32 wakeups = 0;
+    startTask(task, sleep, &wakeups);
+
+    // Two days of a task sleeping a second at a time jump from delay to delay
+    simulator.runFor(2 * 86400 * SECOND_US);
+    EXPECT_EQ(2 * 86400 * SECOND_US, simulator.getTimeUs());
+    EXPECT_EQ(2 * 86400, wakeups);
+    EXPECT_EQ(2 * 86400, simulator.getUnits());
+    runner.removeTask(&task);
+}
+
+TEST(TaskSimulator, TicksFireWithinDrainedSlices) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Baremetal::TaskSimulator simulator(runner, FREQUENCY_HZ);
+    simulator.attach();
+    RateGroup group;
+    startRateGroup(simulator, group);
+    Os::Task task;
+    U32 units = 0;
+    startTask(task, drained, &units);
+    simulator.setCost(&task, 1000);
+    runner.setWaitForWake(&task, true, 200000);
+    runner.setDrain(&task, 1000, 5000);
+    runner.setDrain(&group.task, 10);
+    LateTick late;
+    late.simulator = &simulator;
+    simulator.addTick(1000, lateTick, &late);
+
+    // Slices of 5 ms of 10 us units are interrupted by the ticks at their time, not after the slice. A tick is late by
+    // at most the unit of work it interrupts, the longest being a rate group cycle of up to 30 us and its tick
+    simulator.runFor(SECOND_US);
+    EXPECT_LE(late.maxLateUs, 32);
+    EXPECT_GE(late.nextUs, SECOND_US);
+    EXPECT_GE(group.cycles + 10, simulator.getTicks() / 2);
+    EXPECT_GT(units, 90000);
+    runner.removeTask(&task);
+    runner.removeTask(&group.task);
+}
+
+TEST(TaskSimulator, DelayOutsideWorkAsserts) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Baremetal::TaskSimulator simulator(runner, FREQUENCY_HZ);
+    simulator.attach();
+    ASSERT_DEATH_IF_SUPPORTED(Os::Task::delay(Fw::TimeInterval(0, 1000)), "");
+}
+
+TEST(TaskSimulator, RunsAreReproducible) {
+    U32 firstMaxUs = 0;
+    U32 secondMaxUs = 0;
+    U32 otherMaxUs = 0;
+    const U64 first = runJitteryMinute(7, firstMaxUs);
+    const U64 second = runJitteryMinute(7, secondMaxUs);
+    const U64 other = runJitteryMinute(8, otherMaxUs);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(firstMaxUs, secondMaxUs);
+    EXPECT_NE(first, other);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,88 @@
+// ======================================================================
+// \title fprime-baremetal/Os/TaskRunner/DeadlineHeap.cpp
+// \brief DeadlineHeap implementations
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/TaskRunner/DeadlineHeap.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+// out-of-line definitions for constants that are odr-used (required before C++17)
+constexpr U16 DeadlineHeap::NOT_QUEUED;
+
+DeadlineHeap::DeadlineHeap() : m_count(0) {
+    for (FwSizeType i = 0; i < TASK_RUNNER_CAPACITY; i++) {
+        this->m_nodes[i] = nullptr;
+    }
+}
+
+FwSizeType DeadlineHeap::getCount() const {
+    return this->m_count;
+}
+
+TaskRunnerNode* DeadlineHeap::getEarliest() const {
+    return (this->m_count == 0) ? nullptr : this->m_nodes[0];
+}
+
+void DeadlineHeap::push(TaskRunnerNode& node) {
+    FW_ASSERT(node.heapIndex == NOT_QUEUED);
+    FW_ASSERT(this->m_count < TASK_RUNNER_CAPACITY, static_cast<FwAssertArgType>(this->m_count));
+    this->m_nodes[this->m_count] = &node;
+    node.heapIndex = static_cast<U16>(this->m_count);
+    this->m_count++;
+    this->restore(node.heapIndex);
+}
+
+void DeadlineHeap::remove(TaskRunnerNode& node) {
+    const FwSizeType index = node.heapIndex;
+    FW_ASSERT(index < this->m_count, static_cast<FwAssertArgType>(index));
+    FW_ASSERT(this->m_nodes[index] == &node);
+    // Fill the hole with the last node, which may then belong higher or lower
+    this->m_count--;
+    if (index != this->m_count) {
+        this->swap(index, this->m_count);
+        this->restore(index);
+    }
+    this->m_nodes[this->m_count] = nullptr;
+    node.heapIndex = NOT_QUEUED;
+}
+
+bool DeadlineHeap::isBefore(FwSizeType a, FwSizeType b) const {
+    return this->m_nodes[a]->deadlineAtUs < this->m_nodes[b]->deadlineAtUs;
+}
+
+void DeadlineHeap::swap(FwSizeType a, FwSizeType b) {
+    TaskRunnerNode* const node = this->m_nodes[a];
+    this->m_nodes[a] = this->m_nodes[b];
+    this->m_nodes[b] = node;
+    this->m_nodes[a]->heapIndex = static_cast<U16>(a);
+    this->m_nodes[b]->heapIndex = static_cast<U16>(b);
+}
+
+void DeadlineHeap::restore(FwSizeType index) {
+    while ((index > 0) and this->isBefore(index, (index - 1) / 2)) {
+        this->swap(index, (index - 1) / 2);
+        index = (index - 1) / 2;
+    }
+    while (true) {
+        const FwSizeType left = (2 * index) + 1;
+        const FwSizeType right = left + 1;
+        FwSizeType earliest = index;
+        if ((left < this->m_count) and this->isBefore(left, earliest)) {
+            earliest = left;
+        }
+        if ((right < this->m_count) and this->isBefore(right, earliest)) {
+            earliest = right;
+        }
+        if (earliest == index) {
+            return;
+        }
+        this->swap(index, earliest);
+        index = earliest;
+    }
+}
+
+}  // End namespace Baremetal
+}  // End Namespace Os
@@ -0,0 +1,56 @@
+// ======================================================================
+// \title fprime-baremetal/Os/TaskRunner/DeadlineHeap.hpp
+// \brief DeadlineHeap definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_TASKRUNNER_DEADLINEHEAP_HPP_
+#define FPRIME_BAREMETAL_TASKRUNNER_DEADLINEHEAP_HPP_
+#include <Fw/Types/BasicTypes.hpp>
+#include "config/TaskRunnerCfg.hpp"
+
+namespace Os {
+namespace Baremetal {
+
+struct TaskRunnerNode;
+
+//! \brief binary min-heap of ready tasks ordered by absolute deadline
+//!
+//! Used by the earliest deadline first policy of the task runner. Pushing and removing take logarithmic time and the
+//! node with the earliest deadline is found in constant time. Each node records its position, so any node can be
+//! removed, for example when its task is suspended or removed.
+class DeadlineHeap {
+  public:
+    static constexpr U16 NOT_QUEUED = 0xFFFF;  //!< heap index of nodes not in the heap
+
+    static_assert(TASK_RUNNER_CAPACITY < NOT_QUEUED, "Heap indices must fit in a U16");
+
+    //! Empty heap
+    DeadlineHeap();
+
+    //! \brief get the number of nodes in the heap
+    FwSizeType getCount() const;
+
+    //! \brief get the node with the earliest deadline, or nullptr when empty
+    TaskRunnerNode* getEarliest() const;
+
+    //! \brief add a node, ordered by its `deadlineAtUs`
+    void push(TaskRunnerNode& node);
+
+    //! \brief take a node out of the heap
+    void remove(TaskRunnerNode& node);
+
+  private:
+    //! \brief check whether the node at index a is due before the node at index b
+    bool isBefore(FwSizeType a, FwSizeType b) const;
+
+    //! \brief exchange two nodes, keeping their indices up to date
+    void swap(FwSizeType a, FwSizeType b);
+
+    //! \brief move a node up or down until the heap is ordered again
+    void restore(FwSizeType index);
+
+    TaskRunnerNode* m_nodes[TASK_RUNNER_CAPACITY];  //!< heap ordered array
+    FwSizeType m_count;                             //!< nodes in the heap
+};
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_TASKRUNNER_DEADLINEHEAP_HPP_ */
@@ -7,17 +7,63 @@
 #include <fprime-baremetal/Os/Baremetal/Task.hpp>
 #include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
 
+#include <limits>
+
 namespace Os {
 namespace Baremetal {
 
-bool isRunning(Task& task) {
-    return (task.getState() == Os::Task::State::STARTING || task.getState() == Os::Task::RUNNING);
+//! \brief index of the highest bit set
+static FwSizeType highestLevel(U32 levels) {
+    FW_ASSERT(levels != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<FwSizeType>(31 - __builtin_clz(levels));
+#else
+    FwSizeType level = 0;
+    while ((levels >>= 1) != 0) {
+        level++;
+    }
+    return level;
+#endif
+}
+
+void TaskRunnerNode::append(TaskRunnerNode*& head, TaskRunnerNode& node) {
+    FW_ASSERT(node.next == nullptr);
+    if (head == nullptr) {
+        node.next = &node;
+        node.previous = &node;
+        head = &node;
+    }
+    // Insert before the head, which is the tail of the circular list
+    else {
+        node.next = head;
+        node.previous = head->previous;
+        head->previous->next = &node;
+        head->previous = &node;
+    }
+}
+
+void TaskRunnerNode::remove(TaskRunnerNode*& head, TaskRunnerNode& node) {
+    FW_ASSERT(node.next != nullptr);
+    if (head == &node) {
+        head = (node.next == &node) ? nullptr : node.next;
+    }
+    node.previous->next = node.next;
+    node.next->previous = node.previous;
+    node.next = nullptr;
+    node.previous = nullptr;
 }
 
-TaskRunner::TaskRunner() {
-    // Initialize all elements in the task table to nullptr
-    for (U32 i = 0; i < Os::Baremetal::TASK_CAPACITY; i++) {
-        this->m_task_table[i] = nullptr;
+TaskRunner::TaskRunner()
+    : m_current(&m_lists[0]), m_next(&m_lists[1]), m_clock(TaskRunner::getRawTimeUs), m_clockContext(this) {
+    // Initialize all ready lists to empty
+    for (FwSizeType i = 0; i < 2; i++) {
+        this->m_lists[i].groups = 0;
+        for (FwSizeType group = 0; group < TASK_LEVEL_GROUPS; group++) {
+            this->m_lists[i].levels[group] = 0;
+        }
+        for (FwSizeType level = 0; level < TASK_RUNNER_PRIORITY_LEVELS; level++) {
+            this->m_lists[i].heads[level] = nullptr;
+        }
     }
     Task::registerTaskRegistry(this);
 }
@@ -25,45 +71,441 @@ TaskRunner::TaskRunner() {
 TaskRunner::~TaskRunner() {}
 
 void TaskRunner::addTask(Task* task) {
+    FW_ASSERT(task != nullptr);
     FW_ASSERT(task->isCooperative());  // Cannot register uncooperative tasks
+    FW_ASSERT(this->m_count < Os::Baremetal::TASK_CAPACITY, static_cast<FwAssertArgType>(this->m_count));
 
-    FW_ASSERT(this->m_index < Os::Baremetal::TASK_CAPACITY);
-    this->m_task_table[this->m_index] = task;
-    this->m_index++;
+    TaskRunnerNode& node = getNode(*task);
+    FW_ASSERT(node.task == nullptr);  // Cannot register a task twice
+    node.task = task;
+    node.runner = this;
+    node.level = static_cast<U16>(getLevel(task->getPriority()));
+    node.parked = false;
+    node.periodUs = 0;
+    node.deadlineUs = 0;
+    node.budgetUs = 0;
+#if TASK_RUNNER_PROFILING
+    node.profile = TaskProfile();
+#endif
+#if TASK_RUNNER_PROFILING || TASK_RUNNER_TRACING
+    node.registered = this->m_registered;
+    this->m_registered = &node;
+#endif
+#if TASK_RUNNER_TRACING
+    // Ids are not reused until they wrap, so events of a removed task are not taken for another one
+    this->m_traceIds = (this->m_traceIds == std::numeric_limits<U16>::max()) ? 1 : (this->m_traceIds + 1);
+    node.traceId = this->m_traceIds;
+#endif
+    this->schedule(*this->m_current, node);
+    this->m_count++;
+}
+
+void TaskRunner::removeTask(Task* task) {
+    FW_ASSERT(task != nullptr);
+    TaskRunnerNode& node = getNode(*task);
+    // Tasks that were never added, or were added elsewhere, are ignored
+    if ((node.task != task) or (node.runner != this)) {
+        return;
+    }
+    // The task may be destroyed once removed, so it must not stay in the list of tasks woken from interrupts
+    if (node.isrQueued.load(std::memory_order_acquire)) {
+        this->collectIsrWakeups();
+    }
+    if (node.delayed) {
+        this->m_timers.cancel(node);
+    }
+    this->unlink(node);
+#if TASK_RUNNER_PROFILING || TASK_RUNNER_TRACING
+    TaskRunnerNode** link = &this->m_registered;
+    while (*link != &node) {
+        FW_ASSERT(*link != nullptr);
+        link = &(*link)->registered;
+    }
+    *link = node.registered;
+    node.registered = nullptr;
+#endif
+    node.task = nullptr;
+    node.runner = nullptr;
+    node.parked = false;
+    this->m_count--;
+}
+
+void TaskRunner::resumeTask(Task* task) {
+    FW_ASSERT(task != nullptr);
+    TaskRunnerNode& node = getNode(*task);
+    if (node.runner == this) {
+        this->makeReady(node);
+    }
+}
+
+void TaskRunner::setPolicy(Policy policy) {
+    // Ready tasks are kept in the structure of the policy that was in place when they became ready
+    FW_ASSERT(this->m_count == 0, static_cast<FwAssertArgType>(this->m_count));
+    this->m_policy = policy;
+}
+
+void TaskRunner::setTiming(Task* task, U32 periodUs, U32 deadlineUs, U32 budgetUs) {
+    FW_ASSERT(task != nullptr);
+    FW_ASSERT((periodUs != 0) or ((deadlineUs == 0) and (budgetUs == 0)));
+    TaskRunnerNode& node = getNode(*task);
+    FW_ASSERT(node.runner == this);
+    // A ready task may move between the deadline heap and the ready lists
+    const bool ready =
+        ((node.next != nullptr) and (not node.delayed)) or (node.heapIndex != DeadlineHeap::NOT_QUEUED);
+    this->unlink(node);
+    node.periodUs = periodUs;
+    node.deadlineUs = (deadlineUs == 0) ? periodUs : deadlineUs;
+    node.budgetUs = budgetUs;
+    node.usedUs = 0;
+    node.windowStartUs = this->getTimeUs();
+    if (ready) {
+        this->schedule(*this->m_current, node);
+    }
+}
 
-    // Sort by priority during insertion
-    Task* sort_element = task;
-    for (FwSizeType i = 0; (sort_element != nullptr) && (i < Os::Baremetal::TASK_CAPACITY); i++) {
-        if ((this->m_task_table[i] == nullptr) or
-            (sort_element->getPriority() > this->m_task_table[i]->getPriority())) {
-            Task* temp = sort_element;
-            sort_element = this->m_task_table[i];
-            this->m_task_table[i] = temp;
+void TaskRunner::setDrain(Task* task, U16 maxUnits, U32 sliceUs, bool adaptive) {
+    FW_ASSERT(task != nullptr);
+    FW_ASSERT(maxUnits > 0);
+    TaskRunnerNode& node = getNode(*task);
+    FW_ASSERT(node.runner == this);
+    node.drainUnits = maxUnits;
+    node.drainUs = sliceUs;
+    node.drainAdaptive = adaptive;
+}
+
+void TaskRunner::setWaitForWake(Task* task, bool waitForWake, U32 wakeups) {
+    FW_ASSERT(task != nullptr);
+    TaskRunnerNode& node = getNode(*task);
+    FW_ASSERT(node.runner == this);
+    node.waitsForWake = waitForWake;
+    node.wakeups = wakeups;
+    // A task that no longer waits may have been parked while waiting
+    this->makeReady(node);
+}
+
+void TaskRunner::wake(Task* task) {
+    FW_ASSERT(task != nullptr);
+    TaskRunnerNode& node = getNode(*task);
+    if (node.runner != this) {
+        return;
+    }
+    // Saturate rather than wrap, a wrapped count would lose all pending work
+    if (node.wakeups != std::numeric_limits<U32>::max()) {
+        node.wakeups++;
+    }
+    this->makeReady(node);
+}
+
+#if TASK_RUNNER_ISR_WAKEUPS
+void TaskRunner::wakeFromIsr(Task* task) {
+    FW_ASSERT(task != nullptr);
+    TaskRunnerNode& node = getNode(*task);
+    node.isrWakeups.fetch_add(1, std::memory_order_relaxed);
+    // Only the first wakeup since the runner last took the list pushes the node
+    if (node.isrQueued.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    TaskRunnerNode* head = this->m_isrWoken.load(std::memory_order_relaxed);
+    do {
+        node.isrNext = head;
+    } while (not this->m_isrWoken.compare_exchange_weak(head, &node, std::memory_order_release,
+                                                         std::memory_order_relaxed));
+}
+#endif
+
+void TaskRunner::collectIsrWakeups() {
+#if TASK_RUNNER_ISR_WAKEUPS
+    // Interrupts only ever push, so taking the whole list at once is safe without further synchronization
+    TaskRunnerNode* node = this->m_isrWoken.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+        TaskRunnerNode* const next = node->isrNext;
+        node->isrNext = nullptr;
+        // Cleared before the count is taken, so a wakeup coming in between pushes the node again
+        node->isrQueued.store(false, std::memory_order_release);
+        const U32 wakeups = node->isrWakeups.exchange(0, std::memory_order_acq_rel);
+        if (node->runner == this) {
+            const U32 room = std::numeric_limits<U32>::max() - node->wakeups;
+            node->wakeups += (wakeups < room) ? wakeups : room;
+            this->makeReady(*node);
         }
+        node = next;
     }
+#endif
+}
 
-    // The last sort element must be nullptr or the table overflowed
-    FW_ASSERT(sort_element == nullptr);
+Task* TaskRunner::getCurrentTask() const {
+    return this->m_currentTask;
 }
 
-void TaskRunner::removeTask(Task* task) {
-    bool found = false;
-    // Squash that existing task
-    for (FwSizeType i = 0; i < Os::Baremetal::TASK_CAPACITY; i++) {
-        found = found | (task == this->m_task_table[i]);
-        // If not found, keep looking
-        if (not found) {
-            continue;
+bool TaskRunner::hasReadyTask() const {
+    return ((this->m_lists[0].groups | this->m_lists[1].groups) != 0) or (this->m_deadlines.getCount() > 0) or
+           (this->m_isrWoken.load(std::memory_order_relaxed) != nullptr);
+}
+
+bool TaskRunner::delayCurrentTask(U64 delayUs) {
+    if (this->m_currentTask == nullptr) {
+        return (this->m_delayHook != nullptr) and this->m_delayHook(this->m_delayContext, delayUs);
+    }
+    // A task parked against a clock that stands still would never be woken
+    FW_ASSERT(this->hasClock());
+    TaskRunnerNode& node = getNode(*this->m_currentTask);
+    // A second delay from the same unit of work replaces the first
+    if (node.delayed) {
+        this->m_timers.cancel(node);
+    }
+    const U64 nowUs = this->getTimeUs();
+    this->delayNode(node, nowUs, nowUs + delayUs);
+    return true;
+}
+
+void TaskRunner::delayNode(TaskRunnerNode& node, U64 nowUs, U64 untilUs, bool throttle) {
+    // Round the end of the delay up to a whole tick, so the task never runs early
+    const U32 deadline = static_cast<U32>((untilUs + TASK_RUNNER_TICK_US - 1) / TASK_RUNNER_TICK_US);
+    // A throttle outlasting a delay asked for by the task still ends with the wakeup of that delay
+    const bool throttled = throttle and ((not node.delayed) or node.throttled);
+    if (node.delayed) {
+        if (static_cast<I32>(node.deadline - deadline) >= 0) {
+            return;
         }
-        // If we are less than the end of the array, shift variables over
-        else if (i < Os::Baremetal::TASK_CAPACITY - 1) {
-            this->m_task_table[i] = this->m_task_table[i + 1];
+        this->m_timers.cancel(node);
+    }
+    node.throttled = throttled;
+    const U32 tick = static_cast<U32>(nowUs / TASK_RUNNER_TICK_US);
+    if (this->m_timers.isEmpty()) {
+        this->m_timers.jump(tick);
+    } else {
+        this->m_timers.advance(tick, TaskRunner::onDelayExpired, this);
+    }
+    // A delay that already ended leaves the task ready
+    (void)this->m_timers.insert(node, deadline);
+}
+
+bool TaskRunner::hasDelayedTask() const {
+    return not this->m_timers.isEmpty();
+}
+
+bool TaskRunner::getDelayEndUs(U64& endUs) {
+    U32 deadline = 0;
+    if (not this->m_timers.getEarliestDeadline(deadline)) {
+        return false;
+    }
+    // Deadlines are ticks of 32 bits, counted from the tick of the clock so long runs stay in range
+    const U64 nowTicks = this->getTimeUs() / TASK_RUNNER_TICK_US;
+    const I32 ahead = static_cast<I32>(deadline - static_cast<U32>(nowTicks));
+    endUs = (nowTicks + ((ahead > 0) ? static_cast<U64>(ahead) : 0)) * TASK_RUNNER_TICK_US;
+    return true;
+}
+
+U64 TaskRunner::getTimeUs() {
+    return this->m_clock(this->m_clockContext);
+}
+
+bool TaskRunner::hasClock() {
+    if (this->m_clock != TaskRunner::getRawTimeUs) {
+        return true;
+    }
+    Os::RawTime now;
+    return now.now() == Os::RawTime::OP_OK;
+}
+
+void TaskRunner::setClock(Clock clock, void* context) {
+    // Delays were counted on the previous clock
+    FW_ASSERT(this->m_timers.isEmpty());
+    this->m_clock = (clock == nullptr) ? TaskRunner::getRawTimeUs : clock;
+    this->m_clockContext = (clock == nullptr) ? this : context;
+    this->m_loadStarted = false;
+    this->m_idle = false;
+    this->m_idleUs = 0;
+}
+
+void TaskRunner::getCpuTime(U64& usedUs, U64& totalUs) {
+    if (not this->m_loadStarted) {
+        usedUs = 0;
+        totalUs = 0;
+        return;
+    }
+    const U64 nowUs = this->getTimeUs();
+    U64 idleUs = this->m_idleUs;
+    if (this->m_idle) {
+        idleUs += nowUs - this->m_idleSinceUs;
+    }
+    totalUs = nowUs - this->m_loadStartUs;
+    // Clocks that are coarser than the idle periods may round idle time up past the elapsed time
+    usedUs = (idleUs < totalUs) ? (totalUs - idleUs) : 0;
+}
+
+#if TASK_RUNNER_PROFILING
+void TaskRunner::setBudget(Task* task, U32 budgetUs) {
+    FW_ASSERT(task != nullptr);
+    TaskRunnerNode& node = getNode(*task);
+    FW_ASSERT(node.runner == this);
+    node.profile.budgetUs = budgetUs;
+}
+
+bool TaskRunner::getProfile(Task* task, TaskProfile& profile) {
+    FW_ASSERT(task != nullptr);
+    TaskRunnerNode& node = getNode(*task);
+    if (node.runner != this) {
+        return false;
+    }
+    profile = node.profile;
+    return true;
+}
+
+void TaskRunner::visitProfiles(ProfileVisitor visitor, void* context, bool restartWindow) {
+    FW_ASSERT(visitor != nullptr);
+    for (TaskRunnerNode* node = this->m_registered; node != nullptr; node = node->registered) {
+        visitor(context, *node->task, node->profile);
+        if (restartWindow) {
+            node->profile.windowRuns = 0;
+            node->profile.windowUs = 0;
+            node->profile.windowMaxUs = 0;
+            node->profile.windowOverruns = 0;
+        }
+    }
+}
+
+void TaskRunner::recordSlice(TaskProfile& profile, U64 durationUs) {
+    const U32 duration = (durationUs > std::numeric_limits<U32>::max()) ? std::numeric_limits<U32>::max()
+                                                                         : static_cast<U32>(durationUs);
+    profile.runs++;
+    profile.windowRuns++;
+    profile.totalUs += duration;
+    profile.windowUs += duration;
+    if (duration > profile.maxUs) {
+        profile.maxUs = duration;
+    }
+    if (duration > profile.windowMaxUs) {
+        profile.windowMaxUs = duration;
+    }
+    if ((profile.budgetUs != 0) and (duration > profile.budgetUs)) {
+        profile.overruns++;
+        profile.windowOverruns++;
+    }
+    // Bucket n holds durations whose highest set bit is bit n - 1
+    FwSizeType bucket = (duration == 0) ? 0 : (highestLevel(duration) + 1);
+    if (bucket >= TASK_RUNNER_PROFILE_BUCKETS) {
+        bucket = TASK_RUNNER_PROFILE_BUCKETS - 1;
+    }
+    profile.histogram[bucket]++;
+}
+#endif
+
+#if TASK_RUNNER_TRACING
+//! \brief put a little-endian 16 bit value in a buffer
+static void putU16(U8* buffer, U16 value) {
+    buffer[0] = static_cast<U8>(value);
+    buffer[1] = static_cast<U8>(value >> 8);
+}
+
+//! \brief put a little-endian 32 bit value in a buffer
+static void putU32(U8* buffer, U32 value) {
+    putU16(buffer, static_cast<U16>(value));
+    putU16(buffer + 2, static_cast<U16>(value >> 16));
+}
+
+//! \brief trace writer appending to an open file
+static bool writeTraceFile(void* context, const U8* data, FwSizeType size) {
+    Os::File& file = *static_cast<Os::File*>(context);
+    FwSizeType written = size;
+    return (file.write(data, written) == Os::File::OP_OK) and (written == size);
+}
+
+void TaskRunner::mark(U16 marker, U8 data) {
+    this->m_trace.record(static_cast<U32>(this->getTimeUs()), TRACE_MARKER, marker, data);
+}
+
+bool TaskRunner::dumpTrace(TraceWriter writer, void* context) {
+    FW_ASSERT(writer != nullptr);
+    const FwSizeType maxName = 64;  // Longer names are cut, the decoder only needs to tell tasks apart
+    U8 record[3 + maxName];
+    FwSizeType names = 0;
+    for (TaskRunnerNode* node = this->m_registered; node != nullptr; node = node->registered) {
+        names++;
+    }
+    const FwSizeType count = this->m_trace.getCount();
+    U8 header[16] = {'F', 'T', 'R', 'C', 1, 0};
+    putU16(&header[6], static_cast<U16>(names));
+    putU32(&header[8], static_cast<U32>(count));
+    putU32(&header[12], this->m_trace.getRecorded() - static_cast<U32>(count));
+    if (not writer(context, header, sizeof(header))) {
+        return false;
+    }
+    for (TaskRunnerNode* node = this->m_registered; node != nullptr; node = node->registered) {
+        const Fw::StringBase& name = node->task->getName();
+        const char* characters = name.toChar();
+        FwSizeType length = 0;
+        while ((length < maxName) and (characters[length] != '\0')) {
+            record[3 + length] = static_cast<U8>(characters[length]);
+            length++;
         }
-        // If the last element, mark NULL
-        else {
-            this->m_task_table[i] = nullptr;
+        putU16(&record[0], node->traceId);
+        record[2] = static_cast<U8>(length);
+        if (not writer(context, record, 3 + length)) {
+            return false;
         }
     }
+    // Events go out a few at a time, to keep the number of writes down without a large buffer
+    U8 events[8 * 8];
+    FwSizeType filled = 0;
+    for (FwSizeType i = 0; i < count; i++) {
+        const TraceEntry& entry = this->m_trace.get(i);
+        putU32(&events[filled], entry.timeUs);
+        putU16(&events[filled + 4], entry.id);
+        events[filled + 6] = entry.event;
+        events[filled + 7] = entry.data;
+        filled += 8;
+        if ((filled == sizeof(events)) or (i == (count - 1))) {
+            if (not writer(context, events, filled)) {
+                return false;
+            }
+            filled = 0;
+        }
+    }
+    return true;
+}
+
+Os::File::Status TaskRunner::dumpTraceToFile(const char* path) {
+    FW_ASSERT(path != nullptr);
+    Os::File file;
+    Os::File::Status status = file.open(path, Os::File::OPEN_CREATE, Os::File::OVERWRITE);
+    if (status != Os::File::OP_OK) {
+        return status;
+    }
+    if (not this->dumpTrace(writeTraceFile, &file)) {
+        status = Os::File::OTHER_ERROR;
+    }
+    file.close();
+    return status;
+}
+
+void TaskRunner::clearTrace() {
+    this->m_trace.clear();
+}
+
+void TaskRunner::removeExited(Task& task) {
+    this->m_trace.record(static_cast<U32>(this->getTimeUs()), TRACE_TASK_EXIT, getNode(task).traceId, 0);
+    this->removeTask(&task);
+}
+#else
+void TaskRunner::removeExited(Task& task) {
+    this->removeTask(&task);
+}
+#endif
+
+void TaskRunner::setIdleHook(IdleHook hook, void* context) {
+    this->m_idleHook = hook;
+    this->m_idleContext = context;
+}
+
+void TaskRunner::setWorkHook(WorkHook hook, void* context) {
+    this->m_workHook = hook;
+    this->m_workContext = context;
+}
+
+void TaskRunner::setDelayHook(DelayHook hook, void* context) {
+    this->m_delayHook = hook;
+    this->m_delayContext = context;
 }
 
 TaskRunner& TaskRunner::getSingleton() {
@@ -84,49 +526,387 @@ void TaskRunner::runOne(Task& task) {
     baremetal_handle.m_routine(baremetal_handle.m_argument);
 }
 
-bool TaskRunner::runNext() {
-    Task* task = this->m_task_table[this->m_index];
-    // Run a single task
-    if (task != nullptr && isRunning(*task)) {
-        this->runOne(*task);
-        // Check and remove exited task
-        if (task->getState() == Os::Task::State::EXITED) {
-            this->removeTask(task);
+TaskRunnerNode& TaskRunner::getNode(Task& task) {
+    return static_cast<BaremetalTaskHandle*>(task.getHandle())->m_node;
+}
+
+void TaskRunner::makeReady(TaskRunnerNode& node) {
+    if (node.parked and isReady(node)) {
+        node.parked = false;
+        this->schedule(*this->m_current, node);
+    }
+}
+
+bool TaskRunner::isReady(const TaskRunnerNode& node) {
+    const BaremetalTaskHandle& handle = *static_cast<BaremetalTaskHandle*>(node.task->getHandle());
+    return handle.m_enabled and (not node.delayed) and ((not node.waitsForWake) or (node.wakeups > 0));
+}
+
+void TaskRunner::expireDelays() {
+    if (not this->m_timers.isEmpty()) {
+        this->m_timers.advance(static_cast<U32>(this->getTimeUs() / TASK_RUNNER_TICK_US), TaskRunner::onDelayExpired,
+                               this);
+    }
+}
+
+void TaskRunner::onDelayExpired(void* runner, TaskRunnerNode& node) {
+    TaskRunner& self = *static_cast<TaskRunner*>(runner);
+    // The end of a delay counts as a wakeup, so tasks waiting for wakeups run once as well. The end of a throttle only
+    // lets the task use the wakeups it already had
+    if (node.waitsForWake and (not node.throttled) and (node.wakeups != std::numeric_limits<U32>::max())) {
+        node.wakeups++;
+    }
+    node.throttled = false;
+    node.parked = true;
+    self.makeReady(node);
+}
+
+U64 TaskRunner::getRawTimeUs(void* runner) {
+    TaskRunner& self = *static_cast<TaskRunner*>(runner);
+    // The epoch is only taken once it can be read
+    if (not self.m_epochSet) {
+        self.m_epochSet = self.m_epoch.now() == Os::RawTime::OP_OK;
+    }
+    Os::RawTime now;
+    Fw::TimeInterval interval;
+    if ((not self.m_epochSet) or (now.now() != Os::RawTime::OP_OK) or
+        (now.getTimeInterval(self.m_epoch, interval) != Os::RawTime::OP_OK)) {
+        return 0;
+    }
+    return (static_cast<U64>(interval.getSeconds()) * 1000000U) + interval.getUSeconds();
+}
+
+FwSizeType TaskRunner::getLevel(FwTaskPriorityType priority) {
+    // Spread the whole priority range evenly over the levels, higher priorities on higher levels
+    const U64 range = static_cast<U64>(std::numeric_limits<FwTaskPriorityType>::max()) + 1;
+    return static_cast<FwSizeType>((static_cast<U64>(priority) * TASK_RUNNER_PRIORITY_LEVELS) / range);
+}
+
+FwSizeType TaskRunner::getHighestLevel(const ReadyLists& lists) {
+    const FwSizeType group = highestLevel(lists.groups);
+    return (group * 32) + highestLevel(lists.levels[group]);
+}
+
+void TaskRunner::setLevel(ReadyLists& lists, FwSizeType level) {
+    lists.levels[level / 32] |= (static_cast<U32>(1) << (level % 32));
+    lists.groups |= (static_cast<U32>(1) << (level / 32));
+}
+
+void TaskRunner::clearLevel(ReadyLists& lists, FwSizeType level) {
+    lists.levels[level / 32] &= ~(static_cast<U32>(1) << (level % 32));
+    if (lists.levels[level / 32] == 0) {
+        lists.groups &= ~(static_cast<U32>(1) << (level / 32));
+    }
+}
+
+bool TaskRunner::runNext(bool allTasks) {
+    // Suspended tasks met on the way are parked, so each is skipped at most once until it is resumed
+    while (true) {
+        TaskRunnerNode* node = allTasks ? nullptr : this->m_deadlines.getEarliest();
+        if ((node == nullptr) and (this->m_current->groups != 0)) {
+            node = this->m_current->heads[getHighestLevel(*this->m_current)];
+        }
+        if (node == nullptr) {
+            return false;
+        }
+        // Under strict priority a task stays in the current pass, so it competes again right away
+        const bool samePass = (not allTasks) and (this->m_policy == Policy::STRICT_PRIORITY);
+        this->unlink(*node);
+        if (this->runNode(*node, samePass ? *this->m_current : *this->m_next)) {
+            return true;
+        }
+    }
+}
+
+bool TaskRunner::runNode(TaskRunnerNode& node, ReadyLists& ranLists) {
+    Task& task = *node.task;
+    if (task.getState() == Os::Task::State::EXITED) {
+        this->removeExited(task);
+        return false;
+    }
+    if (not isReady(node)) {
+        node.parked = true;
+        return false;
+    }
+
+    if (this->m_idle) {
+        this->leaveIdle();
+    }
+    // Slices are timed for profiling, tracing, budgets, draining limits and the periods of earliest deadline first
+    const bool budgeted = node.budgetUs != 0;
+    const bool released =
+        (this->m_policy == Policy::EARLIEST_DEADLINE) and (node.periodUs != 0) and (not node.waitsForWake);
+    const bool timed = (TASK_RUNNER_PROFILING != 0) or (TASK_RUNNER_TRACING != 0) or budgeted or released or
+                       (node.drainUs != 0);
+    const U32 limit = getDrainLimit(node);
+    const U64 startUs = timed ? this->getTimeUs() : 0;
+    U64 endUs = startUs;
+#if TASK_RUNNER_TRACING
+    // The node may be removed by its own routine, its id is kept for the end of the slice
+    const U16 traceId = node.traceId;
+    this->m_trace.record(static_cast<U32>(startUs), TRACE_DISPATCH, traceId, 0);
+#endif
+    this->m_currentTask = &task;
+    U32 units = 0;
+    while (true) {
+        this->runOne(task);
+        if (this->m_workHook != nullptr) {
+            this->m_workHook(this->m_workContext, task);
+        }
+        units++;
+        endUs = timed ? this->getTimeUs() : 0;
+        // The routine may have exited or removed the task, leaving the node to the checks below
+        if ((node.task != &task) or (task.getState() == Os::Task::State::EXITED)) {
+            break;
+        }
+        // One wakeup was used by this unit of work
+        if (node.waitsForWake and (node.wakeups > 0)) {
+            node.wakeups--;
         }
-        // Otherwise bump the next start task
-        else {
-            this->m_index = (this->m_index + 1) % Os::Baremetal::TASK_CAPACITY;
+        if (not keepDraining(node, units, limit, endUs - startUs)) {
+            break;
         }
+    }
+    this->m_currentTask = nullptr;
+#if TASK_RUNNER_TRACING
+    const U32 unitsMax = std::numeric_limits<U8>::max();
+    this->m_trace.record(static_cast<U32>(endUs), TRACE_SLICE_END, traceId,
+                         static_cast<U8>((units < unitsMax) ? units : unitsMax));
+#endif
+#if TASK_RUNNER_PROFILING
+    recordSlice(node.profile, endUs - startUs);
+#endif
+    // Check and remove exited task, unless the routine already removed it
+    if (node.task != &task) {
+        return true;
+    }
+    if (task.getState() == Os::Task::State::EXITED) {
+        this->removeExited(task);
         return true;
     }
-    this->m_index = (this->m_index + 1) % Os::Baremetal::TASK_CAPACITY;
-    return false;
+    if (budgeted) {
+        this->chargeBudget(node, startUs, endUs);
+    }
+    // Under earliest deadline first, a task always ready would always come back with the earliest deadline, so it is
+    // released once per period instead. Tasks waiting for wakeups are released by them, and delayed ones by their delay
+    if (released and (not node.delayed)) {
+        startPeriod(node, startUs);
+        this->delayNode(node, endUs, node.windowStartUs + node.periodUs, true);
+    }
+    // Delayed tasks are held by the timer wheel until their delay ends
+    if (node.delayed) {
+        return true;
+    }
+    // Tasks left without any wakeup stay out of the lists until woken
+    if (isReady(node)) {
+        this->schedule(ranLists, node);
+    } else {
+        node.parked = true;
+    }
+    return true;
+}
+
+U32 TaskRunner::getDrainLimit(const TaskRunnerNode& node) {
+    // Tasks running on every pass give no count of pending work to drain
+    if (not node.waitsForWake) {
+        return 1;
+    }
+    if (not node.drainAdaptive) {
+        return node.drainUnits;
+    }
+    const U32 half = (node.wakeups / 2) + (node.wakeups % 2);
+    return (half == 0) ? 1 : ((half < node.drainUnits) ? half : node.drainUnits);
+}
+
+bool TaskRunner::keepDraining(const TaskRunnerNode& node, U32 units, U32 limit, U64 elapsedUs) {
+    if ((units >= limit) or (node.wakeups == 0) or node.delayed or (not isReady(node))) {
+        return false;
+    }
+    if ((node.drainUs != 0) and (elapsedUs >= node.drainUs)) {
+        return false;
+    }
+    // A budget is exceeded by at most one unit of work, as without draining
+    return (node.budgetUs == 0) or ((node.usedUs + elapsedUs) < node.budgetUs);
+}
+
+void TaskRunner::chargeBudget(TaskRunnerNode& node, U64 startUs, U64 endUs) {
+    FW_ASSERT(node.periodUs != 0);
+    startPeriod(node, startUs);
+    const U64 usedUs = node.usedUs + (endUs - startUs);
+    node.usedUs = (usedUs > std::numeric_limits<U32>::max()) ? std::numeric_limits<U32>::max()
+                                                               : static_cast<U32>(usedUs);
+    // Out of budget, the task waits for the next period as if delayed
+    if (node.usedUs >= node.budgetUs) {
+        this->delayNode(node, endUs, node.windowStartUs + node.periodUs, true);
+    }
+}
+
+void TaskRunner::startPeriod(TaskRunnerNode& node, U64 nowUs) {
+    // Start a new period once the current one is over, keeping the phase of the periods
+    if ((nowUs - node.windowStartUs) >= node.periodUs) {
+        node.windowStartUs = nowUs - ((nowUs - node.windowStartUs) % node.periodUs);
+        node.usedUs = 0;
+    }
+}
+
+void TaskRunner::schedule(ReadyLists& lists, TaskRunnerNode& node) {
+    if ((this->m_policy == Policy::EARLIEST_DEADLINE) and (node.periodUs != 0)) {
+        // Each time the task becomes ready it must run within its relative deadline
+        node.deadlineAtUs = this->getTimeUs() + node.deadlineUs;
+        this->m_deadlines.push(node);
+    } else {
+        link(lists, node);
+    }
+}
+
+void TaskRunner::startCpuTime() {
+    if (not this->m_loadStarted) {
+        this->m_loadStartUs = this->getTimeUs();
+        this->m_loadStarted = true;
+    }
+}
+
+void TaskRunner::enterIdle() {
+    if (not this->m_idle) {
+        this->m_idle = true;
+        this->m_idleSinceUs = this->getTimeUs();
+#if TASK_RUNNER_TRACING
+        this->m_trace.record(static_cast<U32>(this->m_idleSinceUs), TRACE_IDLE_BEGIN, 0, 0);
+#endif
+    }
+}
+
+void TaskRunner::leaveIdle() {
+    const U64 nowUs = this->getTimeUs();
+    this->m_idleUs += nowUs - this->m_idleSinceUs;
+    this->m_idle = false;
+#if TASK_RUNNER_TRACING
+    this->m_trace.record(static_cast<U32>(nowUs), TRACE_IDLE_END, 0, 0);
+#else
+    (void)nowUs;
+#endif
 }
 
 void TaskRunner::run() {
     // While cycling run a task and increment to the next
     if (this->m_cycling) {
-        // Start at the next task
-        for (FwSizeType i = 0; i < Os::Baremetal::TASK_CAPACITY; i++) {
-            // Run only one task.
-            if (runNext()) {
-                break;
-            }
+        this->startCpuTime();
+        this->collectIsrWakeups();
+        this->expireDelays();
+        if (this->runNext(false)) {
+            return;
+        }
+        // Every task ran in this pass, start the next one
+        ReadyLists* finished = this->m_current;
+        this->m_current = this->m_next;
+        this->m_next = finished;
+        if (this->runNext(false)) {
+            return;
+        }
+        // Nothing is ready. Calls of run made until a task runs again are idle time, whether or not they sleep
+        this->enterIdle();
+        if (this->m_idleHook != nullptr) {
+            this->m_idleHook(this->m_idleContext);
         }
     }
 }
 
 void TaskRunner::runAll() {
     if (this->m_cycling) {
-        this->m_index = 0;
-        for (FwSizeType i = 0; i < Os::Baremetal::TASK_CAPACITY; i++) {
-            // Run each task exactly once.
-            (void)runNext();
-            if (this->m_index == 0) {
+        this->startCpuTime();
+        // Run each task exactly once, whether or not it already ran in the current pass
+        this->collectIsrWakeups();
+        this->expireDelays();
+        this->mergePasses();
+        // Tasks ordered by deadline come back to the heap once run, so run as many as are ready now
+        for (FwSizeType jobs = this->m_deadlines.getCount(); this->m_cycling and (jobs > 0); jobs--) {
+            TaskRunnerNode* const node = this->m_deadlines.getEarliest();
+            if (node == nullptr) {
                 break;
             }
+            this->unlink(*node);
+            (void)this->runNode(*node, *this->m_next);
+        }
+        while (this->m_cycling and this->runNext(true)) {
+        }
+    }
+}
+
+void TaskRunner::link(ReadyLists& lists, TaskRunnerNode& node) {
+    FW_ASSERT(node.level < TASK_RUNNER_PRIORITY_LEVELS, static_cast<FwAssertArgType>(node.level));
+    TaskRunnerNode::append(lists.heads[node.level], node);
+    setLevel(lists, node.level);
+}
+
+void TaskRunner::unlink(TaskRunnerNode& node) {
+    if (node.heapIndex != DeadlineHeap::NOT_QUEUED) {
+        this->m_deadlines.remove(node);
+        return;
+    }
+    if ((node.next == nullptr) or node.delayed) {
+        return;
+    }
+    // The node can only be the head of one of the two lists of its level. When it is the head of neither, its list
+    // keeps other nodes and either head can be passed
+    ReadyLists& lists = (this->m_lists[1].heads[node.level] == &node) ? this->m_lists[1] : this->m_lists[0];
+    TaskRunnerNode::remove(lists.heads[node.level], node);
+    if (lists.heads[node.level] == nullptr) {
+        clearLevel(lists, node.level);
+    }
+}
+
+void TaskRunner::mergePasses() {
+    // Only the levels with a list in the next pass are visited
+    while (this->m_next->groups != 0) {
+        const FwSizeType level = getHighestLevel(*this->m_next);
+        clearLevel(*this->m_next, level);
+        setLevel(*this->m_current, level);
+        TaskRunnerNode* const appended = this->m_next->heads[level];
+        TaskRunnerNode*& head = this->m_current->heads[level];
+        if (head == nullptr) {
+            head = appended;
+        } else {
+            // Join the two circular lists: current tail -> appended head ... appended tail -> current head
+            TaskRunnerNode* const tail = head->previous;
+            TaskRunnerNode* const appendedTail = appended->previous;
+            tail->next = appended;
+            appended->previous = tail;
+            appendedTail->next = head;
+            head->previous = appendedTail;
         }
+        this->m_next->heads[level] = nullptr;
+    }
+}
+
+void TaskWaker::bindCurrent(U32 pending) {
+    if (this->m_task != nullptr) {
+        return;
     }
+    TaskRunner& runner = TaskRunner::getSingleton();
+    // Only written once bound, so notifications from other contexts never see it change back and forth
+    Task* task = runner.getCurrentTask();
+    if (task != nullptr) {
+        this->m_task = task;
+        runner.setWaitForWake(task, true, pending);
+    }
+}
+
+void TaskWaker::notify() {
+    if (this->m_task != nullptr) {
+        TaskRunner::getSingleton().wake(this->m_task);
+    }
+}
+
+#if TASK_RUNNER_ISR_WAKEUPS
+void TaskWaker::notifyFromIsr() {
+    if (this->m_task != nullptr) {
+        TaskRunner::getSingleton().wakeFromIsr(this->m_task);
+    }
+}
+#endif
+
+Task* TaskWaker::getTask() const {
+    return this->m_task;
 }
 }  // End namespace Baremetal
 }  // End Namespace Os
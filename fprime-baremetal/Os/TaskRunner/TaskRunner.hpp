@@ -4,12 +4,93 @@
 // ======================================================================
 #ifndef FPRIME_BAREMETAL_TASKRUNNER_TASKRUNNER_HPP_
 #define FPRIME_BAREMETAL_TASKRUNNER_TASKRUNNER_HPP_
+#include <Os/File.hpp>
+#include <Os/RawTime.hpp>
 #include <Os/Task.hpp>
+#include <fprime-baremetal/Os/TaskRunner/DeadlineHeap.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TimerWheel.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TraceBuffer.hpp>
+#include <atomic>
+#include "config/TaskRunnerCfg.hpp"
 
 namespace Os {
 namespace Baremetal {
 
-constexpr FwSizeType TASK_CAPACITY = 100;  // TODO: configurize this
+//! Interrupt handlers may wake tasks only where atomic compare-and-swap is lock-free, which cores without exclusive
+//! access instructions (such as Cortex-M0) do not have
+#define TASK_RUNNER_ISR_WAKEUPS ((ATOMIC_INT_LOCK_FREE == 2) && (ATOMIC_POINTER_LOCK_FREE == 2))
+
+constexpr FwSizeType TASK_CAPACITY = TASK_RUNNER_CAPACITY;  //!< maximum number of registered tasks
+
+static_assert((TASK_RUNNER_PRIORITY_LEVELS > 0) and (TASK_RUNNER_PRIORITY_LEVELS <= 1024),
+              "Ready levels must fit in a two-level bitmap of 32 words of 32 bits");
+
+constexpr FwSizeType TASK_LEVEL_GROUPS = (TASK_RUNNER_PRIORITY_LEVELS + 31) / 32;  //!< 32 bit words of ready levels
+
+class TaskRunner;
+
+#if TASK_RUNNER_PROFILING
+//! \brief execution statistics of a task, measured around each of its units of work
+//!
+//! The window fields count the same as the others, since the window was last restarted by `visitProfiles`.
+struct TaskProfile {
+    U32 runs = 0;            //!< units of work run
+    U64 totalUs = 0;         //!< time spent in units of work
+    U32 maxUs = 0;           //!< longest unit of work
+    U32 budgetUs = 0;        //!< time allowed for one unit of work, 0 for no limit
+    U32 overruns = 0;        //!< units of work longer than the budget
+    U32 windowRuns = 0;      //!< units of work run in the window
+    U64 windowUs = 0;        //!< time spent in units of work in the window
+    U32 windowMaxUs = 0;     //!< longest unit of work in the window
+    U32 windowOverruns = 0;  //!< units of work longer than the budget in the window
+    //! units of work lasting 2^(n-1) to 2^n - 1 microseconds counted in bucket n, and shorter ones in bucket 0
+    U32 histogram[TASK_RUNNER_PROFILE_BUCKETS] = {};
+};
+#endif
+
+//! \brief scheduling links kept in each baremetal task handle by the runner of the task
+struct TaskRunnerNode {
+    Task* task = nullptr;                      //!< task owning the handle, nullptr when not registered
+    TaskRunner* runner = nullptr;              //!< runner the task is registered with
+    TaskRunnerNode* next = nullptr;            //!< next node of the ready list, nullptr when not in a list
+    TaskRunnerNode* previous = nullptr;        //!< previous node of the ready list
+    U32 wakeups = 0;                           //!< units of work signaled and not yet run, when waiting for wakeups
+    U32 deadline = 0;                          //!< tick at which a delay ends
+    U64 deadlineAtUs = 0;                      //!< time by which the task should run, under earliest deadline first
+    U64 windowStartUs = 0;                     //!< start of the current budget period
+    U32 periodUs = 0;                          //!< period of the task, 0 when it declared no timing
+    U32 deadlineUs = 0;                        //!< deadline of the task relative to the time it becomes ready
+    U32 budgetUs = 0;                          //!< processor time the task may use per period, 0 for no limit
+    U32 usedUs = 0;                            //!< processor time used in the current period
+    U32 drainUs = 0;                           //!< time after which a slice stops draining, 0 for no limit
+    U16 drainUnits = 1;                        //!< units of work a slice may drain while wakeups are pending
+    U16 timerSlot = 0;                         //!< timer wheel slot holding the node while delayed
+    U16 heapIndex = DeadlineHeap::NOT_QUEUED;  //!< position in the deadline heap
+    U16 level = 0;                             //!< ready level given by the task priority
+    bool parked = false;                       //!< taken out of the ready lists until resumed or woken
+    bool waitsForWake = false;                 //!< run only when woken, instead of on every pass
+    bool delayed = false;                      //!< waiting in the timer wheel, linked there instead of a ready list
+    bool throttled = false;                    //!< delayed by the runner until its next period, not by the task
+    std::atomic<U32> isrWakeups{0};            //!< wakeups signaled from interrupts, not yet counted in wakeups
+    std::atomic<bool> isrQueued{false};        //!< in the list of nodes woken from interrupts
+    TaskRunnerNode* isrNext = nullptr;         //!< next node woken from interrupts
+    bool drainAdaptive = false;                //!< drain half of the pending wakeups per slice, up to drainUnits
+#if TASK_RUNNER_PROFILING || TASK_RUNNER_TRACING
+    TaskRunnerNode* registered = nullptr;      //!< next node registered with the same runner
+#endif
+#if TASK_RUNNER_PROFILING
+    TaskProfile profile;                       //!< execution statistics of the task
+#endif
+#if TASK_RUNNER_TRACING
+    U16 traceId = 0;                           //!< id of the task in trace events
+#endif
+
+    //! \brief append a node to a circular list
+    static void append(TaskRunnerNode*& head, TaskRunnerNode& node);
+
+    //! \brief take a node out of the circular list it is in, moving the head if it is that node
+    static void remove(TaskRunnerNode*& head, TaskRunnerNode& node);
+};
 
 //! \brief a synthetic task runner that will invoke cooperative tasks
 //!
@@ -22,8 +103,102 @@ constexpr FwSizeType TASK_CAPACITY = 100;  // TODO: configurize this
 //! cooperative tasks in priority order. This means that priority tasks with multiple units of work will wait for lower
 //! priority tasks initial unit of works to run.
 //!
+//! Tasks waiting to run in the current pass are kept in one intrusive list per priority level, and a two-level bitmap
+//! records which levels are not empty, so the next task is found with two count-leading-zeros in constant time however
+//! many tasks are registered. A task that ran moves to a second set of lists for the next pass, and the two sets swap
+//! when the current pass is done. Priorities are spread evenly over `TASK_RUNNER_PRIORITY_LEVELS` levels, one per
+//! priority by default, and tasks of the same level run in the order they were added.
+//!
+//! Suspended tasks are taken out of the lists the next time they come up and put back by `resume`.
+//!
+//! By default every task runs once per pass, whether or not it has work. A task can instead be set to wait for
+//! wakeups with `setWaitForWake`. It then only runs when `wake` was called, once per call, and stays out of the
+//! lists otherwise. Event sources such as queues wake their consumer through a `TaskWaker`. When no task is ready at
+//! all, `run` calls the idle hook, which can put the processor to sleep until the next interrupt.
+//!
+//! Three scheduling policies are available through `setPolicy`, to be chosen before tasks are added:
+//! - `PASSES` (default) walks passes as described above, so every ready task runs once before any runs twice.
+//! - `STRICT_PRIORITY` always runs the highest priority ready task, in turn with the other ready tasks of the same
+//!   level. Giving higher priorities to tasks of shorter periods makes it rate monotonic.
+//! - `EARLIEST_DEADLINE` always runs the ready task with the earliest deadline among tasks that declared their timing
+//!   with `setTiming`. A task that becomes ready must run within its relative deadline. Tasks without timing run in
+//!   passes when no task with a deadline is ready. A task with timing that waits for wakeups is released by each
+//!   wakeup. One that does not is released once per period: after a unit of work it is held back, like a delayed
+//!   task, until its next period starts, so it cannot keep the earliest deadline and starve the other tasks.
+//!
+//! Under every policy, a task given a budget with `setTiming` may use that much processor time per period. A task that
+//! used up its budget is held back, like a delayed task, until its period ends. Units of work are not preempted, so a
+//! budget can be exceeded by at most one unit of work.
+//!
+//! A task waiting for wakeups can be set with `setDrain` to run several units of work in one slice while wakeups are
+//! pending, for example to empty a burst of queued messages without going through the scheduler for each of them. The
+//! slice ends after a number of units of work, after a time limit, or when no wakeup is left, whichever comes first.
+//! In adaptive mode the slice drains half of the pending wakeups, so a deep queue catches up in a few large slices
+//! while a shallow one keeps interleaving with the other tasks.
+//!
+//! `Os::Task::delay` called from a unit of work parks the task in a timer wheel until the delay has passed, instead of
+//! blocking. Its next unit of work runs no earlier than the end of the delay. Time is read from `Os::RawTime`, or from
+//! the clock given to `setClock`, and counted in ticks of `TASK_RUNNER_TICK_US` microseconds. An idle hook that sleeps
+//! while `hasDelayedTask` is true must be woken at least once per tick, for example by a tick interrupt.
+//!
+//! A work hook given to `setWorkHook` is called after every unit of work, before the clock is read at its end. A
+//! simulation with a virtual clock advances the clock there by the modelled cost of the unit of work, so profiling,
+//! tracing and budgets see simulated processor time (see `Os_Baremetal_Simulation`).
+//!
+//! The runner also accounts for the time it spends idle, from the moment `run` finds no ready task, idle hook
+//! included, until a task runs again. Everything else counts as used processor time.
+//!
+//! When `TASK_RUNNER_PROFILING` is set, each unit of work is timed with the same clock, costing two clock reads per
+//! unit of work, and the durations are kept per task in a `TaskProfile`.
+//!
+//! When `TASK_RUNNER_TRACING` is set, the runner records the start and end of every slice, task exits, idle periods
+//! and user markers from `mark` in a `TraceBuffer`, with the low 32 bits of the same clock as timestamps. `dumpTrace`
+//! writes the buffer out, oldest event first, with the names of the registered tasks, to a file or any other sink.
+//! The `baremetal-trace` host tool turns a dump into Chrome trace JSON:
+//!
+//! | Bytes | Content |
+//! |---|---|
+//! | 16 | header: "FTRC", version U8 (1), reserved U8, task names U16, events U32, overwritten events U32 |
+//! | 3 + n | per task name: trace id U16, name length n U8, name |
+//! | 8 | per event: time in microseconds U32, task trace id or marker id U16, TraceEvent U8, data U8 |
+//!
+//! All fields are little-endian.
+//!
 class TaskRunner : TaskRegistry {
   public:
+    //! \brief function called by `run` when no task is ready
+    typedef void (*IdleHook)(void* context);
+
+    //! \brief function returning a monotonic time in microseconds
+    typedef U64 (*Clock)(void* context);
+
+    //! \brief function called by the runner after each unit of work of a task
+    typedef void (*WorkHook)(void* context, Task& task);
+
+    //! \brief function called for a delay requested outside of the units of work of the runner
+    //!
+    //! \return true if the delay was handled, false to wait in place
+    typedef bool (*DelayHook)(void* context, U64 delayUs);
+
+    //! \brief order in which ready tasks run
+    enum class Policy : U8 {
+        PASSES,             //!< every ready task once per pass, in priority order
+        STRICT_PRIORITY,    //!< highest priority ready task first
+        EARLIEST_DEADLINE,  //!< ready task with the earliest deadline first, then the others in passes
+    };
+
+#if TASK_RUNNER_PROFILING
+    //! \brief function called by `visitProfiles` for each registered task
+    typedef void (*ProfileVisitor)(void* context, Task& task, const TaskProfile& profile);
+#endif
+
+#if TASK_RUNNER_TRACING
+    //! \brief function receiving the bytes of a trace dump, in order
+    //!
+    //! \return false to abandon the dump
+    typedef bool (*TraceWriter)(void* context, const U8* data, FwSizeType size);
+#endif
+
     //!< Nothing constructor
     TaskRunner();
     //!< Nothing destructor
@@ -31,8 +206,8 @@ class TaskRunner : TaskRegistry {
 
     //! \brief add a task to this runner
     //!
-    //! This will add a task to the set of tasks that will be run by this task runner. This call will perform the
-    //! initial sort of the tasks into priority order.
+    //! This will add a task to the set of tasks that will be run by this task runner. The task first runs in the
+    //! current pass.
     //!
     //! It is invalid to pass an nullptr to this function.
     //!
@@ -48,6 +223,184 @@ class TaskRunner : TaskRegistry {
     //! \param task: pointer task to remove to this runner
     void removeTask(Task* task);
 
+    //! \brief put a resumed task back in the ready lists
+    //!
+    //! Called by the baremetal task when it is resumed. The task runs in the current pass.
+    //!
+    //! \param task: pointer to the resumed task
+    void resumeTask(Task* task);
+
+    //! \brief choose the scheduling policy
+    //!
+    //! Only allowed while no task is added.
+    void setPolicy(Policy policy);
+
+    //! \brief declare the timing of a task
+    //!
+    //! \param task: pointer to a task added to this runner
+    //! \param periodUs: period of the task in microseconds, 0 to clear its timing
+    //! \param deadlineUs: time within which the task should run once ready, 0 for the period
+    //! \param budgetUs: processor time the task may use per period, 0 for no limit
+    void setTiming(Task* task, U32 periodUs, U32 deadlineUs = 0, U32 budgetUs = 0);
+
+    //! \brief set how many units of work a task waiting for wakeups may run in one slice
+    //!
+    //! Draining only applies while the task waits for wakeups, which count its pending units of work. Profiling and
+    //! budgets measure the whole slice.
+    //!
+    //! \param task: pointer to a task added to this runner
+    //! \param maxUnits: units of work per slice, at least 1. 1 runs one unit of work per slice as usual
+    //! \param sliceUs: time after which the slice stops draining, 0 for no limit
+    //! \param adaptive: drain half of the pending wakeups per slice, rounded up and capped by maxUnits, instead of up
+    //! to maxUnits
+    void setDrain(Task* task, U16 maxUnits, U32 sliceUs = 0, bool adaptive = false);
+
+    //! \brief choose whether a task runs on every pass or only when woken
+    //!
+    //! \param task: pointer to a task added to this runner
+    //! \param waitForWake: true to run the task only when woken
+    //! \param wakeups: units of work already pending for the task
+    void setWaitForWake(Task* task, bool waitForWake, U32 wakeups = 0);
+
+    //! \brief signal one unit of work to a task waiting for wakeups
+    //!
+    //! The task becomes ready and runs once more for each call. Has no effect on tasks that run on every pass, other
+    //! than to keep count.
+    //!
+    //! \param task: pointer to a task added to this runner
+    void wake(Task* task);
+
+#if TASK_RUNNER_ISR_WAKEUPS
+    //! \brief signal one unit of work to a task waiting for wakeups, from an interrupt
+    //!
+    //! Same as `wake`, but safe to call from an interrupt handler preempting the runner or another interrupt: the
+    //! wakeup is counted atomically and the node pushed on a lock-free list, which the runner takes over on its next
+    //! `run` or `runAll`. Only available where `TASK_RUNNER_ISR_WAKEUPS` is set.
+    //!
+    //! \param task: pointer to a task added to this runner
+    void wakeFromIsr(Task* task);
+#endif
+
+    //! \brief get the task whose unit of work is running, or nullptr outside of a task
+    Task* getCurrentTask() const;
+
+    //! \brief check whether any task is ready to run
+    //!
+    //! Idle hooks that sleep should check this with interrupts masked right before sleeping, so a wakeup from an
+    //! interrupt that came after `run` gave up is not missed until the next interrupt.
+    bool hasReadyTask() const;
+
+    //! \brief delay the task whose unit of work is running
+    //!
+    //! The task is not run again until the delay has passed. Called by the baremetal `Os::Task::delay`. Outside of a
+    //! unit of work of this runner, the delay goes to the delay hook, if any. Asserts when the clock cannot be read, as
+    //! the task would never be woken.
+    //!
+    //! \param delayUs: delay in microseconds, rounded up to whole ticks
+    //! \return true if a task was delayed or the delay hook handled the delay, false to wait in place
+    bool delayCurrentTask(U64 delayUs);
+
+    //! \brief check whether any task is waiting for its delay to end
+    bool hasDelayedTask() const;
+
+    //! \brief get the time at which the earliest delay ends
+    //!
+    //! Walks the delayed tasks, for simulations skipping idle time to the next event.
+    //!
+    //! \param endUs: (output) end of the earliest delay in microseconds, rounded up to whole ticks
+    //! \return false, leaving endUs untouched, if no task is delayed
+    bool getDelayEndUs(U64& endUs);
+
+    //! \brief get the time of the clock used for delays, in microseconds
+    U64 getTimeUs();
+
+    //! \brief check that the clock used for delays can be read
+    //!
+    //! A clock given to `setClock` always can. The default one reads `Os::RawTime`, which may fail, for example until
+    //! the baremetal implementation is given a counter. Time then stands still at 0.
+    bool hasClock();
+
+    //! \brief replace the clock used for delays, for example by a virtual clock in tests
+    //!
+    //! The processor time accounting restarts with the new clock.
+    //!
+    //! \param clock: function returning the time in microseconds, or nullptr to use `Os::RawTime`
+    //! \param context: argument passed to the clock
+    void setClock(Clock clock, void* context = nullptr);
+
+    //! \brief get the processor time used by tasks and the time elapsed since the runner was first run
+    //!
+    //! Both are running totals, so the load over an interval is the difference of two samples.
+    //!
+    //! \param usedUs: filled with the time spent outside of the idle path, in microseconds
+    //! \param totalUs: filled with the time elapsed since the first call of `run` or `runAll`, in microseconds
+    void getCpuTime(U64& usedUs, U64& totalUs);
+
+#if TASK_RUNNER_PROFILING
+    //! \brief set the time a unit of work of a task may take before it counts as an overrun
+    //!
+    //! \param task: pointer to a task added to this runner
+    //! \param budgetUs: time allowed in microseconds, 0 for no limit
+    void setBudget(Task* task, U32 budgetUs);
+
+    //! \brief copy the execution statistics of a task
+    //!
+    //! \param task: pointer to a task
+    //! \param profile: filled with the statistics of the task
+    //! \return false, leaving the profile untouched, if the task is not added to this runner
+    bool getProfile(Task* task, TaskProfile& profile);
+
+    //! \brief pass the execution statistics of every registered task to a visitor
+    //!
+    //! \param visitor: function called once per task
+    //! \param context: argument passed to the visitor
+    //! \param restartWindow: clear the window fields of each profile once visited
+    void visitProfiles(ProfileVisitor visitor, void* context, bool restartWindow);
+#endif
+
+#if TASK_RUNNER_TRACING
+    //! \brief record a user marker in the trace, for example around a section whose latency matters
+    //!
+    //! \param marker: id of the marker
+    //! \param data: value recorded with the marker
+    void mark(U16 marker, U8 data = 0);
+
+    //! \brief write the trace out, oldest event first, in the format described above
+    //!
+    //! \param writer: function receiving the dump in pieces
+    //! \param context: argument passed to the writer
+    //! \return false if the writer failed
+    bool dumpTrace(TraceWriter writer, void* context);
+
+    //! \brief write the trace to a file, such as a MicroFs file, replacing it
+    //!
+    //! \param path: path of the file
+    //! \return status of the first file operation that failed, or OP_OK
+    Os::File::Status dumpTraceToFile(const char* path);
+
+    //! \brief drop every event of the trace
+    void clearTrace();
+#endif
+
+    //! \brief set the function called by `run` when no task is ready, for example to wait for an interrupt
+    //!
+    //! \param hook: function to call, or nullptr for none
+    //! \param context: argument passed to the hook
+    void setIdleHook(IdleHook hook, void* context = nullptr);
+
+    //! \brief set the function called after each unit of work, for example to advance a virtual clock
+    //!
+    //! \param hook: function to call, or nullptr for none
+    //! \param context: argument passed to the hook
+    void setWorkHook(WorkHook hook, void* context = nullptr);
+
+    //! \brief set the function handling delays requested outside of the units of work of this runner, for example by
+    //! tasks run by the workers of a `MultiTaskRunner`
+    //!
+    //! \param hook: function to call, or nullptr to wait in place
+    //! \param context: argument passed to the hook
+    void setDelayHook(DelayHook hook, void* context = nullptr);
+
     //! \brief stop this task runner
     //!
     //! Stop this task runner. No addition tasks work will be run.
@@ -55,8 +408,9 @@ class TaskRunner : TaskRegistry {
 
     //! \brief run a single unit of work
     //!
-    //! This will run a single unit of work of a single task. The task runner will walk the task list and choose the
-    //! next task in the list to run.
+    //! This will run a single unit of work of a single task. The task runner picks the highest priority task that has
+    //! not yet run in the current pass, starting a new pass when every task has run. If no task is ready, the idle hook
+    //! is called instead.
     //!
     //! This method should be called within the run-loop of the system:
     //!
@@ -74,12 +428,172 @@ class TaskRunner : TaskRegistry {
     static TaskRunner& getSingleton();
 
   private:
+    //! \brief set of ready lists, one per priority level
+    struct ReadyLists {
+        U32 groups;                                          //!< bit g set when word g of levels is not 0
+        U32 levels[TASK_LEVEL_GROUPS];                       //!< bit n of word g set when level 32g + n is not empty
+        TaskRunnerNode* heads[TASK_RUNNER_PRIORITY_LEVELS];  //!< circular list of each level
+    };
+
     //! \brief helper to run a single unit of work, from this task
     static void runOne(Task& task);
-    bool runNext();
-    Task* m_task_table[TASK_CAPACITY];  //!< Task table of registered tasks
-    FwSizeType m_index = 0;             //!< Index of current task
-    bool m_cycling = true;              //!< Is the task runner cycling
+
+    //! \brief get the scheduling links of a task
+    static TaskRunnerNode& getNode(Task& task);
+
+    //! \brief get the ready level of a priority
+    static FwSizeType getLevel(FwTaskPriorityType priority);
+
+    //! \brief get the highest level of a set of ready lists whose list is not empty, which there must be
+    static FwSizeType getHighestLevel(const ReadyLists& lists);
+
+    //! \brief mark the list of a level of a set of ready lists as not empty
+    static void setLevel(ReadyLists& lists, FwSizeType level);
+
+    //! \brief mark the list of a level of a set of ready lists as empty
+    static void clearLevel(ReadyLists& lists, FwSizeType level);
+
+    //! \brief put a parked node back in the current pass if it is enabled and, when it waits for wakeups, woken
+    void makeReady(TaskRunnerNode& node);
+
+    //! \brief check whether a node may run: enabled and, when it waits for wakeups, woken
+    static bool isReady(const TaskRunnerNode& node);
+
+    //! \brief count the wakeups signaled from interrupts and make the woken tasks ready
+    void collectIsrWakeups();
+
+    //! \brief make tasks whose delay ended ready
+    void expireDelays();
+
+    //! \brief timer wheel handler putting a task whose delay ended back in the ready lists
+    static void onDelayExpired(void* runner, TaskRunnerNode& node);
+
+    //! \brief start counting processor time on the first run
+    void startCpuTime();
+
+    //! \brief start the idle time when the runner first finds nothing to run
+    void enterIdle();
+
+    //! \brief add the idle time that ended to the idle total
+    void leaveIdle();
+
+    //! \brief run the next task according to the policy
+    //!
+    //! \param allTasks: run for `runAll`, taking only tasks of the current pass and keeping them out of it afterwards
+    //! \return true if a task ran, false if the current pass has no tasks left
+    bool runNext(bool allTasks);
+
+    //! \brief run one slice of a node taken from the ready set, unless it is no longer ready
+    //!
+    //! A slice is one unit of work, or several when the task drains its wakeups.
+    //!
+    //! \param node: node already taken out of the ready set
+    //! \param ranLists: lists receiving the node if it is still ready afterwards
+    //! \return true if the slice ran
+    bool runNode(TaskRunnerNode& node, ReadyLists& ranLists);
+
+    //! \brief get the number of units of work a slice of a node may drain, from its wakeups before the slice
+    static U32 getDrainLimit(const TaskRunnerNode& node);
+
+    //! \brief check whether a slice that ran some units of work goes on with another one
+    static bool keepDraining(const TaskRunnerNode& node, U32 units, U32 limit, U64 elapsedUs);
+
+    //! \brief add the processor time of a unit of work to the budget of its task, holding it back when used up
+    void chargeBudget(TaskRunnerNode& node, U64 startUs, U64 endUs);
+
+    //! \brief move the current period of a node with timing to the one holding a time, keeping the phase of periods
+    static void startPeriod(TaskRunnerNode& node, U64 nowUs);
+
+    //! \brief hold a node back in the timer wheel until a time, unless it is already held back longer
+    //!
+    //! \param node: node to hold back
+    //! \param nowUs: current time
+    //! \param untilUs: time at which the node is ready again
+    //! \param throttle: held back by the runner for its period, so the end is not a wakeup of a task waiting for them
+    void delayNode(TaskRunnerNode& node, U64 nowUs, U64 untilUs, bool throttle = false);
+
+    //! \brief add a ready node to the deadline heap or to its level of a set of ready lists, as the policy requires
+    void schedule(ReadyLists& lists, TaskRunnerNode& node);
+
+    //! \brief append a node to its level of a set of ready lists
+    static void link(ReadyLists& lists, TaskRunnerNode& node);
+
+    //! \brief default clock, reading `Os::RawTime`
+    static U64 getRawTimeUs(void* runner);
+
+#if TASK_RUNNER_PROFILING
+    //! \brief add the duration of a unit of work to the statistics of its task
+    static void recordSlice(TaskProfile& profile, U64 durationUs);
+#endif
+
+    //! \brief remove a task that exited, recording the exit in the trace
+    void removeExited(Task& task);
+
+    //! \brief take a node out of whichever ready list or heap holds it
+    void unlink(TaskRunnerNode& node);
+
+    //! \brief append every list of the next pass to the current pass
+    void mergePasses();
+
+    ReadyLists m_lists[2];                             //!< ready lists of the current and next pass
+    ReadyLists* m_current;                             //!< tasks still to run in this pass
+    ReadyLists* m_next;                                //!< tasks that ran in this pass
+    FwSizeType m_count = 0;                            //!< number of registered tasks
+    Task* m_currentTask = nullptr;                     //!< task whose unit of work is running
+    IdleHook m_idleHook = nullptr;                     //!< called when no task is ready
+    void* m_idleContext = nullptr;                     //!< argument of the idle hook
+    WorkHook m_workHook = nullptr;                     //!< called after each unit of work
+    void* m_workContext = nullptr;                     //!< argument of the work hook
+    DelayHook m_delayHook = nullptr;                   //!< called for delays outside of units of work
+    void* m_delayContext = nullptr;                    //!< argument of the delay hook
+    TimerWheel m_timers;                               //!< delayed tasks
+    DeadlineHeap m_deadlines;                          //!< ready tasks with a deadline, under earliest deadline first
+    std::atomic<TaskRunnerNode*> m_isrWoken{nullptr};  //!< nodes woken from interrupts, last woken first
+    Policy m_policy = Policy::PASSES;                  //!< order in which ready tasks run
+    Clock m_clock;                                     //!< time source of delays
+    void* m_clockContext;                              //!< argument of the clock
+    Os::RawTime m_epoch;                               //!< start of the default clock
+    bool m_epochSet = false;                           //!< m_epoch was read
+    U64 m_loadStartUs = 0;                             //!< time of the first run
+    U64 m_idleUs = 0;                                  //!< idle time that ended
+    U64 m_idleSinceUs = 0;                             //!< start of the current idle time
+    bool m_loadStarted = false;                        //!< m_loadStartUs was read
+    bool m_idle = false;                               //!< no task ran since the runner found nothing to run
+#if TASK_RUNNER_PROFILING || TASK_RUNNER_TRACING
+    TaskRunnerNode* m_registered = nullptr;            //!< list of all registered nodes
+#endif
+#if TASK_RUNNER_TRACING
+    TraceBuffer m_trace;                               //!< latest scheduling events
+    U16 m_traceIds = 0;                                //!< last trace id given to a task
+#endif
+    bool m_cycling = true;                             //!< Is the task runner cycling
+};
+
+//! \brief wakes the task consuming from an event source, such as a queue
+//!
+//! The consumer binds itself by calling `bindCurrent` from its unit of work, typically on its first receive. This
+//! switches it to waiting for wakeups, and every later `notify` (one per unit of work, for example per message sent)
+//! makes it ready again. Notifying before any task is bound does nothing.
+class TaskWaker {
+  public:
+    //! \brief bind the task whose unit of work is running, if not bound yet
+    //!
+    //! \param pending: units of work waiting in the source, counting the one taken by the running unit of work
+    void bindCurrent(U32 pending);
+
+    //! \brief signal one unit of work to the bound task
+    void notify();
+
+#if TASK_RUNNER_ISR_WAKEUPS
+    //! \brief signal one unit of work to the bound task, from an interrupt
+    void notifyFromIsr();
+#endif
+
+    //! \brief get the bound task, or nullptr
+    Task* getTask() const;
+
+  private:
+    Task* m_task = nullptr;  //!< bound task
 };
 }  // End namespace Baremetal
 }  // End Namespace Os
@@ -0,0 +1,195 @@
+// ======================================================================
+// \title fprime-baremetal/Os/TaskRunner/TimerWheel.cpp
+// \brief TimerWheel implementations
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TimerWheel.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+// out-of-line definitions for constants that are odr-used (required before C++17)
+constexpr FwSizeType TimerWheel::SLOTS;
+
+static_assert(TASK_RUNNER_TIMER_LEVELS > 0, "Timer wheel needs a level");
+static_assert((TASK_RUNNER_TIMER_SLOT_BITS > 0) and ((TASK_RUNNER_TIMER_LEVELS * TASK_RUNNER_TIMER_SLOT_BITS) < 32),
+              "Timer wheel range must fit in a signed 32 bit tick difference");
+static_assert(TASK_RUNNER_TIMER_SLOT_BITS <= 5, "Slots of a timer wheel level must fit in a 32 bit bitmap");
+
+//! \brief number of ticks covered by one slot of a level
+static U32 getSlotSpan(FwSizeType level) {
+    return static_cast<U32>(1) << (level * TASK_RUNNER_TIMER_SLOT_BITS);
+}
+
+//! \brief index of the lowest bit set
+static FwSizeType lowestBit(U32 bits) {
+    FW_ASSERT(bits != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<FwSizeType>(__builtin_ctz(bits));
+#else
+    FwSizeType bit = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+TimerWheel::TimerWheel() : m_tick(0), m_count(0) {
+    for (FwSizeType slot = 0; slot < (TASK_RUNNER_TIMER_LEVELS * SLOTS); slot++) {
+        this->m_slots[slot] = nullptr;
+    }
+    for (FwSizeType level = 0; level < TASK_RUNNER_TIMER_LEVELS; level++) {
+        this->m_occupied[level] = 0;
+    }
+}
+
+U32 TimerWheel::getTick() const {
+    return this->m_tick;
+}
+
+bool TimerWheel::isEmpty() const {
+    return this->m_count == 0;
+}
+
+bool TimerWheel::getEarliestDeadline(U32& deadline) const {
+    bool found = false;
+    for (FwSizeType slot = 0; slot < (TASK_RUNNER_TIMER_LEVELS * SLOTS); slot++) {
+        const TaskRunnerNode* const head = this->m_slots[slot];
+        const TaskRunnerNode* node = head;
+        while (node != nullptr) {
+            if ((not found) or (static_cast<I32>(node->deadline - deadline) < 0)) {
+                deadline = node->deadline;
+                found = true;
+            }
+            node = (node->next == head) ? nullptr : node->next;
+        }
+    }
+    return found;
+}
+
+void TimerWheel::jump(U32 tick) {
+    FW_ASSERT(this->m_count == 0, static_cast<FwAssertArgType>(this->m_count));
+    this->m_tick = tick;
+}
+
+bool TimerWheel::insert(TaskRunnerNode& node, U32 deadline) {
+    FW_ASSERT(not node.delayed);
+    FW_ASSERT(node.next == nullptr);
+    // Tick differences are signed so deadlines stay ordered across the wrap of the tick counter
+    if (static_cast<I32>(deadline - this->m_tick) <= 0) {
+        return false;
+    }
+    node.deadline = deadline;
+    node.delayed = true;
+    this->place(node);
+    this->m_count++;
+    return true;
+}
+
+void TimerWheel::cancel(TaskRunnerNode& node) {
+    FW_ASSERT(node.delayed);
+    TaskRunnerNode::remove(this->m_slots[node.timerSlot], node);
+    this->markEmpty(node.timerSlot);
+    node.delayed = false;
+    this->m_count--;
+}
+
+void TimerWheel::advance(U32 tick, ExpiryHandler handler, void* context) {
+    FW_ASSERT(handler != nullptr);
+    // A clock that went back leaves the wheel where it is
+    if (static_cast<I32>(tick - this->m_tick) <= 0) {
+        return;
+    }
+    // Only the ticks at which a slot holding nodes is drained are visited. Nothing happens at the others
+    while (this->m_count > 0) {
+        const U32 next = this->getNextDrainTick();
+        if (static_cast<I32>(next - tick) > 0) {
+            break;
+        }
+        this->m_tick = next;
+        // When a level completes a turn, the next slot of the level above is spread over the levels below
+        for (FwSizeType level = 1; level < TASK_RUNNER_TIMER_LEVELS; level++) {
+            if ((this->m_tick & (getSlotSpan(level) - 1)) != 0) {
+                break;
+            }
+            const FwSizeType index = (this->m_tick >> (level * TASK_RUNNER_TIMER_SLOT_BITS)) & (SLOTS - 1);
+            this->drain((level * SLOTS) + index, handler, context);
+        }
+        this->drain(this->m_tick & (SLOTS - 1), handler, context);
+    }
+    // Nothing is left to walk through
+    this->m_tick = tick;
+}
+
+void TimerWheel::place(TaskRunnerNode& node) {
+    const U32 delta = node.deadline - this->m_tick;
+    FwSizeType level = 0;
+    while ((level < (TASK_RUNNER_TIMER_LEVELS - 1)) and (delta >= getSlotSpan(level + 1))) {
+        level++;
+    }
+    // Deadlines past the top level are parked in its furthest slot and placed again when it is drained
+    const U32 span = getSlotSpan(TASK_RUNNER_TIMER_LEVELS - 1) * SLOTS;
+    const U32 placed = (delta < span) ? node.deadline : (this->m_tick + span - 1);
+    const FwSizeType index = (placed >> (level * TASK_RUNNER_TIMER_SLOT_BITS)) & (SLOTS - 1);
+    node.timerSlot = static_cast<U16>((level * SLOTS) + index);
+    TaskRunnerNode::append(this->m_slots[node.timerSlot], node);
+    this->m_occupied[level] |= static_cast<U32>(1) << index;
+}
+
+void TimerWheel::drain(FwSizeType slot, ExpiryHandler handler, void* context) {
+    while (this->m_slots[slot] != nullptr) {
+        TaskRunnerNode& node = *this->m_slots[slot];
+        TaskRunnerNode::remove(this->m_slots[slot], node);
+        this->markEmpty(slot);
+        if (static_cast<I32>(node.deadline - this->m_tick) > 0) {
+            this->place(node);
+            continue;
+        }
+        node.delayed = false;
+        this->m_count--;
+        handler(context, node);
+    }
+}
+
+U32 TimerWheel::getNextDrainTick() const {
+    FW_ASSERT(this->m_count > 0);
+    // A slot of level n is drained when the tick reaches a multiple of its span whose index at level n is the slot.
+    // The first drain of each level comes from the first slot holding nodes after the current index of the level
+    bool found = false;
+    U32 next = 0;
+    for (FwSizeType level = 0; level < TASK_RUNNER_TIMER_LEVELS; level++) {
+        const U32 occupied = this->m_occupied[level];
+        if (occupied == 0) {
+            continue;
+        }
+        const FwSizeType shift = level * TASK_RUNNER_TIMER_SLOT_BITS;
+        const U32 turn = this->m_tick >> shift;
+        const FwSizeType after = (static_cast<FwSizeType>(turn) + 1) & (SLOTS - 1);
+        // Rotate the bitmap so bit 0 is the slot after the current one
+        U32 rotated = occupied >> after;
+        if (after != 0) {
+            rotated |= occupied << (SLOTS - after);
+        }
+        // Widened so the mask of a full 32 slot level does not shift by the width of its type
+        rotated &= static_cast<U32>((static_cast<U64>(1) << SLOTS) - 1);
+        const U32 drainTick = (turn + 1 + static_cast<U32>(lowestBit(rotated))) << shift;
+        if ((not found) or (static_cast<I32>(drainTick - next) < 0)) {
+            next = drainTick;
+            found = true;
+        }
+    }
+    FW_ASSERT(found);
+    return next;
+}
+
+void TimerWheel::markEmpty(FwSizeType slot) {
+    if (this->m_slots[slot] == nullptr) {
+        this->m_occupied[slot / SLOTS] &= ~(static_cast<U32>(1) << (slot % SLOTS));
+    }
+}
+
+}  // End namespace Baremetal
+}  // End Namespace Os
@@ -0,0 +1,88 @@
+// ======================================================================
+// \title fprime-baremetal/Os/TaskRunner/TimerWheel.hpp
+// \brief TimerWheel definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_TASKRUNNER_TIMERWHEEL_HPP_
+#define FPRIME_BAREMETAL_TASKRUNNER_TIMERWHEEL_HPP_
+#include <Fw/Types/BasicTypes.hpp>
+#include "config/TaskRunnerCfg.hpp"
+
+namespace Os {
+namespace Baremetal {
+
+struct TaskRunnerNode;
+
+//! \brief hierarchical timer wheel holding delayed tasks until their deadline tick
+//!
+//! The wheel has `TASK_RUNNER_TIMER_LEVELS` levels of 2^`TASK_RUNNER_TIMER_SLOT_BITS` slots. Level 0 has one slot per
+//! tick, and each slot of level n covers a whole turn of level n - 1. A node is put in the lowest level whose range
+//! covers its deadline, and when a lower level completes a turn the matching slot of the level above is emptied into
+//! the lower levels. Inserting and cancelling are constant time. A bitmap per level records the slots holding nodes, so
+//! advancing jumps straight to the next tick at which a slot holding nodes is drained, however many ticks lie in
+//! between, and costs constant time per such slot plus one move per level for each node. Deadlines past the range of
+//! the top level are requeued until they are in range.
+//!
+//! Nodes are linked through the same links used for the ready lists, since a delayed task is never ready.
+class TimerWheel {
+  public:
+    static constexpr FwSizeType SLOTS = static_cast<FwSizeType>(1) << TASK_RUNNER_TIMER_SLOT_BITS;  //!< per level
+
+    //! \brief function called for each node whose deadline passed
+    typedef void (*ExpiryHandler)(void* context, TaskRunnerNode& node);
+
+    //! Empty wheel at tick 0
+    TimerWheel();
+
+    //! \brief get the tick the wheel has reached
+    U32 getTick() const;
+
+    //! \brief check whether any node is waiting
+    bool isEmpty() const;
+
+    //! \brief get the earliest deadline of the waiting nodes
+    //!
+    //! Walks every node, for simulations that skip idle time rather than advancing tick by tick.
+    //!
+    //! \param deadline: (output) earliest deadline tick
+    //! \return false, leaving the deadline untouched, if no node is waiting
+    bool getEarliestDeadline(U32& deadline) const;
+
+    //! \brief move an empty wheel to a tick without walking the ticks in between
+    void jump(U32 tick);
+
+    //! \brief add a node to expire at a deadline tick
+    //!
+    //! \param node: node not already in the wheel or a ready list
+    //! \param deadline: tick at which the node expires
+    //! \return false, without adding the node, if the deadline is not after the current tick
+    bool insert(TaskRunnerNode& node, U32 deadline);
+
+    //! \brief take a node out of the wheel
+    void cancel(TaskRunnerNode& node);
+
+    //! \brief walk the ticks up to a tick, handing every node that expires to the handler
+    //!
+    //! The handler may insert nodes again.
+    void advance(U32 tick, ExpiryHandler handler, void* context);
+
+  private:
+    //! \brief place a node in the slot matching its deadline
+    void place(TaskRunnerNode& node);
+
+    //! \brief empty one slot, placing its nodes again or expiring them
+    void drain(FwSizeType slot, ExpiryHandler handler, void* context);
+
+    //! \brief get the first tick after the current one at which a slot holding nodes is drained, with nodes waiting
+    U32 getNextDrainTick() const;
+
+    //! \brief clear the bit of a slot that became empty
+    void markEmpty(FwSizeType slot);
+
+    TaskRunnerNode* m_slots[TASK_RUNNER_TIMER_LEVELS * SLOTS];  //!< circular list of each slot, level by level
+    U32 m_occupied[TASK_RUNNER_TIMER_LEVELS];                    //!< bit n set when slot n of the level holds nodes
+    U32 m_tick;                                                  //!< last tick processed
+    FwSizeType m_count;                                          //!< nodes in the wheel
+};
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_TASKRUNNER_TIMERWHEEL_HPP_ */
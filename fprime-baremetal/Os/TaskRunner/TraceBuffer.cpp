@@ -0,0 +1,38 @@
+// ======================================================================
+// \title fprime-baremetal/Os/TaskRunner/TraceBuffer.cpp
+// \brief TraceBuffer implementations
+// ======================================================================
+#include <Fw/Types/Assert.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TraceBuffer.hpp>
+
+namespace Os {
+namespace Baremetal {
+
+static_assert(sizeof(TraceEntry) == 8, "Trace entries are packed in 8 bytes");
+
+TraceBuffer::TraceBuffer() : m_recorded(0) {
+    for (FwSizeType i = 0; i < TASK_RUNNER_TRACE_ENTRIES; i++) {
+        this->m_entries[i] = TraceEntry();
+    }
+}
+
+FwSizeType TraceBuffer::getCount() const {
+    return (this->m_recorded < TASK_RUNNER_TRACE_ENTRIES) ? this->m_recorded : TASK_RUNNER_TRACE_ENTRIES;
+}
+
+U32 TraceBuffer::getRecorded() const {
+    return this->m_recorded;
+}
+
+const TraceEntry& TraceBuffer::get(FwSizeType index) const {
+    const FwSizeType count = this->getCount();
+    FW_ASSERT(index < count, static_cast<FwAssertArgType>(index), static_cast<FwAssertArgType>(count));
+    return this->m_entries[(this->m_recorded - count + index) & (TASK_RUNNER_TRACE_ENTRIES - 1)];
+}
+
+void TraceBuffer::clear() {
+    this->m_recorded = 0;
+}
+
+}  // End namespace Baremetal
+}  // End Namespace Os
@@ -0,0 +1,71 @@
+// ======================================================================
+// \title fprime-baremetal/Os/TaskRunner/TraceBuffer.hpp
+// \brief TraceBuffer definitions
+// ======================================================================
+#ifndef FPRIME_BAREMETAL_TASKRUNNER_TRACEBUFFER_HPP_
+#define FPRIME_BAREMETAL_TASKRUNNER_TRACEBUFFER_HPP_
+#include <Fw/Types/BasicTypes.hpp>
+#include "config/TaskRunnerCfg.hpp"
+
+namespace Os {
+namespace Baremetal {
+
+//! \brief kind of a scheduling event
+enum TraceEvent : U8 {
+    TRACE_DISPATCH = 1,    //!< a slice of task id starts
+    TRACE_SLICE_END = 2,   //!< the slice of task id returned after data units of work
+    TRACE_TASK_EXIT = 3,   //!< task id exited and was removed
+    TRACE_IDLE_BEGIN = 4,  //!< the runner found no ready task
+    TRACE_IDLE_END = 5,    //!< a task runs again after idle time
+    TRACE_MARKER = 6,      //!< user marker id with value data
+};
+
+//! \brief one scheduling event
+struct TraceEntry {
+    U32 timeUs;  //!< low 32 bits of the runner clock, in microseconds
+    U16 id;      //!< trace id of the task, or marker id
+    U8 event;    //!< TraceEvent
+    U8 data;     //!< event data
+};
+
+//! \brief fixed-size ring buffer of scheduling events, keeping the latest `TASK_RUNNER_TRACE_ENTRIES`
+//!
+//! Recording an event is a masked index and four stores, with no check or branch, so it can stay enabled in flight.
+//! Older events are overwritten, the buffer keeps the run-up to the moment it is dumped.
+class TraceBuffer {
+  public:
+    static_assert((TASK_RUNNER_TRACE_ENTRIES & (TASK_RUNNER_TRACE_ENTRIES - 1)) == 0,
+                  "Trace entries must be a power of two");
+
+    //! Empty buffer
+    TraceBuffer();
+
+    //! \brief record an event, overwriting the oldest one when full
+    void record(U32 timeUs, TraceEvent event, U16 id, U8 data) {
+        TraceEntry& entry = this->m_entries[this->m_recorded & (TASK_RUNNER_TRACE_ENTRIES - 1)];
+        entry.timeUs = timeUs;
+        entry.id = id;
+        entry.event = event;
+        entry.data = data;
+        this->m_recorded++;
+    }
+
+    //! \brief get the number of events held
+    FwSizeType getCount() const;
+
+    //! \brief get the number of events recorded since cleared, held or overwritten
+    U32 getRecorded() const;
+
+    //! \brief get a held event, oldest first
+    const TraceEntry& get(FwSizeType index) const;
+
+    //! \brief drop every event
+    void clear();
+
+  private:
+    TraceEntry m_entries[TASK_RUNNER_TRACE_ENTRIES];  //!< ring of events
+    U32 m_recorded;                                   //!< events recorded, the next one goes at this index modulo size
+};
+}  // End namespace Baremetal
+}  // End Namespace Os
+#endif /* FPRIME_BAREMETAL_TASKRUNNER_TRACEBUFFER_HPP_ */
@@ -0,0 +1,734 @@
+// ----------------------------------------------------------------------
+// TaskRunnerTest.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Types/String.hpp>
+#include <Os/Task.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+#include <fprime-baremetal/Os/TaskRunner/TimerWheel.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+std::vector<U32> runs;
+
+struct Worker {
+    U32 id;
+    U32 delayMs;  //!< delay requested by the next unit of work, 0 for none
+    bool armed;   //!< set once the task is registered, so start does not delay outside of the runner
+};
+
+void work(void* argument) {
+    Worker& worker = *static_cast<Worker*>(argument);
+    runs.push_back(worker.id);
+    if (worker.armed and (worker.delayMs > 0)) {
+        Os::Task::delay(Fw::TimeInterval(worker.delayMs / 1000, (worker.delayMs % 1000) * 1000));
+    }
+}
+
+void startWorker(Os::Task& task, Worker& worker, FwTaskPriorityType priority) {
+    Fw::String name("worker");
+    Os::Task::Arguments arguments(name, work, &worker, priority);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+    worker.armed = true;
+}
+
+U64 virtualTimeUs = 0;
+
+U64 virtualClock(void*) {
+    return virtualTimeUs;
+}
+
+void expectRuns(const std::vector<U32>& expected) {
+    EXPECT_EQ(expected, runs);
+    runs.clear();
+}
+
+}  // namespace
+
+TEST(TaskRunner, PriorityPasses) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Task tasks[4];
+    Worker workers[4] = {{0, 0, false}, {1, 0, false}, {2, 0, false}, {3, 0, false}};
+    const FwTaskPriorityType priorities[4] = {10, 200, 100, 200};
+    for (FwSizeType i = 0; i < 4; i++) {
+        startWorker(tasks[i], workers[i], priorities[i]);
+    }
+    runs.clear();
+
+    // Every task runs once per pass, highest priority first and in order of addition within a priority
+    for (FwSizeType i = 0; i < 8; i++) {
+        runner.run();
+    }
+    expectRuns({1, 3, 2, 0, 1, 3, 2, 0});
+
+    // Suspended tasks drop out of the passes until resumed
+    tasks[3].suspend(Os::Task::SuspensionType::INTENTIONAL);
+    runner.runAll();
+    expectRuns({1, 2, 0});
+    tasks[3].resume();
+    runner.runAll();
+    expectRuns({3, 1, 2, 0});
+
+    for (FwSizeType i = 0; i < 4; i++) {
+        runner.removeTask(&tasks[i]);
+    }
+    runner.runAll();
+    expectRuns({});
+}
+
+TEST(TaskRunner, AdjacentPriorities) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Task tasks[3];
+    Worker workers[3] = {{0, 0, false}, {1, 0, false}, {2, 0, false}};
+    const FwTaskPriorityType priorities[3] = {100, 101, 102};
+    for (FwSizeType i = 0; i < 3; i++) {
+        startWorker(tasks[i], workers[i], priorities[i]);
+    }
+    runs.clear();
+
+    // Each priority has its own level, so a priority one higher runs first whatever the order of addition
+    runner.runAll();
+    expectRuns({2, 1, 0});
+
+    for (FwSizeType i = 0; i < 3; i++) {
+        runner.removeTask(&tasks[i]);
+    }
+}
+
+namespace {
+
+Os::Baremetal::TaskWaker waker;
+U32 idleCalls = 0;
+
+void consume(void* argument) {
+    runs.push_back(*static_cast<U32*>(argument));
+    waker.bindCurrent(2);
+}
+
+void countIdle(void*) {
+    idleCalls++;
+}
+
+}  // namespace
+
+TEST(TaskRunner, WakeAndIdle) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    runner.setIdleHook(countIdle);
+    Os::Task task;
+    U32 id = 7;
+    Fw::String name("consumer");
+    Os::Task::Arguments arguments(name, consume, &id, 5);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+    runs.clear();
+    idleCalls = 0;
+
+    // Bound with two units of work pending, the consumer runs twice and then only the idle hook is called
+    for (FwSizeType i = 0; i < 4; i++) {
+        runner.run();
+    }
+    expectRuns({7, 7});
+    EXPECT_EQ(2, idleCalls);
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    // Each notification is one more unit of work
+    waker.notify();
+    waker.notify();
+    EXPECT_TRUE(runner.hasReadyTask());
+    for (FwSizeType i = 0; i < 4; i++) {
+        runner.run();
+    }
+    expectRuns({7, 7});
+    EXPECT_EQ(4, idleCalls);
+
+    // Notifications from interrupts are collected by the next run, one unit of work each
+    waker.notifyFromIsr();
+    waker.notifyFromIsr();
+    EXPECT_TRUE(runner.hasReadyTask());
+    for (FwSizeType i = 0; i < 4; i++) {
+        runner.run();
+    }
+    expectRuns({7, 7});
+    EXPECT_EQ(6, idleCalls);
+
+    runner.removeTask(&task);
+    runner.setIdleHook(nullptr);
+}
+
+namespace {
+
+Os::Baremetal::TaskWaker countedWaker;
+
+void consumeCounted(void* argument) {
+    runs.push_back(*static_cast<U32*>(argument));
+    countedWaker.bindCurrent(3);
+}
+
+//! \brief call run a number of times
+void runTimes(FwSizeType times) {
+    for (FwSizeType i = 0; i < times; i++) {
+        Os::Baremetal::TaskRunner::getSingleton().run();
+    }
+}
+
+}  // namespace
+
+TEST(TaskRunner, WakeCounts) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    Os::Baremetal::TaskWaker unbound;
+    unbound.notify();
+    EXPECT_EQ(nullptr, unbound.getTask());
+
+    Os::Task task;
+    U32 id = 3;
+    Fw::String name("counted");
+    Os::Task::Arguments arguments(name, consumeCounted, &id, 5);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+    runs.clear();
+
+    // The first unit of work binds the task with three units pending, counting its own. The others drain one per run.
+    // Binding again from later units of work changes nothing, so the task then stays out of the passes
+    runTimes(6);
+    EXPECT_EQ(&task, countedWaker.getTask());
+    expectRuns({3, 3, 3});
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    // Wakeups signaled while suspended are kept and all run once resumed
+    task.suspend(Os::Task::SuspensionType::INTENTIONAL);
+    countedWaker.notify();
+    countedWaker.notify();
+    countedWaker.notifyFromIsr();
+    runTimes(6);
+    expectRuns({});
+    task.resume();
+    runTimes(6);
+    expectRuns({3, 3, 3});
+
+    // Waking through the runner counts the same as through the waker
+    runner.wake(&task);
+    countedWaker.notify();
+    runTimes(6);
+    expectRuns({3, 3});
+
+    // Leaving the wait for wakeups runs the task on every pass again
+    runner.setWaitForWake(&task, false);
+    runTimes(3);
+    expectRuns({3, 3, 3});
+
+    runner.removeTask(&task);
+}
+
+TEST(TaskRunner, Delays) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    // Host RawTime can be read, and a clock of its own always can
+    EXPECT_TRUE(runner.hasClock());
+    virtualTimeUs = 5000;
+    runner.setClock(virtualClock);
+    EXPECT_TRUE(runner.hasClock());
+    Os::Task tasks[3];
+    Worker workers[3] = {{0, 3, false}, {1, 0, false}, {2, 2000000, false}};
+    for (FwSizeType i = 0; i < 3; i++) {
+        startWorker(tasks[i], workers[i], 100);
+    }
+    runs.clear();
+
+    // Delayed tasks sit out the passes until their delay has passed
+    runner.runAll();
+    expectRuns({0, 1, 2});
+    EXPECT_TRUE(runner.hasDelayedTask());
+    virtualTimeUs += 2999;
+    runner.runAll();
+    expectRuns({1});
+    virtualTimeUs += 1;
+    runner.runAll();
+    expectRuns({0, 1});
+
+    // A delay past the range of the timer wheel is carried over until it ends
+    workers[0].delayMs = 0;
+    for (U32 second = 1; second < 2000; second += 7) {
+        virtualTimeUs = 8000 + (static_cast<U64>(second) * 1000000);
+        runner.runAll();
+        expectRuns({0, 1});
+    }
+    // Tasks whose delay ended join the current pass ahead of the tasks already waiting in it
+    virtualTimeUs = 8000 + 2000000000;
+    runner.runAll();
+    expectRuns({2, 0, 1});
+
+    // Removing a delayed task takes it out of the timer wheel
+    runner.removeTask(&tasks[2]);
+    EXPECT_FALSE(runner.hasDelayedTask());
+    runner.removeTask(&tasks[0]);
+    runner.removeTask(&tasks[1]);
+    runner.setClock(nullptr);
+}
+
+namespace {
+
+//! unit of work taking the virtual time given as argument
+void spend(void* argument) {
+    virtualTimeUs += *static_cast<U32*>(argument);
+}
+
+void sleepIdle(void*) {
+    virtualTimeUs += 70;
+}
+
+}  // namespace
+
+TEST(TaskRunner, CpuTime) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    virtualTimeUs = 1000;
+    runner.setClock(virtualClock);
+    runner.setIdleHook(sleepIdle);
+    Os::Task task;
+    U32 costUs = 30;
+    Fw::String name("busy");
+    Os::Task::Arguments arguments(name, spend, &costUs, 1);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+    runner.setWaitForWake(&task, true);
+
+    U64 usedUs = 1;
+    U64 totalUs = 1;
+    runner.getCpuTime(usedUs, totalUs);
+    EXPECT_EQ(0, usedUs);
+    EXPECT_EQ(0, totalUs);
+
+    // Each unit of work takes 30 us and is followed by 70 us asleep in the idle hook
+    for (FwSizeType i = 0; i < 10; i++) {
+        runner.wake(&task);
+        runner.run();
+        runner.run();
+    }
+    runner.getCpuTime(usedUs, totalUs);
+    EXPECT_EQ(300, usedUs);
+    EXPECT_EQ(1000, totalUs);
+
+    // Time between idle calls of run also counts as idle
+    virtualTimeUs += 500;
+    runner.getCpuTime(usedUs, totalUs);
+    EXPECT_EQ(300, usedUs);
+    EXPECT_EQ(1500, totalUs);
+
+    runner.removeTask(&task);
+    runner.setIdleHook(nullptr);
+    runner.setClock(nullptr);
+}
+
+namespace {
+
+struct Job {
+    U32 id;
+    U32 costUs;  //!< virtual time taken by each unit of work
+};
+
+void runJob(void* argument) {
+    Job& job = *static_cast<Job*>(argument);
+    runs.push_back(job.id);
+    virtualTimeUs += job.costUs;
+}
+
+void startJob(Os::Task& task, Job& job, FwTaskPriorityType priority) {
+    Fw::String name("job");
+    Os::Task::Arguments arguments(name, runJob, &job, priority);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+}
+
+}  // namespace
+
+TEST(TaskRunner, StrictPriorityWithBudget) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    virtualTimeUs = 0;
+    runner.setClock(virtualClock);
+    runner.setPolicy(Os::Baremetal::TaskRunner::Policy::STRICT_PRIORITY);
+    Os::Task tasks[2];
+    Job jobs[2] = {{0, 60}, {1, 10}};
+    startJob(tasks[0], jobs[0], 200);
+    startJob(tasks[1], jobs[1], 100);
+    runs.clear();
+
+    // The highest priority task keeps the processor
+    for (FwSizeType i = 0; i < 3; i++) {
+        runner.run();
+    }
+    expectRuns({0, 0, 0});
+
+    // With 100 us per 1000 us period, it is held back once the budget is used and the other task runs
+    virtualTimeUs = 1000;
+    runner.setTiming(&tasks[0], 1000, 0, 100);
+    for (FwSizeType i = 0; i < 4; i++) {
+        runner.run();
+    }
+    expectRuns({0, 0, 1, 1});
+    virtualTimeUs = 2000;
+    runner.run();
+    expectRuns({0});
+
+    runner.removeTask(&tasks[0]);
+    runner.removeTask(&tasks[1]);
+    runner.setPolicy(Os::Baremetal::TaskRunner::Policy::PASSES);
+    runner.setClock(nullptr);
+}
+
+TEST(TaskRunner, EarliestDeadlineFirst) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    virtualTimeUs = 0;
+    runner.setClock(virtualClock);
+    runner.setPolicy(Os::Baremetal::TaskRunner::Policy::EARLIEST_DEADLINE);
+    Os::Task tasks[3];
+    Job jobs[3] = {{0, 10}, {1, 10}, {2, 10}};
+    // Priorities are ignored between tasks with deadlines, and tasks without one run in the background
+    const FwTaskPriorityType priorities[3] = {200, 1, 255};
+    for (FwSizeType i = 0; i < 3; i++) {
+        startJob(tasks[i], jobs[i], priorities[i]);
+    }
+    runner.setTiming(&tasks[0], 1000);
+    runner.setTiming(&tasks[1], 1000, 200);
+    runner.setWaitForWake(&tasks[0], true);
+    runner.setWaitForWake(&tasks[1], true);
+    runs.clear();
+
+    runner.wake(&tasks[0]);
+    runner.wake(&tasks[1]);
+    for (FwSizeType i = 0; i < 3; i++) {
+        runner.run();
+    }
+    expectRuns({1, 0, 2});
+
+    // Deadlines count from the time a task is woken: 1000 us after for task 0 and 200 us after for task 1
+    runner.wake(&tasks[0]);
+    virtualTimeUs += 900;
+    runner.wake(&tasks[1]);
+    runner.run();
+    runner.run();
+    expectRuns({0, 1});
+    virtualTimeUs += 1000;
+    runner.wake(&tasks[0]);
+    virtualTimeUs += 700;
+    runner.wake(&tasks[1]);
+    runner.runAll();
+    expectRuns({1, 0, 2});
+
+    for (FwSizeType i = 0; i < 3; i++) {
+        runner.removeTask(&tasks[i]);
+    }
+    runner.setPolicy(Os::Baremetal::TaskRunner::Policy::PASSES);
+    runner.setClock(nullptr);
+}
+
+TEST(TaskRunner, EarliestDeadlineReleasesOncePerPeriod) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    virtualTimeUs = 0;
+    runner.setClock(virtualClock);
+    runner.setPolicy(Os::Baremetal::TaskRunner::Policy::EARLIEST_DEADLINE);
+    Os::Task tasks[2];
+    Job jobs[2] = {{0, 100}, {1, 10}};
+    startJob(tasks[0], jobs[0], 1);
+    startJob(tasks[1], jobs[1], 1);
+    // Starting ran each job once
+    virtualTimeUs = 0;
+    runner.setTiming(&tasks[0], 1000);
+    runs.clear();
+
+    // The timed task never waits for wakeups, yet runs once per period and leaves the rest to the untimed one
+    for (FwSizeType i = 0; i < 4; i++) {
+        runner.run();
+    }
+    expectRuns({0, 1, 1, 1});
+    virtualTimeUs = 1000;
+    runner.run();
+    runner.run();
+    expectRuns({0, 1});
+    virtualTimeUs = 2500;
+    runner.run();
+    runner.run();
+    expectRuns({0, 1});
+
+    runner.removeTask(&tasks[0]);
+    runner.removeTask(&tasks[1]);
+    runner.setPolicy(Os::Baremetal::TaskRunner::Policy::PASSES);
+    runner.setClock(nullptr);
+}
+
+TEST(TaskRunner, ThrottleEndIsNotAWakeup) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    virtualTimeUs = 0;
+    runner.setClock(virtualClock);
+    Os::Task task;
+    Job job = {0, 60};
+    startJob(task, job, 1);
+    virtualTimeUs = 0;
+    runner.setTiming(&task, 1000, 0, 100);
+    runner.setWaitForWake(&task, true, 3);
+    runs.clear();
+
+    // Two units of work use up the budget, and the third wakeup waits for the next period
+    for (FwSizeType i = 0; i < 3; i++) {
+        runner.run();
+    }
+    expectRuns({0, 0});
+    // Only the wakeup left runs once the period ends
+    virtualTimeUs = 1000;
+    for (FwSizeType i = 0; i < 3; i++) {
+        runner.run();
+    }
+    expectRuns({0});
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    runner.removeTask(&task);
+    runner.setClock(nullptr);
+}
+
+TEST(TaskRunner, DrainBatches) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    virtualTimeUs = 0;
+    runner.setClock(virtualClock);
+    Os::Task task;
+    Job job = {4, 300};
+    startJob(task, job, 1);
+    runs.clear();
+
+    // Up to 4 pending units of work per slice
+    runner.setWaitForWake(&task, true, 10);
+    runner.setDrain(&task, 4);
+    for (FwSizeType i = 0; i < 4; i++) {
+        runner.run();
+    }
+    expectRuns({4, 4, 4, 4, 4, 4, 4, 4, 4, 4});
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    // Adaptive slices drain half of the pending units of work: 5, 3, 1 and 1 of 10
+    runner.setWaitForWake(&task, true, 10);
+    runner.setDrain(&task, 8, 0, true);
+    const FwSizeType slices[4] = {5, 3, 1, 1};
+    for (const FwSizeType units : slices) {
+        runner.run();
+        EXPECT_EQ(units, runs.size());
+        runs.clear();
+    }
+    EXPECT_FALSE(runner.hasReadyTask());
+
+    // Draining stops once the slice took its time, here after 4 units of work of 300 us
+    runner.setWaitForWake(&task, true, 10);
+    runner.setDrain(&task, 8, 1000);
+    runner.run();
+    expectRuns({4, 4, 4, 4});
+
+    // Tasks running on every pass have no pending count and run one unit of work per slice
+    runner.setWaitForWake(&task, false);
+    runner.run();
+    expectRuns({4});
+
+    runner.removeTask(&task);
+    runner.setClock(nullptr);
+}
+
+#if TASK_RUNNER_PROFILING
+namespace {
+
+U32 visits = 0;
+
+void countVisit(void* context, Os::Task& task, const Os::Baremetal::TaskProfile& profile) {
+    visits++;
+    EXPECT_EQ(static_cast<Os::Task*>(context), &task);
+    EXPECT_EQ(3, profile.windowRuns);
+}
+
+}  // namespace
+
+TEST(TaskRunner, Profiling) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    runner.setClock(virtualClock);
+    Os::Task task;
+    U32 costUs = 0;
+    Fw::String name("busy");
+    Os::Task::Arguments arguments(name, spend, &costUs, 1);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+    runner.setBudget(&task, 100);
+
+    const U32 costs[3] = {0, 5, 150};
+    for (FwSizeType i = 0; i < 3; i++) {
+        costUs = costs[i];
+        runner.runAll();
+    }
+    Os::Baremetal::TaskProfile profile;
+    ASSERT_TRUE(runner.getProfile(&task, profile));
+    EXPECT_EQ(3, profile.runs);
+    EXPECT_EQ(155, profile.totalUs);
+    EXPECT_EQ(150, profile.maxUs);
+    EXPECT_EQ(1, profile.overruns);
+    // 0 us, 4 to 7 us and 128 to 255 us
+    EXPECT_EQ(1, profile.histogram[0]);
+    EXPECT_EQ(1, profile.histogram[3]);
+    EXPECT_EQ(1, profile.histogram[8]);
+
+    // Visiting with a restart clears the window only
+    runner.visitProfiles(countVisit, &task, true);
+    EXPECT_EQ(1, visits);
+    ASSERT_TRUE(runner.getProfile(&task, profile));
+    EXPECT_EQ(0, profile.windowRuns);
+    EXPECT_EQ(0, profile.windowUs);
+    EXPECT_EQ(3, profile.runs);
+
+    runner.removeTask(&task);
+    EXPECT_FALSE(runner.getProfile(&task, profile));
+    runner.setClock(nullptr);
+}
+#endif
+
+namespace {
+
+std::vector<U32> expiries;
+
+void recordExpiry(void* context, Os::Baremetal::TaskRunnerNode& node) {
+    expiries.push_back(node.deadline);
+    ASSERT_EQ(node.deadline, static_cast<Os::Baremetal::TimerWheel*>(context)->getTick());
+}
+
+}  // namespace
+
+#if TASK_RUNNER_TRACING
+namespace {
+
+//! trace writer collecting the dump
+bool collect(void* context, const U8* data, FwSizeType size) {
+    std::vector<U8>& dump = *static_cast<std::vector<U8>*>(context);
+    dump.insert(dump.end(), data, data + size);
+    return true;
+}
+
+U32 getU32(const std::vector<U8>& dump, FwSizeType offset) {
+    return static_cast<U32>(dump[offset]) | (static_cast<U32>(dump[offset + 1]) << 8) |
+           (static_cast<U32>(dump[offset + 2]) << 16) | (static_cast<U32>(dump[offset + 3]) << 24);
+}
+
+}  // namespace
+
+TEST(TaskRunner, Trace) {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    runner.setClock(virtualClock);
+    Os::Task task;
+    U32 costUs = 40;
+    Fw::String name("busy");
+    Os::Task::Arguments arguments(name, spend, &costUs, 1);
+    ASSERT_EQ(Os::Task::Status::OP_OK, task.start(arguments));
+    runner.setWaitForWake(&task, true, 1);
+    runner.clearTrace();
+    virtualTimeUs = 10000;
+
+    // A slice, idle time, a marker and another slice
+    runner.run();
+    runner.run();
+    virtualTimeUs += 100;
+    runner.mark(7, 3);
+    runner.wake(&task);
+    runner.run();
+
+    std::vector<U8> dump;
+    ASSERT_TRUE(runner.dumpTrace(collect, &dump));
+    ASSERT_GE(dump.size(), 16U);
+    EXPECT_EQ(0, std::memcmp(dump.data(), "FTRC", 4));
+    EXPECT_EQ(1, dump[4]);
+    ASSERT_EQ(1, dump[6] | (dump[7] << 8));
+    EXPECT_EQ(7U, getU32(dump, 8));
+    EXPECT_EQ(0U, getU32(dump, 12));
+    const FwSizeType nameLength = dump[18];
+    const FwSizeType events = 16 + 3 + nameLength;
+    ASSERT_EQ(events + (7 * 8), dump.size());
+    const U16 taskId = static_cast<U16>(dump[16] | (dump[17] << 8));
+
+    const U8 kinds[7] = {Os::Baremetal::TRACE_DISPATCH, Os::Baremetal::TRACE_SLICE_END,
+                         Os::Baremetal::TRACE_IDLE_BEGIN, Os::Baremetal::TRACE_MARKER,
+                         Os::Baremetal::TRACE_IDLE_END, Os::Baremetal::TRACE_DISPATCH,
+                         Os::Baremetal::TRACE_SLICE_END};
+    const U32 times[7] = {10000, 10040, 10040, 10140, 10140, 10140, 10180};
+    const U16 ids[7] = {taskId, taskId, 0, 7, 0, taskId, taskId};
+    for (FwSizeType i = 0; i < 7; i++) {
+        const FwSizeType offset = events + (i * 8);
+        EXPECT_EQ(times[i], getU32(dump, offset));
+        EXPECT_EQ(ids[i], dump[offset + 4] | (dump[offset + 5] << 8));
+        EXPECT_EQ(kinds[i], dump[offset + 6]);
+    }
+    // Slice ends carry the units of work run, markers their value
+    EXPECT_EQ(1, dump[events + 8 + 7]);
+    EXPECT_EQ(3, dump[events + (3 * 8) + 7]);
+
+    runner.removeTask(&task);
+    runner.setClock(nullptr);
+}
+
+TEST(TraceBuffer, KeepsLatest) {
+    Os::Baremetal::TraceBuffer trace;
+    EXPECT_EQ(0U, trace.getCount());
+    for (U32 i = 0; i < (Os::TASK_RUNNER_TRACE_ENTRIES + 5); i++) {
+        trace.record(i, Os::Baremetal::TRACE_MARKER, static_cast<U16>(i), 0);
+    }
+    ASSERT_EQ(Os::TASK_RUNNER_TRACE_ENTRIES, trace.getCount());
+    EXPECT_EQ(Os::TASK_RUNNER_TRACE_ENTRIES + 5, trace.getRecorded());
+    EXPECT_EQ(5U, trace.get(0).timeUs);
+    EXPECT_EQ(Os::TASK_RUNNER_TRACE_ENTRIES + 4, trace.get(Os::TASK_RUNNER_TRACE_ENTRIES - 1).timeUs);
+    trace.clear();
+    EXPECT_EQ(0U, trace.getCount());
+}
+#endif
+
+TEST(TimerWheel, ExpiresOnDeadline) {
+    const FwSizeType NODES = 200;
+    Os::Baremetal::TimerWheel wheel;
+    Os::Baremetal::TaskRunnerNode nodes[NODES];
+    // Start close to the wrap of the tick counter, with deadlines at every level of the wheel
+    wheel.jump(0xFFFFF000);
+    std::srand(1);
+    for (FwSizeType i = 0; i < NODES; i++) {
+        const U32 delay = 1 + (static_cast<U32>(std::rand()) % (1U << (8 + (i % 16))));
+        ASSERT_TRUE(wheel.insert(nodes[i], wheel.getTick() + delay));
+    }
+    Os::Baremetal::TaskRunnerNode late;
+    ASSERT_FALSE(wheel.insert(late, wheel.getTick()));
+    // Cancelled nodes never expire
+    for (FwSizeType i = 0; i < NODES; i += 10) {
+        wheel.cancel(nodes[i]);
+    }
+    // The earliest deadline is found across the wrap of the tick counter
+    U32 earliest = 0;
+    ASSERT_TRUE(wheel.getEarliestDeadline(earliest));
+    for (FwSizeType i = 0; i < NODES; i++) {
+        if (nodes[i].delayed) {
+            ASSERT_GE(static_cast<I32>(nodes[i].deadline - earliest), 0);
+        }
+    }
+    U32 tick = wheel.getTick();
+    while (not wheel.isEmpty()) {
+        tick += 1 + (static_cast<U32>(std::rand()) % 3);
+        wheel.advance(tick, recordExpiry, &wheel);
+    }
+    ASSERT_EQ(NODES - (NODES / 10), expiries.size());
+    ASSERT_FALSE(wheel.getEarliestDeadline(earliest));
+    for (FwSizeType i = 0; i < NODES; i++) {
+        ASSERT_FALSE(nodes[i].delayed);
+    }
+
+    // A single advance over millions of ticks expires every node on its deadline tick, in order
+    expiries.clear();
+    for (FwSizeType i = 0; i < NODES; i++) {
+        const U32 delay = 1 + (static_cast<U32>(std::rand()) % (1U << (8 + (i % 16))));
+        ASSERT_TRUE(wheel.insert(nodes[i], wheel.getTick() + delay));
+    }
+    const U32 start = wheel.getTick();
+    wheel.advance(start + (1U << 24), recordExpiry, &wheel);
+    ASSERT_TRUE(wheel.isEmpty());
+    ASSERT_EQ(start + (1U << 24), wheel.getTick());
+    ASSERT_EQ(NODES, expiries.size());
+    for (FwSizeType i = 1; i < NODES; i++) {
+        ASSERT_LE(expiries[i - 1] - start, expiries[i] - start);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
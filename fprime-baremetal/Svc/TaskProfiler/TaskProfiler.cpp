@@ -0,0 +1,87 @@
+// ======================================================================
+// \title  TaskProfiler.cpp
+// \brief  cpp file for TaskProfiler component implementation class
+// ======================================================================
+
+#include <fprime-baremetal/Svc/TaskProfiler/TaskProfiler.hpp>
+
+namespace Baremetal {
+
+// ----------------------------------------------------------------------
+// Component construction and destruction
+// ----------------------------------------------------------------------
+
+TaskProfiler::TaskProfiler(const char* const compName) : TaskProfilerComponentBase(compName) {}
+
+TaskProfiler::~TaskProfiler() {}
+
+// ----------------------------------------------------------------------
+// Handler implementations for typed input ports
+// ----------------------------------------------------------------------
+
+void TaskProfiler::run_handler(FwIndexType portNum, U32 context) {
+#if TASK_RUNNER_PROFILING
+    this->m_busiestTask = nullptr;
+    this->m_busiestUs = 0;
+    this->m_taskTimeUs = 0;
+    this->m_maxSliceUs = 0;
+    this->m_overruns = 0;
+    // Each report covers the units of work run since the previous one
+    Os::Baremetal::TaskRunner::getSingleton().visitProfiles(TaskProfiler::collectProfile, this, true);
+
+    if (this->m_busiestTask != nullptr) {
+        this->tlmWrite_BusiestTask(this->m_busiestTask->getName());
+        const F32 share = (this->m_taskTimeUs == 0) ? 0.0f
+                                                    : (static_cast<F32>(this->m_busiestUs) * 100.0f) /
+                                                          static_cast<F32>(this->m_taskTimeUs);
+        this->tlmWrite_BusiestTaskShare(share);
+    }
+    this->tlmWrite_TaskTimeUs(this->m_taskTimeUs);
+    this->tlmWrite_MaxSliceUs(this->m_maxSliceUs);
+    this->tlmWrite_Overruns(this->m_overruns);
+#endif
+}
+
+// ----------------------------------------------------------------------
+// Handler implementations for commands
+// ----------------------------------------------------------------------
+
+void TaskProfiler::DUMP_PROFILES_cmdHandler(FwOpcodeType opCode, U32 cmdSeq) {
+#if TASK_RUNNER_PROFILING
+    Os::Baremetal::TaskRunner::getSingleton().visitProfiles(TaskProfiler::dumpProfile, this, false);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+#else
+    this->log_WARNING_LO_ProfilingDisabled();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+#endif
+}
+
+#if TASK_RUNNER_PROFILING
+// ----------------------------------------------------------------------
+// Profile visitors
+// ----------------------------------------------------------------------
+
+void TaskProfiler::collectProfile(void* context, Os::Task& task, const Os::Baremetal::TaskProfile& profile) {
+    TaskProfiler& self = *static_cast<TaskProfiler*>(context);
+    self.m_taskTimeUs += profile.windowUs;
+    self.m_overruns += profile.overruns;
+    if (profile.windowMaxUs > self.m_maxSliceUs) {
+        self.m_maxSliceUs = profile.windowMaxUs;
+    }
+    if ((self.m_busiestTask == nullptr) or (profile.windowUs > self.m_busiestUs)) {
+        self.m_busiestTask = &task;
+        self.m_busiestUs = profile.windowUs;
+    }
+    if (profile.windowOverruns > 0) {
+        self.log_WARNING_LO_SliceOverrun(task.getName(), profile.windowOverruns, profile.windowMaxUs,
+                                         profile.budgetUs);
+    }
+}
+
+void TaskProfiler::dumpProfile(void* context, Os::Task& task, const Os::Baremetal::TaskProfile& profile) {
+    TaskProfiler& self = *static_cast<TaskProfiler*>(context);
+    self.log_ACTIVITY_LO_TaskProfile(task.getName(), profile.runs, profile.totalUs, profile.maxUs, profile.overruns);
+}
+#endif
+
+}  // namespace Baremetal
@@ -0,0 +1,72 @@
+// ======================================================================
+// \title  TaskProfiler.hpp
+// \brief  hpp file for TaskProfiler component implementation class
+// ======================================================================
+
+#ifndef Baremetal_TaskProfiler_HPP
+#define Baremetal_TaskProfiler_HPP
+
+#include <fprime-baremetal/Os/TaskRunner/TaskRunner.hpp>
+#include <fprime-baremetal/Svc/TaskProfiler/TaskProfilerComponentAc.hpp>
+
+namespace Baremetal {
+
+class TaskProfiler final : public TaskProfilerComponentBase {
+  public:
+    // ----------------------------------------------------------------------
+    // Component construction and destruction
+    // ----------------------------------------------------------------------
+
+    //! Construct TaskProfiler object
+    TaskProfiler(const char* const compName  //!< The component name
+    );
+
+    //! Destroy TaskProfiler object
+    ~TaskProfiler();
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handler implementations for typed input ports
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for run
+    //!
+    //! Run port collecting the profile of the last interval
+    void run_handler(FwIndexType portNum,  //!< The port number
+                     U32 context           //!< The call order
+                     ) override;
+
+  private:
+    // ----------------------------------------------------------------------
+    // Handler implementations for commands
+    // ----------------------------------------------------------------------
+
+    //! Handler implementation for command DUMP_PROFILES
+    //!
+    //! Report the execution profile of every task as events
+    void DUMP_PROFILES_cmdHandler(FwOpcodeType opCode,  //!< The opcode
+                                  U32 cmdSeq            //!< The command sequence number
+                                  ) override;
+
+#if TASK_RUNNER_PROFILING
+    // ----------------------------------------------------------------------
+    // Profile visitors
+    // ----------------------------------------------------------------------
+
+    //! Add the window of one task to the totals of the interval
+    static void collectProfile(void* context, Os::Task& task, const Os::Baremetal::TaskProfile& profile);
+
+    //! Report the profile of one task as an event
+    static void dumpProfile(void* context, Os::Task& task, const Os::Baremetal::TaskProfile& profile);
+
+    Os::Task* m_busiestTask = nullptr;  //!< task with the most time in the interval
+    U64 m_busiestUs = 0;                //!< time of the busiest task in the interval
+    U64 m_taskTimeUs = 0;               //!< time of all tasks in the interval
+    U32 m_maxSliceUs = 0;               //!< longest unit of work in the interval
+    U32 m_overruns = 0;                 //!< overruns of all tasks since startup
+#endif
+};
+
+}  // namespace Baremetal
+
+#endif  // Baremetal_TaskProfiler_HPP
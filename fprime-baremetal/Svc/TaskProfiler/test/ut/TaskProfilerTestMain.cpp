@@ -0,0 +1,42 @@
+// ----------------------------------------------------------------------
+// TaskProfilerTestMain.cpp
+// ----------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <Fw/Test/UnitTest.hpp>
+#include "TaskProfilerTester.hpp"
+
+#if TASK_RUNNER_PROFILING
+TEST(TaskProfilerTest, Telemetry) {
+    COMMENT("Run two tasks and check the telemetry of the interval, then of an empty interval.");
+
+    Baremetal::TaskProfilerTester tester;
+    tester.runTelemetry();
+}
+
+TEST(TaskProfilerTest, SliceOverrun) {
+    COMMENT("Overrun the budget of a task and check the event and the overrun count.");
+
+    Baremetal::TaskProfilerTester tester;
+    tester.runSliceOverrun();
+}
+
+TEST(TaskProfilerTest, DumpProfiles) {
+    COMMENT("Dump the profiles and check the event of each task and the command response.");
+
+    Baremetal::TaskProfilerTester tester;
+    tester.runDumpProfiles();
+}
+#else
+TEST(TaskProfilerTest, ProfilingDisabled) {
+    COMMENT("Dump the profiles with profiling compiled out and check the command fails.");
+
+    Baremetal::TaskProfilerTester tester;
+    tester.runProfilingDisabled();
+}
+#endif
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
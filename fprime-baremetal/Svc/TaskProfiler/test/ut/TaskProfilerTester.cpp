@@ -0,0 +1,183 @@
+// ======================================================================
+// \title  TaskProfilerTester.cpp
+// \brief  cpp file for TaskProfiler test harness implementation class
+// ======================================================================
+
+#include "TaskProfilerTester.hpp"
+#include <Fw/Test/UnitTest.hpp>
+#include <Fw/Types/String.hpp>
+
+#define INSTANCE 0
+#define MAX_HISTORY_SIZE 20
+#define CMD_SEQ 42
+
+namespace Baremetal {
+
+U64 TaskProfilerTester::s_timeUs = 0;
+
+// ----------------------------------------------------------------------
+// Construction and destruction
+// ----------------------------------------------------------------------
+
+TaskProfilerTester ::TaskProfilerTester()
+    : TaskProfilerGTestBase("Tester", MAX_HISTORY_SIZE), component("TaskProfiler") {
+    this->initComponents();
+    this->connectPorts();
+    Os::Baremetal::TaskRunner::getSingleton().setClock(TaskProfilerTester::readClock);
+}
+
+TaskProfilerTester ::~TaskProfilerTester() {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    for (FwIndexType i = 0; i < this->m_started; i++) {
+        runner.removeTask(&this->m_tasks[i]);
+    }
+    runner.setClock(nullptr);
+}
+
+// ----------------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------------
+
+#if TASK_RUNNER_PROFILING
+void TaskProfilerTester::runTelemetry() {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    this->startTask(0, "busy", 30);
+    this->startTask(1, "light", 10);
+    for (U32 i = 0; i < 3; i++) {
+        runner.runAll();
+    }
+
+    // The interval holds 90 us of the busy task and 30 us of the light one
+    this->invoke_to_run(0, 0);
+    ASSERT_TLM_SIZE(5);
+    ASSERT_TLM_BusiestTask(0, "busy");
+    ASSERT_TLM_BusiestTaskShare(0, 75.0f);
+    ASSERT_TLM_TaskTimeUs(0, 120);
+    ASSERT_TLM_MaxSliceUs(0, 30);
+    ASSERT_TLM_Overruns(0, 0);
+    ASSERT_EVENTS_SIZE(0);
+
+    // Each report restarts the interval
+    this->clearHistory();
+    this->invoke_to_run(0, 0);
+    ASSERT_TLM_TaskTimeUs_SIZE(1);
+    ASSERT_TLM_TaskTimeUs(0, 0);
+    ASSERT_TLM_MaxSliceUs(0, 0);
+}
+
+void TaskProfilerTester::runSliceOverrun() {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    this->startTask(0, "busy", 150);
+    runner.runAll();
+    runner.setBudget(&this->m_tasks[0], 100);
+    runner.runAll();
+    runner.runAll();
+
+    // The unit of work run before the budget was set does not count
+    this->invoke_to_run(0, 0);
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_SliceOverrun_SIZE(1);
+    ASSERT_EVENTS_SliceOverrun(0, "busy", 2, 150, 100);
+    ASSERT_TLM_Overruns(0, 2);
+
+    // Overruns are counted since startup, the event covers the interval only
+    this->clearHistory();
+    runner.runAll();
+    this->invoke_to_run(0, 0);
+    ASSERT_EVENTS_SliceOverrun_SIZE(1);
+    ASSERT_EVENTS_SliceOverrun(0, "busy", 1, 150, 100);
+    ASSERT_TLM_Overruns(0, 3);
+
+    this->clearHistory();
+    this->invoke_to_run(0, 0);
+    ASSERT_EVENTS_SIZE(0);
+    ASSERT_TLM_Overruns(0, 3);
+}
+
+void TaskProfilerTester::runDumpProfiles() {
+    Os::Baremetal::TaskRunner& runner = Os::Baremetal::TaskRunner::getSingleton();
+    this->startTask(0, "busy", 5);
+    runner.setBudget(&this->m_tasks[0], 100);
+    runner.runAll();
+    this->m_costsUs[0] = 200;
+    runner.runAll();
+    // Reports restart the interval, not the statistics dumped
+    this->invoke_to_run(0, 0);
+
+    this->clearHistory();
+    this->sendCmd_DUMP_PROFILES(INSTANCE, CMD_SEQ);
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_TaskProfile_SIZE(1);
+    ASSERT_EVENTS_TaskProfile(0, "busy", 2, 205, 200, 1);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, TaskProfilerComponentBase::OPCODE_DUMP_PROFILES, CMD_SEQ, Fw::CmdResponse::OK);
+}
+#else
+void TaskProfilerTester::runProfilingDisabled() {
+    this->sendCmd_DUMP_PROFILES(INSTANCE, CMD_SEQ);
+    ASSERT_EVENTS_SIZE(1);
+    ASSERT_EVENTS_ProfilingDisabled_SIZE(1);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, TaskProfilerComponentBase::OPCODE_DUMP_PROFILES, CMD_SEQ,
+                        Fw::CmdResponse::EXECUTION_ERROR);
+
+    // Telemetry is compiled out along with the statistics
+    this->clearHistory();
+    this->invoke_to_run(0, 0);
+    ASSERT_TLM_SIZE(0);
+}
+#endif
+
+// ----------------------------------------------------------------------
+// Helper methods
+// ----------------------------------------------------------------------
+
+void TaskProfilerTester::startTask(FwIndexType index, const char* name, U32 costUs) {
+    ASSERT_EQ(index, this->m_started);
+    this->m_costsUs[index] = costUs;
+    Fw::String taskName(name);
+    Os::Task::Arguments arguments(taskName, TaskProfilerTester::spend, &this->m_costsUs[index], 1);
+    ASSERT_EQ(Os::Task::Status::OP_OK, this->m_tasks[index].start(arguments));
+    this->m_started++;
+}
+
+void TaskProfilerTester::spend(void* costUs) {
+    s_timeUs += *static_cast<U32*>(costUs);
+}
+
+U64 TaskProfilerTester::readClock(void*) {
+    return s_timeUs;
+}
+
+void TaskProfilerTester ::connectPorts() {
+    // run
+    this->connect_to_run(0, this->component.get_run_InputPort(0));
+
+    // cmdIn
+    this->connect_to_cmdIn(0, this->component.get_cmdIn_InputPort(0));
+
+    // cmdRegOut
+    this->component.set_cmdRegOut_OutputPort(0, this->get_from_cmdRegOut(0));
+
+    // cmdResponseOut
+    this->component.set_cmdResponseOut_OutputPort(0, this->get_from_cmdResponseOut(0));
+
+    // logOut
+    this->component.set_logOut_OutputPort(0, this->get_from_logOut(0));
+
+    // logTextOut
+    this->component.set_logTextOut_OutputPort(0, this->get_from_logTextOut(0));
+
+    // timeCaller
+    this->component.set_timeCaller_OutputPort(0, this->get_from_timeCaller(0));
+
+    // tlmOut
+    this->component.set_tlmOut_OutputPort(0, this->get_from_tlmOut(0));
+}
+
+void TaskProfilerTester ::initComponents() {
+    this->init();
+    this->component.init(INSTANCE);
+}
+
+}  // end namespace Baremetal
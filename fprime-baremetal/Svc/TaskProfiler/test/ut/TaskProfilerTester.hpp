@@ -0,0 +1,82 @@
+// ======================================================================
+// \title  TaskProfiler/test/ut/TaskProfilerTester.hpp
+// \brief  hpp file for TaskProfiler test harness implementation class
+// ======================================================================
+
+#ifndef TASKPROFILER_TESTER_HPP
+#define TASKPROFILER_TESTER_HPP
+
+#include <Os/Task.hpp>
+#include "TaskProfilerGTestBase.hpp"
+#include "fprime-baremetal/Svc/TaskProfiler/TaskProfiler.hpp"
+
+namespace Baremetal {
+
+class TaskProfilerTester : public TaskProfilerGTestBase {
+    // ----------------------------------------------------------------------
+    // Construction and destruction
+    // ----------------------------------------------------------------------
+
+  public:
+    //! Construct object Tester, with the task runner reading the virtual clock of the tester
+    //!
+    TaskProfilerTester();
+
+    //! Destroy object Tester, removing its tasks from the task runner
+    //!
+    ~TaskProfilerTester();
+
+  public:
+    // ----------------------------------------------------------------------
+    // Tests
+    // ----------------------------------------------------------------------
+
+#if TASK_RUNNER_PROFILING
+    void runTelemetry();
+    void runSliceOverrun();
+    void runDumpProfiles();
+#else
+    void runProfilingDisabled();
+#endif
+
+  private:
+    // ----------------------------------------------------------------------
+    // Helper methods
+    // ----------------------------------------------------------------------
+
+    //! Connect ports
+    //!
+    void connectPorts();
+
+    //! Initialize components
+    //!
+    void initComponents();
+
+    //! Start a task costing a given time per unit of work
+    void startTask(FwIndexType index, const char* name, U32 costUs);
+
+    //! Routine of the tasks, advancing the virtual clock by the cost of the task
+    static void spend(void* costUs);
+
+    //! Virtual clock of the task runner
+    static U64 readClock(void* context);
+
+  private:
+    // ----------------------------------------------------------------------
+    // Variables
+    // ----------------------------------------------------------------------
+
+    //! The component under test
+    //!
+    TaskProfiler component;
+
+    Os::Task m_tasks[2];        //!< profiled tasks
+    U32 m_costsUs[2] = {0, 0};  //!< time taken by each unit of work of each task
+    FwIndexType m_started = 0;  //!< tasks started
+
+    static U64 s_timeUs;  //!< virtual time read by the task runner
+};
+
+}  // end namespace Baremetal
+
+#endif
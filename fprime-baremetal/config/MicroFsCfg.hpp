@@ -26,6 +26,10 @@ static const FwIndexType MAX_MICROFS_FD = 200;   //!< Maximum number of file des
 #define MICROFS_INDEX_SCN_FORMAT \
     "hd"  //!< SCN format. Must be updated when FwIndexType is updated. Failure to do so could cause a
           //!< stack-buffer-overflow.
+static const FwSizeType MICROFS_MAX_NAME_LENGTH = 32;  //!< Maximum length of a name table path, including the null
+static const FwSizeType MICROFS_FTL_RESERVED_BLOCKS =
+    2;  //!< flash blocks held back from the capacity of a MicroFsFtl so garbage collection can always run. At least 2
+static const U32 MICROFS_FTL_WEAR_THRESHOLD = 16;  //!< erase count spread that makes a MicroFsFtl move cold data
 static const bool MICROFS_SKIP_NULL_CHECK =
     false;  //!< if true, skip memory null check on init. Guards against case where a reset does not clear memory.
 }  // namespace Os
@@ -0,0 +1,15 @@
+/**
+ * \file
+ * \brief Baremetal Mutex Configuration file
+ */
+
+#ifndef _MUTEXCFG_HPP_
+#define _MUTEXCFG_HPP_
+
+#ifndef BAREMETAL_MUTEX_MASKS_INTERRUPTS
+#define BAREMETAL_MUTEX_MASKS_INTERRUPTS \
+    0  //!< mask interrupts while a mutex is held, for state shared with interrupt handlers. Set to 0 for mutexes
+       //!< that do nothing, enough when only cooperative tasks share state
+#endif
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief TaskRunner Configuration file
+ */
+
+#ifndef _TASKRUNNERCFG_HPP_
+#define _TASKRUNNERCFG_HPP_
+
+#include <Fw/Types/BasicTypes.hpp>
+
+// Time every unit of work of every task. Costs two clock reads and the statistics update per unit of work, so it is
+// off by default and on in unit test builds, which cover it. Set to 1 to profile a deployment
+#ifndef TASK_RUNNER_PROFILING
+#ifdef BUILD_UT
+#define TASK_RUNNER_PROFILING 1
+#else
+#define TASK_RUNNER_PROFILING 0
+#endif
+#endif
+// Record scheduling events in a ring buffer. Costs a clock read and an event per slice and the RAM of the buffer, so
+// it is off by default and on in unit test builds, which cover it. Set to 1 to trace a deployment
+#ifndef TASK_RUNNER_TRACING
+#ifdef BUILD_UT
+#define TASK_RUNNER_TRACING 1
+#else
+#define TASK_RUNNER_TRACING 0
+#endif
+#endif
+
+namespace Os {
+
+static const FwSizeType TASK_RUNNER_CAPACITY = 100;  //!< maximum number of tasks registered with a TaskRunner
+static const FwSizeType TASK_RUNNER_PRIORITY_LEVELS =
+    256;  //!< number of ready lists. Task priorities are spread evenly over them, one each with 256. At most 1024
+static const U32 TASK_RUNNER_TICK_US = 1000;           //!< resolution of task delays, in microseconds
+static const FwSizeType TASK_RUNNER_TIMER_LEVELS = 4;  //!< levels of the task delay timer wheel
+static const FwSizeType TASK_RUNNER_TIMER_SLOT_BITS =
+    5;  //!< log2 of the slots per timer wheel level, at most 5. Longer delays than 2^(levels * bits) ticks are requeued
+static const FwSizeType TASK_RUNNER_PROFILE_BUCKETS =
+    16;  //!< buckets of the log2 histogram of unit of work durations. The last one also counts longer units of work
+static const FwSizeType TASK_RUNNER_TRACE_ENTRIES =
+    256;  //!< scheduling events kept by the trace ring buffer, 8 bytes each. Must be a power of two
+static const FwSizeType MULTI_TASK_RUNNER_MAX_WORKERS = 8;  //!< maximum number of worker threads of a MultiTaskRunner
+static const FwSizeType COROUTINE_TASK_FRAMES = 8;  //!< coroutine frames in the pool shared by all coroutine tasks
+static const FwSizeType COROUTINE_TASK_FRAME_SIZE =
+    256;  //!< bytes of each pooled coroutine frame. Must hold the largest frame of any coroutine task routine
+static const FwSizeType TASK_SIMULATOR_TICKS = 8;   //!< periodic ticks, such as rate group interrupts, of a simulation
+static const FwSizeType TASK_SIMULATOR_COSTS = 16;  //!< tasks given their own cost model in a simulation
+}  // namespace Os
+#endif
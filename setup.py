@@ -73,6 +73,8 @@ This package allows you to view the static data sizes of a binary file.
     entry_points={
         "console_scripts": [
             "baremetal-size = baremetal.size.__main__:main",
+            "baremetal-romfs = baremetal.romfs.__main__:main",
+            "baremetal-trace = baremetal.trace.__main__:main",
         ],
         "gui_scripts": [],
     },
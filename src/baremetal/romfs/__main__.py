@@ -0,0 +1,127 @@
+import sys
+import os
+import argparse
+import re
+
+BYTES_PER_LINE = 16
+
+
+def get_files(directory):
+    """ Regular files in the directory, in the order they are numbered in the bin """
+    names = sorted(name for name in os.listdir(directory) if os.path.isfile(os.path.join(directory, name)))
+    return [(name, os.path.join(directory, name)) for name in names]
+
+
+def format_bytes(data):
+    lines = []
+    for offset in range(0, len(data), BYTES_PER_LINE):
+        chunk = data[offset:offset + BYTES_PER_LINE]
+        lines.append('    ' + ', '.join(f'0x{byte:02X}' for byte in chunk) + ',')
+    return '\n'.join(lines)
+
+
+def generate_header(name, namespace, directory, files, sizes):
+    guard = re.sub(r'[^A-Za-z0-9]', '_', name).upper() + '_HPP'
+    listing = '\n'.join(f'//   file{index}: {file_name} ({size} bytes)' for index, ((file_name, _), size) in enumerate(zip(files, sizes)))
+    open_ns = ''.join(f'namespace {part} {{\n' for part in namespace)
+    close_ns = ''.join(f'}}  // namespace {part}\n' for part in reversed(namespace))
+    return f'''// ======================================================================
+// \\title {name}.hpp
+// \\brief read-only MicroFs files generated by baremetal-romfs. Do not edit.
+// ======================================================================
+
+#ifndef {guard}
+#define {guard}
+
+#include <fprime-baremetal/Os/Baremetal/MicroFs/MicroFs.hpp>
+
+// Files from {directory}:
+{listing}
+//
+// Add them as a read-only bin with:
+//   Os::Baremetal::MicroFs::MicroFsAddRomBin(cfg, bin, {'::'.join(namespace + [name])}, {'::'.join(namespace + [name + 'Count'])});
+
+{open_ns}
+constexpr FwSizeType {name}Count = {len(files)};  //!< number of files in {name}
+extern const Os::Baremetal::MicroFs::MicroFsRomFile {name}[{name}Count];  //!< file table for MicroFsAddRomBin
+
+{close_ns}
+#endif
+'''
+
+
+def generate_source(name, namespace, header, files, contents):
+    open_ns = ''.join(f'namespace {part} {{\n' for part in namespace)
+    close_ns = ''.join(f'}}  // namespace {part}\n' for part in reversed(namespace))
+    arrays = []
+    entries = []
+    for index, ((file_name, _), data) in enumerate(zip(files, contents)):
+        if len(data) == 0:
+            entries.append(f'    {{nullptr, 0}},  // file{index}: {file_name}')
+            continue
+        arrays.append(f'// file{index}: {file_name}\nconst U8 {name}File{index}[{len(data)}] = {{\n{format_bytes(data)}\n}};\n')
+        entries.append(f'    {{{name}File{index}, sizeof({name}File{index})}},  // file{index}: {file_name}')
+    arrays_text = '\n'.join(arrays)
+    entries_text = '\n'.join(entries)
+    return f'''// ======================================================================
+// \\title {name}.cpp
+// \\brief read-only MicroFs files generated by baremetal-romfs. Do not edit.
+// ======================================================================
+
+#include "{header}"
+
+{open_ns}
+namespace {{
+
+{arrays_text}
+}}  // namespace
+
+const Os::Baremetal::MicroFs::MicroFsRomFile {name}[{name}Count] = {{
+{entries_text}
+}};
+
+{close_ns}'''
+
+
+def main():
+    parser = argparse.ArgumentParser(description="F Prime baremetal-romfs tool to turn a directory of files into a read-only MicroFs bin.")
+
+    parser.add_argument('directory', type=str, help='Directory holding the files. Files are numbered in sorted name order')
+    parser.add_argument('-n', '--name', type=str, default='RomFiles', help='C++ name of the generated file table')
+    parser.add_argument('--namespace', type=str, default='', help='C++ namespace for the file table (i.e. MyDeployment)')
+    parser.add_argument('-o', '--output', type=str, default='.', help='Directory to write <name>.hpp and <name>.cpp to')
+
+    args = parser.parse_args()
+
+    if not os.path.isdir(args.directory):
+        print(f'Directory not found: {args.directory}')
+        return 1
+    if not re.fullmatch(r'[A-Za-z_][A-Za-z0-9_]*', args.name):
+        print(f'Not a valid C++ name: {args.name}')
+        return 1
+
+    files = get_files(args.directory)
+    if len(files) == 0:
+        print(f'No files found in {args.directory}')
+        return 1
+
+    contents = []
+    for _, path in files:
+        with open(path, 'rb') as file:
+            contents.append(file.read())
+
+    namespace = [part for part in args.namespace.split('::') if part]
+    header = f'{args.name}.hpp'
+    os.makedirs(args.output, exist_ok=True)
+    with open(os.path.join(args.output, header), 'w') as file:
+        file.write(generate_header(args.name, namespace, args.directory, files, [len(data) for data in contents]))
+    with open(os.path.join(args.output, f'{args.name}.cpp'), 'w') as file:
+        file.write(generate_source(args.name, namespace, header, files, contents))
+
+    for index, ((file_name, _), data) in enumerate(zip(files, contents)):
+        print(f'file{index}: {file_name} ({len(data)} bytes)')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,122 @@
+import sys
+import os
+import argparse
+import json
+import struct
+
+MAGIC = b'FTRC'
+VERSION = 1
+
+# TraceEvent values of fprime-baremetal/Os/TaskRunner/TraceBuffer.hpp
+TRACE_DISPATCH = 1
+TRACE_SLICE_END = 2
+TRACE_TASK_EXIT = 3
+TRACE_IDLE_BEGIN = 4
+TRACE_IDLE_END = 5
+TRACE_MARKER = 6
+
+IDLE_TID = 0
+
+
+def parse_dump(data):
+    """ Task names, events as (time, id, event, data) and the count of overwritten events of a TaskRunner dump """
+    if len(data) < 16 or data[0:4] != MAGIC:
+        raise ValueError('Not a TaskRunner trace dump')
+    version, _, name_count, event_count, overwritten = struct.unpack_from('<BBHII', data, 4)
+    if version != VERSION:
+        raise ValueError(f'Unsupported trace version {version}')
+    offset = 16
+    names = {}
+    for _ in range(name_count):
+        trace_id, length = struct.unpack_from('<HB', data, offset)
+        offset += 3
+        names[trace_id] = data[offset:offset + length].decode('utf-8', errors='replace')
+        offset += length
+    if len(data) < offset + 8 * event_count:
+        raise ValueError('Trace dump is truncated')
+    events = [struct.unpack_from('<IHBB', data, offset + 8 * index) for index in range(event_count)]
+    return names, events, overwritten
+
+
+def unwrap_times(events):
+    """ Extend the 32 bit microsecond timestamps, which wrap about every 71 minutes, to a running time """
+    times = []
+    base = 0
+    previous = None
+    for time, _, _, _ in events:
+        if previous is not None and time < previous:
+            base += 1 << 32
+        previous = time
+        times.append(base + time)
+    return times
+
+
+def to_chrome(names, events):
+    """ Chrome trace events: one row per task, slices and idle periods as spans, exits and markers as instants """
+    trace = [{'name': 'process_name', 'ph': 'M', 'pid': 0, 'args': {'name': 'TaskRunner'}},
+             {'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': IDLE_TID, 'args': {'name': 'idle'}}]
+    seen = set()
+
+    def task_name(trace_id):
+        return names.get(trace_id, f'task {trace_id}')
+
+    open_slices = {}
+    idle_since = None
+    for time, (_, trace_id, event, value) in zip(unwrap_times(events), events):
+        if event in (TRACE_DISPATCH, TRACE_SLICE_END, TRACE_TASK_EXIT) and trace_id not in seen:
+            seen.add(trace_id)
+            trace.append({'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': trace_id,
+                          'args': {'name': task_name(trace_id)}})
+        if event == TRACE_DISPATCH:
+            open_slices[trace_id] = time
+        elif event == TRACE_SLICE_END:
+            # A slice that started before the oldest event kept has no start, it is left out
+            start = open_slices.pop(trace_id, None)
+            if start is not None:
+                trace.append({'name': task_name(trace_id), 'ph': 'X', 'pid': 0, 'tid': trace_id, 'ts': start,
+                              'dur': time - start, 'args': {'units': value}})
+        elif event == TRACE_TASK_EXIT:
+            trace.append({'name': 'exit', 'ph': 'i', 's': 't', 'pid': 0, 'tid': trace_id, 'ts': time})
+        elif event == TRACE_IDLE_BEGIN:
+            idle_since = time
+        elif event == TRACE_IDLE_END and idle_since is not None:
+            trace.append({'name': 'idle', 'ph': 'X', 'pid': 0, 'tid': IDLE_TID, 'ts': idle_since,
+                          'dur': time - idle_since})
+            idle_since = None
+        elif event == TRACE_MARKER:
+            trace.append({'name': f'marker {trace_id}', 'ph': 'i', 's': 'p', 'pid': 0, 'ts': time,
+                          'args': {'value': value}})
+    return {'traceEvents': trace, 'displayTimeUnit': 'ms'}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="F Prime baremetal-trace tool to turn a TaskRunner trace dump into Chrome trace JSON.")
+
+    parser.add_argument('dump', type=str, help='Trace dump written by TaskRunner::dumpTrace or dumpTraceToFile')
+    parser.add_argument('-o', '--output', type=str, default=None, help='JSON file to write, <dump>.json by default')
+
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.dump):
+        print(f'File not found: {args.dump}')
+        return 1
+    with open(args.dump, 'rb') as file:
+        data = file.read()
+    try:
+        names, events, overwritten = parse_dump(data)
+    except ValueError as error:
+        print(f'{args.dump}: {error}')
+        return 1
+
+    output = args.output if args.output is not None else f'{args.dump}.json'
+    with open(output, 'w') as file:
+        json.dump(to_chrome(names, events), file, indent=1)
+
+    print(f'{len(events)} events of {len(names)} tasks written to {output}, open it in chrome://tracing or Perfetto')
+    if overwritten > 0:
+        print(f'{overwritten} older events were overwritten, increase TASK_RUNNER_TRACE_ENTRIES to keep more')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())